@@ -81,6 +81,594 @@ int autoreg_propensity_eval (const gsl_vector * X, const gsl_vector * params, gs
 }
 
 
+/**
+ Incremental propensity update function for Autoreg.
+ */
+int autoreg_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != 5) || (params->size != 9) || (prop->size != 9))
+	{
+		printf("\n\n>> error in autoreg_propensity_update: vector sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid>=9)
+	{
+		printf("\n\n>> error in autoreg_propensity_update: reaction id is not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X5 = gsl_vector_get (X, 4);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k9 = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 0, k1*X1*X5);
+			gsl_vector_set (prop, 1, k2*X2);
+			gsl_vector_set (prop, 2, k3*X1);
+			gsl_vector_set (prop, 3, k4*X2);
+			gsl_vector_set (prop, 8, k9*X5);
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X5 = gsl_vector_get (X, 4);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k9 = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 0, k1*X1*X5);
+			gsl_vector_set (prop, 1, k2*X2);
+			gsl_vector_set (prop, 2, k3*X1);
+			gsl_vector_set (prop, 3, k4*X2);
+			gsl_vector_set (prop, 8, k9*X5);
+			break;
+		}
+
+		case 2:
+		{
+			double X3 = gsl_vector_get (X, 2);
+			double k5 = gsl_vector_get (params, 4);
+			double k6 = gsl_vector_get (params, 5);
+			gsl_vector_set (prop, 4, k5*X3);
+			gsl_vector_set (prop, 5, k6*X3);
+			break;
+		}
+
+		case 3:
+		{
+			double X3 = gsl_vector_get (X, 2);
+			double k5 = gsl_vector_get (params, 4);
+			double k6 = gsl_vector_get (params, 5);
+			gsl_vector_set (prop, 4, k5*X3);
+			gsl_vector_set (prop, 5, k6*X3);
+			break;
+		}
+
+		case 4:
+		{
+			double X3 = gsl_vector_get (X, 2);
+			double k5 = gsl_vector_get (params, 4);
+			double k6 = gsl_vector_get (params, 5);
+			gsl_vector_set (prop, 4, k5*X3);
+			gsl_vector_set (prop, 5, k6*X3);
+			break;
+		}
+
+		case 5:
+		{
+			double X4 = gsl_vector_get (X, 3);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			gsl_vector_set (prop, 6, k7*X4);
+			gsl_vector_set (prop, 7, k8*X4/(1+X4));
+			break;
+		}
+
+		case 6:
+		{
+			double X4 = gsl_vector_get (X, 3);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			gsl_vector_set (prop, 6, k7*X4);
+			gsl_vector_set (prop, 7, k8*X4/(1+X4));
+			break;
+		}
+
+		case 7:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X4 = gsl_vector_get (X, 3);
+			double X5 = gsl_vector_get (X, 4);
+			double k1 = gsl_vector_get (params, 0);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			double k9 = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 0, k1*X1*X5);
+			gsl_vector_set (prop, 6, k7*X4);
+			gsl_vector_set (prop, 7, k8*X4/(1+X4));
+			gsl_vector_set (prop, 8, k9*X5);
+			break;
+		}
+
+		case 8:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X4 = gsl_vector_get (X, 3);
+			double X5 = gsl_vector_get (X, 4);
+			double k1 = gsl_vector_get (params, 0);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			double k9 = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 0, k1*X1*X5);
+			gsl_vector_set (prop, 6, k7*X4);
+			gsl_vector_set (prop, 7, k8*X4/(1+X4));
+			gsl_vector_set (prop, 8, k9*X5);
+			break;
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for Autoreg: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int autoreg_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 5) || (params->size != 9) || (J->size1 != 9) || (J->size2 != 5))
+	{
+		printf("\n\n>> error in autoreg_propensity_jacobian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X1 = gsl_vector_get (X, 0);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 0, 0, k1*X5);
+	gsl_matrix_set (J, 0, 4, k1*X1);
+	gsl_matrix_set (J, 1, 1, k2);
+	gsl_matrix_set (J, 2, 0, k3);
+	gsl_matrix_set (J, 3, 1, k4);
+	gsl_matrix_set (J, 4, 2, k5);
+	gsl_matrix_set (J, 5, 2, k6);
+	gsl_matrix_set (J, 6, 3, k7);
+	gsl_matrix_set (J, 7, 3, k8/(1+X4)-k8*X4/(1+X4)/(1+X4));
+	gsl_matrix_set (J, 8, 4, k9);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Autoreg: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int autoreg_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 5) || (params->size != 9) || (H->size1 != 9) || (H->size2 != 25))
+	{
+		printf("\n\n>> error in autoreg_propensity_hessian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X4 = gsl_vector_get (X, 3);
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k8 = gsl_vector_get (params, 7);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 0, 4, k1);
+	gsl_matrix_set (H, 0, 20, k1);
+	gsl_matrix_set (H, 7, 18, -2*k8/(1+X4)/(1+X4)+2*k8*X4/(1+X4)/(1+X4)/(1+X4));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Autoreg, on contiguous arrays.
+ */
+void autoreg_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+
+	// Compute the propensities
+	prop[0] = k1*X1*X5;
+	prop[1] = k2*X2;
+	prop[2] = k3*X1;
+	prop[3] = k4*X2;
+	prop[4] = k5*X3;
+	prop[5] = k6*X3;
+	prop[6] = k7*X4;
+	prop[7] = k8*X4/(1+X4);
+	prop[8] = k9*X5;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Autoreg, on contiguous arrays.
+ */
+void autoreg_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[1] = k2*X2;
+			prop[2] = k3*X1;
+			prop[3] = k4*X2;
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[1] = k2*X2;
+			prop[2] = k3*X1;
+			prop[3] = k4*X2;
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 2:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 3:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 4:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 5:
+		{
+			double X4 = X[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			break;
+		}
+
+		case 6:
+		{
+			double X4 = X[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			break;
+		}
+
+		case 7:
+		{
+			double X1 = X[0];
+			double X4 = X[3];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 8:
+		{
+			double X1 = X[0];
+			double X4 = X[3];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			prop[8] = k9*X5;
+			break;
+		}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Autoreg, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void autoreg_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+		double X5 = X[4*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = k1*X1*X5;
+		prop[SM_LOCK_LANES+l] = k2*X2;
+		prop[2*SM_LOCK_LANES+l] = k3*X1;
+		prop[3*SM_LOCK_LANES+l] = k4*X2;
+		prop[4*SM_LOCK_LANES+l] = k5*X3;
+		prop[5*SM_LOCK_LANES+l] = k6*X3;
+		prop[6*SM_LOCK_LANES+l] = k7*X4;
+		prop[7*SM_LOCK_LANES+l] = k8*X4/(1+X4);
+		prop[8*SM_LOCK_LANES+l] = k9*X5;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Autoreg, on an integer state array.
+ */
+void autoreg_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+
+	// Compute the propensities
+	prop[0] = k1*X1*X5;
+	prop[1] = k2*X2;
+	prop[2] = k3*X1;
+	prop[3] = k4*X2;
+	prop[4] = k5*X3;
+	prop[5] = k6*X3;
+	prop[6] = k7*X4;
+	prop[7] = k8*X4/(1+X4);
+	prop[8] = k9*X5;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Autoreg, on an integer state array.
+ */
+void autoreg_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[1] = k2*X2;
+			prop[2] = k3*X1;
+			prop[3] = k4*X2;
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[1] = k2*X2;
+			prop[2] = k3*X1;
+			prop[3] = k4*X2;
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 2:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 3:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 4:
+		{
+			double X3 = X[2];
+			double k5 = params[4];
+			double k6 = params[5];
+			prop[4] = k5*X3;
+			prop[5] = k6*X3;
+			break;
+		}
+
+		case 5:
+		{
+			double X4 = X[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			break;
+		}
+
+		case 6:
+		{
+			double X4 = X[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			break;
+		}
+
+		case 7:
+		{
+			double X1 = X[0];
+			double X4 = X[3];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			prop[8] = k9*X5;
+			break;
+		}
+
+		case 8:
+		{
+			double X1 = X[0];
+			double X4 = X[3];
+			double X5 = X[4];
+			double k1 = params[0];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k9 = params[8];
+			prop[0] = k1*X1*X5;
+			prop[6] = k7*X4;
+			prop[7] = k8*X4/(1+X4);
+			prop[8] = k9*X5;
+			break;
+		}
+	}
+}
+
+
 /**
  State update function for Syncirc.
  */
@@ -151,6 +739,110 @@ int autoreg_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for Autoreg, on a contiguous array.
+ */
+void autoreg_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] -= 1;
+			X[1] += 1;
+			X[4] -= 1;
+			break;
+
+		case 1:
+			X[0] += 1;
+			X[1] -= 1;
+			X[4] += 1;
+			break;
+
+		case 2:
+			X[2] += 1;
+			break;
+
+		case 3:
+			X[2] += 1;
+			break;
+
+		case 4:
+			X[2] -= 1;
+			break;
+
+		case 5:
+			X[3] += 1;
+			break;
+
+		case 6:
+			X[3] -= 1;
+			break;
+
+		case 7:
+			X[3] -= 1;
+			X[4] += 1;
+			break;
+
+		case 8:
+			X[3] += 1;
+			X[4] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Autoreg, on an integer state array.
+ */
+void autoreg_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] -= 1;
+			X[1] += 1;
+			X[4] -= 1;
+			break;
+
+		case 1:
+			X[0] += 1;
+			X[1] -= 1;
+			X[4] += 1;
+			break;
+
+		case 2:
+			X[2] += 1;
+			break;
+
+		case 3:
+			X[2] += 1;
+			break;
+
+		case 4:
+			X[2] -= 1;
+			break;
+
+		case 5:
+			X[3] += 1;
+			break;
+
+		case 6:
+			X[3] -= 1;
+			break;
+
+		case 7:
+			X[3] -= 1;
+			X[4] += 1;
+			break;
+
+		case 8:
+			X[3] += 1;
+			X[4] -= 1;
+			break;
+	}
+}
+
+
 /**
  Sample a new random initial state for Autoreg.
  */
@@ -175,13 +867,115 @@ int autoreg_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for Autoreg, as an integer vector.
+ */
+int autoreg_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != 5)
+	{
+		printf("\n\n>> error in autoreg_state_update: initial state vector size is not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample new initial state
+	gsl_vector_int_set (X0, 0, gsl_rng_uniform_int (r, 3));
+	gsl_vector_int_set (X0, 1, 2 - gsl_vector_int_get (X0, 0));
+	gsl_vector_int_set (X0, 2, gsl_rng_uniform_int (r, 21));
+	gsl_vector_int_set (X0, 3, gsl_rng_uniform_int (r, 201));
+	gsl_vector_int_set (X0, 4, gsl_rng_uniform_int (r, 21));
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of Autoreg in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t autoreg_stoich_ptr[10] = {
+	0, 3, 6, 7, 8, 9, 10, 11, 13, 15
+};
+static const size_t autoreg_stoich_idx[15] = {
+	0, 1, 4,
+	0, 1, 4,
+	2,
+	2,
+	2,
+	3,
+	3,
+	3, 4,
+	3, 4
+};
+static const int autoreg_stoich_val[15] = {
+	-1, 1, -1,
+	1, -1, 1,
+	1,
+	1,
+	-1,
+	1,
+	-1,
+	-1, 1,
+	1, -1
+};
+
+
+/**
+ Reactants of Autoreg in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t autoreg_react_ptr[10] = {
+	0, 2, 3, 4, 5, 6, 7, 8, 9, 10
+};
+static const size_t autoreg_react_idx[10] = {
+	0, 4,
+	1,
+	0,
+	1,
+	2,
+	2,
+	3,
+	3,
+	4
+};
+static const int autoreg_react_val[10] = {
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Autoreg.
  */
 void autoreg_mod_setup (stochmod * model)
 {
 	model->propensity = &autoreg_propensity_eval;
+	model->propensity_update = &autoreg_propensity_update;
+	model->jacobian = &autoreg_propensity_jacobian;
+	model->hessian = &autoreg_propensity_hessian;
+	model->rate_raw = &autoreg_propensity_raw;
+	model->rate_jacobian = &autoreg_propensity_jacobian;
 	model->update = &autoreg_state_update;
+	model->propensity_raw = &autoreg_propensity_raw;
+	model->propensity_update_raw = &autoreg_propensity_update_raw;
+	model->update_raw = &autoreg_state_update_raw;
+	model->propensity_lanes = &autoreg_propensity_lanes;
+	model->propensity_int = &autoreg_propensity_int;
+	model->propensity_update_int = &autoreg_propensity_update_int;
+	model->update_int = &autoreg_state_update_int;
+	model->initial_int = &autoreg_initial_conditions_int;
+	model->output = NULL;
+	model->output_int = NULL;
 	model->initial = &autoreg_initial_conditions;
 	model->nspecies = 5;
 	model->nrxns = 9;
@@ -189,4 +983,11 @@ void autoreg_mod_setup (stochmod * model)
 	model->nin = 0;
 	model->nout = 1;
 	model->name = "Stochastic Gene Autoregulation Model (AUTOREG)";
+	model->stoich_ptr = autoreg_stoich_ptr;
+	model->stoich_idx = autoreg_stoich_idx;
+	model->stoich_val = autoreg_stoich_val;
+	model->react_ptr = autoreg_react_ptr;
+	model->react_idx = autoreg_react_idx;
+	model->react_val = autoreg_react_val;
+	model->graph = NULL;
 }
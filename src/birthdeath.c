@@ -73,6 +73,200 @@ int birthdeath_propensity_eval (const gsl_vector * X, const gsl_vector * params,
 }
 
 
+/**
+ Incremental propensity update function for BirthDeath.
+ */
+int birthdeath_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != N) || (params->size != L+Z) || (prop->size != R))
+	{
+		printf("\n\n>> error in birthdeath_propensity_update: vector sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= R)
+	{
+		printf("\n\n>> error in birthdeath_propensity_update: reaction id is not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double k2 = gsl_vector_get (params, 1);
+			gsl_vector_set (prop, 1, k2*X1);
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double k2 = gsl_vector_get (params, 1);
+			gsl_vector_set (prop, 1, k2*X1);
+			break;
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for BirthDeath: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int birthdeath_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		printf("\n\n>> error in birthdeath_propensity_jacobian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k2 = gsl_vector_get (params, 1);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, k2);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for BirthDeath: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int birthdeath_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (H->size1 != R) || (H->size2 != N*N))
+	{
+		printf("\n\n>> error in birthdeath_propensity_hessian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for BirthDeath, on contiguous arrays.
+ */
+void birthdeath_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double k1 = params[0];
+	double k2 = params[1];
+
+	// Compute the propensities
+	prop[0] = k1;
+	prop[1] = k2*X1;
+}
+
+
+/**
+ Unchecked incremental propensity update function for BirthDeath, on contiguous arrays.
+ */
+void birthdeath_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double k2 = params[1];
+			prop[1] = k2*X1;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double k2 = params[1];
+			prop[1] = k2*X1;
+			break;
+		}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for BirthDeath, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void birthdeath_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+
+		// Compute the propensities
+		prop[l] = k1;
+		prop[SM_LOCK_LANES+l] = k2*X1;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for BirthDeath, on an integer state array.
+ */
+void birthdeath_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double k1 = params[0];
+	double k2 = params[1];
+
+	// Compute the propensities
+	prop[0] = k1;
+	prop[1] = k2*X1;
+}
+
+
+/**
+ Unchecked incremental propensity update function for BirthDeath, on an integer state array.
+ */
+void birthdeath_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double k2 = params[1];
+			prop[1] = k2*X1;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double k2 = params[1];
+			prop[1] = k2*X1;
+			break;
+		}
+	}
+}
+
+
 /**
  State update function for Syncirc.
  */
@@ -108,6 +302,42 @@ int birthdeath_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for BirthDeath, on a contiguous array.
+ */
+void birthdeath_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] += 1;
+			break;
+
+		case 1:
+			X[0] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Unchecked state update function for BirthDeath, on an integer state array.
+ */
+void birthdeath_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] += 1;
+			break;
+
+		case 1:
+			X[0] -= 1;
+			break;
+	}
+}
+
+
 /**
  Sample a new random initial state for BirthDeath.
  */
@@ -128,6 +358,26 @@ int birthdeath_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for BirthDeath, as an integer vector.
+ */
+int birthdeath_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != N)
+	{
+		printf("\n\n>> error in birthdeath_state_update: initial state vector size is not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample new initial state
+	gsl_vector_int_set (X0, 0, gsl_rng_uniform_int (r, 11));
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for BirthDeath.
  */
@@ -150,13 +400,82 @@ int birthdeath_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for BirthDeath.
+ */
+int birthdeath_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != N) || (out->size2 != P))
+	{
+		fprintf (stderr, "error in birthdeath_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	gsl_matrix_int_set (out, 0, 0, 1);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of BirthDeath in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t birthdeath_stoich_ptr[R+1] = {
+	0, 1, 2
+};
+static const size_t birthdeath_stoich_idx[2] = {
+	0,
+	0
+};
+static const int birthdeath_stoich_val[2] = {
+	1,
+	-1
+};
+
+
+/**
+ Reactants of BirthDeath in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t birthdeath_react_ptr[R+1] = {
+	0, 0, 1
+};
+static const size_t birthdeath_react_idx[1] = {
+	0
+};
+static const int birthdeath_react_val[1] = {
+	1
+};
+
+
 /**
  Model information function for BirthDeath.
  */
 void birthdeath_mod_setup (stochmod * model)
 {
 	model->propensity = &birthdeath_propensity_eval;
+	model->propensity_update = &birthdeath_propensity_update;
+	model->jacobian = &birthdeath_propensity_jacobian;
+	model->hessian = &birthdeath_propensity_hessian;
+	model->rate_raw = &birthdeath_propensity_raw;
+	model->rate_jacobian = &birthdeath_propensity_jacobian;
 	model->update = &birthdeath_state_update;
+	model->propensity_raw = &birthdeath_propensity_raw;
+	model->propensity_update_raw = &birthdeath_propensity_update_raw;
+	model->update_raw = &birthdeath_state_update_raw;
+	model->propensity_lanes = &birthdeath_propensity_lanes;
+	model->propensity_int = &birthdeath_propensity_int;
+	model->propensity_update_int = &birthdeath_propensity_update_int;
+	model->update_int = &birthdeath_state_update_int;
+	model->initial_int = &birthdeath_initial_conditions_int;
+	model->output_int = &birthdeath_output_int;
 	model->initial = &birthdeath_initial_conditions;
 	model->output = &birthdeath_output;
 	model->nspecies = N;
@@ -165,4 +484,11 @@ void birthdeath_mod_setup (stochmod * model)
 	model->nin = Z;
 	model->nout = P;
 	model->name = "Birth-Death process of a single chemical species (BIRTHDEATH)";
+	model->stoich_ptr = birthdeath_stoich_ptr;
+	model->stoich_idx = birthdeath_stoich_idx;
+	model->stoich_val = birthdeath_stoich_val;
+	model->react_ptr = birthdeath_react_ptr;
+	model->react_idx = birthdeath_react_idx;
+	model->react_val = birthdeath_react_val;
+	model->graph = NULL;
 }
@@ -0,0 +1,242 @@
+/*
+ *  cle.c
+ *  StochMod
+ *
+ *	Chemical Langevin equation integrators
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_math.h>
+
+
+/**
+ Evaluate the propensities in the state x, clamped to non-negative values.
+ */
+static int cle_propensity (const stochmod * model, const gsl_vector * params, sm_cle_workspace * w,
+		gsl_vector * X, gsl_vector * prop)
+{
+	if (w->fast)
+		model->propensity_raw (X->data, w->par, prop->data);
+	else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	double * a = prop->data;
+	for (size_t j = 0; j < w->nrxns; j++)
+		a[j] = GSL_MAX (a[j], 0.0);
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Add S * v to the state x, with the stoichiometry table of the model.
+ */
+static void cle_apply (const stochmod * model, double * x, const double * v)
+{
+	for (size_t j = 0; j < model->nrxns; j++)
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			x[model->stoich_idx[q]] += model->stoich_val[q] * v[j];
+}
+
+
+/**
+ Allocate a workspace for the CLE integrators that fits the given model. The
+ model must export its stoichiometry, which is used to build the drift and
+ diffusion terms.
+ */
+sm_cle_workspace * sm_cle_workspace_alloc (const stochmod * model)
+{
+	if (model->stoich_ptr == NULL)
+	{
+		fprintf (stderr, "error in sm_cle_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_cle_workspace * w = malloc (sizeof (sm_cle_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_cle_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (model->nspecies);
+	w->Xpred = gsl_vector_alloc (model->nspecies);
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->proppred = gsl_vector_alloc (model->nrxns);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->dW = malloc ((model->nrxns + 1) * sizeof (double));
+	w->v = malloc ((model->nrxns + 1) * sizeof (double));
+
+	if ((w->X == NULL) || (w->Xpred == NULL) || (w->prop == NULL) || (w->proppred == NULL)
+			|| (w->par == NULL) || (w->dW == NULL) || (w->v == NULL))
+	{
+		fprintf (stderr, "error in sm_cle_workspace_alloc: failed to allocate workspace members\n");
+		sm_cle_workspace_free (w);
+		return NULL;
+	}
+
+	// Default tuning
+	w->dt = 0.01;
+	w->method = SM_CLE_EULER;
+	w->fast = 0;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_cle_workspace_alloc.
+ */
+void sm_cle_workspace_free (sm_cle_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->Xpred != NULL)
+		gsl_vector_free (w->Xpred);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->proppred != NULL)
+		gsl_vector_free (w->proppred);
+	free (w->par);
+	free (w->dW);
+	free (w->v);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the chemical Langevin equation
+ 	 dX = S a(X) dt + S diag(sqrt(a(X))) dW
+ of the model, with fixed step w->dt (shortened to land on the points of tgrid).
+
+ Arguments and output are the same as in sm_ssa_direct_run. With method
+ SM_CLE_EULER the equation is integrated with the Euler-Maruyama scheme. With
+ SM_CLE_HEUN the drift is integrated with Heun's predictor-corrector scheme,
+ which is second order in the deterministic part and removes most of the
+ bias of Euler-Maruyama in the mean; the diffusion term is always evaluated
+ at the start of the step, as required by the Ito interpretation of the CLE.
+ The Gaussian increments of all the reactions are drawn together at the
+ start of each step, and negative populations are clamped to zero.
+ */
+int sm_cle_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_cle_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_cle_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_cle_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_cle_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (w->dt <= 0.0)
+	{
+		fprintf (stderr, "error in sm_cle_run: step size must be positive\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	double * x = w->X->data;
+	double * xp = w->Xpred->data;
+	double * a = w->prop->data;
+	double * ap = w->proppred->data;
+	double * dW = w->dW;
+	double * v = w->v;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->fast = (model->propensity_raw != NULL);
+	gsl_vector_memcpy (w->X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+
+	while (k < ntimes)
+	{
+		// Record the time points that have been reached
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) <= t))
+		{
+			gsl_matrix_set_row (states, k, w->X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		double horizon = gsl_vector_get (tgrid, k) - t;
+		double h = GSL_MIN (w->dt, horizon);
+		double sqh = sqrt (h);
+
+		// Gaussian increments for all the reactions
+		sm_rngbuf_gaussians (&w->rb, dW, R);
+
+		if (cle_propensity (model, params, w, w->X, w->prop) != GSL_SUCCESS)
+			return GSL_EFAILED;
+
+		if (w->method == SM_CLE_HEUN)
+		{
+			// Predictor: Euler-Maruyama step
+			for (size_t i = 0; i < N; i++)
+				xp[i] = x[i];
+			for (size_t j = 0; j < R; j++)
+				v[j] = a[j] * h + sqrt (a[j]) * sqh * dW[j];
+			cle_apply (model, xp, v);
+			for (size_t i = 0; i < N; i++)
+				xp[i] = GSL_MAX (xp[i], 0.0);
+
+			// Corrector: trapezoidal drift, same diffusion
+			if (cle_propensity (model, params, w, w->Xpred, w->proppred) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			for (size_t j = 0; j < R; j++)
+				v[j] = 0.5 * (a[j] + ap[j]) * h + sqrt (a[j]) * sqh * dW[j];
+		}
+		else
+		{
+			for (size_t j = 0; j < R; j++)
+				v[j] = a[j] * h + sqrt (a[j]) * sqh * dW[j];
+		}
+
+		cle_apply (model, x, v);
+		for (size_t i = 0; i < N; i++)
+			x[i] = GSL_MAX (x[i], 0.0);
+
+		t = (h == horizon) ? gsl_vector_get (tgrid, k) : t + h;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,339 @@
+/*
+ *  crssa.c
+ *  StochMod
+ *
+ *	Composition-rejection simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+// Number of firings after which the group sums are recomputed from scratch,
+// to get rid of the rounding errors of the incremental updates
+#define SM_CR_RESYNC 65536
+
+// Group of the reactions with zero propensity
+#define SM_CR_NONE ((size_t) -1)
+
+
+/**
+ === PROPENSITY GROUPS ===
+ 	 Group g holds the reactions with propensity in [2^(emin+g-1), 2^(emin+g)),
+ 	 except group 0 that also holds everything smaller. The members of group g
+ 	 are stored in members(g*R) ... members(g*R + gsize(g) - 1) and slot(j) is
+ 	 the position of reaction j in its group.
+  */
+
+static size_t cr_group (const sm_cr_workspace * w, double a)
+{
+	int e;
+	frexp (a, &e);
+	if (e <= w->emin)
+		return 0;
+	return (size_t) (e - w->emin);
+}
+
+
+static void cr_insert (sm_cr_workspace * w, size_t j, double a, size_t g)
+{
+	size_t R = w->nrxns;
+	w->members[g*R + w->gsize[g]] = j;
+	w->slot[j] = w->gsize[g];
+	w->group[j] = g;
+	w->gsize[g]++;
+	w->gsum[g] += a;
+}
+
+
+static void cr_remove (sm_cr_workspace * w, size_t j, double a)
+{
+	size_t R = w->nrxns;
+	size_t g = w->group[j];
+	if (g == SM_CR_NONE)
+		return;
+
+	// Fill the hole with the last member of the group
+	size_t last = w->members[g*R + w->gsize[g] - 1];
+	w->members[g*R + w->slot[j]] = last;
+	w->slot[last] = w->slot[j];
+	w->gsize[g]--;
+	w->gsum[g] = (w->gsize[g] > 0) ? w->gsum[g] - a : 0.0;
+	w->group[j] = SM_CR_NONE;
+}
+
+
+static void cr_build (sm_cr_workspace * w, const double * a)
+{
+	// Place the largest propensity in the top group
+	int emax = 0;
+	int first = 1;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		int e;
+		if (a[j] <= 0.0)
+			continue;
+		frexp (a[j], &e);
+		if (first || (e > emax))
+			emax = e;
+		first = 0;
+	}
+	w->emin = emax - SM_CR_NGROUPS + 1;
+
+	for (size_t g = 0; g < SM_CR_NGROUPS; g++)
+	{
+		w->gsize[g] = 0;
+		w->gsum[g] = 0.0;
+		w->gmax[g] = ldexp (1.0, w->emin + (int) g);
+	}
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		w->group[j] = SM_CR_NONE;
+		if (a[j] > 0.0)
+			cr_insert (w, j, a[j], cr_group (w, a[j]));
+	}
+	w->nsteps = 0;
+}
+
+
+static void cr_resync (sm_cr_workspace * w, const double * a)
+{
+	size_t R = w->nrxns;
+	for (size_t g = 0; g < SM_CR_NGROUPS; g++)
+	{
+		w->gsum[g] = 0.0;
+		for (size_t i = 0; i < w->gsize[g]; i++)
+			w->gsum[g] += a[w->members[g*R + i]];
+	}
+	w->nsteps = 0;
+}
+
+
+/**
+ Allocate a workspace for the composition-rejection engine that fits the given
+ model. The dependency graph attached to the model is used when present,
+ otherwise it is built here, once.
+ */
+sm_cr_workspace * sm_cr_workspace_alloc (const stochmod * model)
+{
+	sm_cr_workspace * w = malloc (sizeof (sm_cr_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_cr_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (model->nspecies);
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->oldprop = gsl_vector_alloc (model->nrxns);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->members = malloc ((SM_CR_NGROUPS * model->nrxns + 1) * sizeof (size_t));
+	w->group = malloc ((model->nrxns + 1) * sizeof (size_t));
+	w->slot = malloc ((model->nrxns + 1) * sizeof (size_t));
+	w->owngraph = NULL;
+	w->graph = model->graph;
+	if (w->graph == NULL)
+		w->graph = w->owngraph = sm_depgraph_alloc (model);
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->oldprop == NULL) || (w->par == NULL)
+			|| (w->members == NULL) || (w->group == NULL) || (w->slot == NULL) || (w->graph == NULL))
+	{
+		fprintf (stderr, "error in sm_cr_workspace_alloc: failed to allocate workspace members\n");
+		sm_cr_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_cr_workspace_alloc.
+ */
+void sm_cr_workspace_free (sm_cr_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->oldprop != NULL)
+		gsl_vector_free (w->oldprop);
+	free (w->par);
+	free (w->members);
+	free (w->group);
+	free (w->slot);
+	sm_depgraph_free (w->owngraph);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the model with the composition-rejection method of
+ Slepoy, Thompson and Plimpton.
+
+ Arguments and output are the same as in sm_ssa_direct_run. The reactions are
+ grouped by propensity in power-of-two bins: the group that fires is chosen
+ among the SM_CR_NGROUPS groups, then a member of the group is drawn uniformly
+ and accepted with probability a(j)/2^(emin+g) >= 1/2. The cost of a step does
+ not depend on the number of reactions, only on the number of reactions
+ listed in the dependency graph.
+ */
+int sm_cr_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_cr_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_cr_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_cr_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_cr_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	gsl_vector * X = w->X;
+	gsl_vector * prop = w->prop;
+	double * x = X->data;
+	double * a = prop->data;
+	double * aold = w->oldprop->data;
+	double * par = w->par;
+	const sm_depgraph * dg = w->graph;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+	int fast = (model->propensity_raw != NULL) && (model->propensity_update_raw != NULL)
+			&& (model->update_raw != NULL);
+
+	gsl_vector_memcpy (X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+	if (fast)
+		model->propensity_raw (x, par, a);
+	else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	cr_build (w, a);
+
+	while (k < ntimes)
+	{
+		double a0 = 0.0;
+		for (size_t g = 0; g < SM_CR_NGROUPS; g++)
+			a0 += w->gsum[g];
+
+		// Time of the next reaction (infinite if the process has stopped)
+		double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+
+		// Record the current state at all the time points it covers
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_set_row (states, k, X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		// Composition: select the group
+		double target = a0 * sm_rngbuf_uniform (&w->rb);
+		double cumsum = 0.0;
+		size_t g = SM_CR_NGROUPS;
+		for (size_t h = 0; h < SM_CR_NGROUPS; h++)
+		{
+			if (w->gsize[h] == 0)
+				continue;
+			g = h;
+			cumsum += w->gsum[h];
+			if (target < cumsum)
+				break;
+		}
+
+		// Rejection: select the reaction inside the group
+		size_t mu;
+		for (;;)
+		{
+			size_t i = (size_t) (sm_rngbuf_uniform (&w->rb) * w->gsize[g]);
+			mu = w->members[g*R + i];
+			if (sm_rngbuf_uniform (&w->rb) * w->gmax[g] < a[mu])
+				break;
+		}
+
+		// Keep the propensities that are about to change
+		for (size_t d = dg->ptr[mu]; d < dg->ptr[mu+1]; d++)
+			aold[dg->idx[d]] = a[dg->idx[d]];
+
+		// Fire the reaction, advance the time and refresh the propensities
+		t = tnext;
+		if (fast)
+		{
+			model->update_raw (x, mu);
+			model->propensity_update_raw (x, par, a, mu);
+		}
+		else
+		{
+			if (sm_stoich_update (model, X, mu) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			if (model->propensity_update != NULL)
+			{
+				if (model->propensity_update (X, params, prop, mu) != GSL_SUCCESS)
+					return GSL_EFAILED;
+			}
+			else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+
+		// Move the reactions that depend on the one that fired to their new groups
+		int rebuild = 0;
+		for (size_t d = dg->ptr[mu]; d < dg->ptr[mu+1]; d++)
+		{
+			size_t alpha = dg->idx[d];
+			cr_remove (w, alpha, aold[alpha]);
+			if (a[alpha] <= 0.0)
+				continue;
+			size_t h = cr_group (w, a[alpha]);
+			if (h >= SM_CR_NGROUPS)
+				rebuild = 1;
+			else
+				cr_insert (w, alpha, a[alpha], h);
+		}
+
+		// A propensity went above the top group: shift the groups
+		if (rebuild)
+			cr_build (w, a);
+		else if (++w->nsteps >= SM_CR_RESYNC)
+			cr_resync (w, a);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
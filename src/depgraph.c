@@ -0,0 +1,205 @@
+/*
+ *  depgraph.c
+ *  StochMod
+ *
+ *	Reaction dependency graphs
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Find which species are changed by each reaction and which species each
+ propensity depends on. Both come from the stoichiometry and reactant tables
+ of the model; models that do not export them are probed through their
+ callbacks around a reference state instead. The results are stored as
+ nrxns x nspecies arrays of flags.
+ */
+static int sm_depgraph_probe (const stochmod * model, char * changes, char * reads)
+{
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	int status = GSL_EFAILED;
+
+	gsl_vector * X = gsl_vector_alloc (N);
+	gsl_vector * Y = gsl_vector_alloc (N);
+	gsl_vector * params = gsl_vector_alloc (model->nparams + model->nin);
+	gsl_vector * prop0 = gsl_vector_alloc (R);
+	gsl_vector * prop1 = gsl_vector_alloc (R);
+
+	// Reference state with distinct, large enough populations
+	for (size_t i = 0; i < N; i++)
+		gsl_vector_set (X, i, 100.0 + 7.0*i);
+	gsl_vector_set_all (params, 1.0);
+
+	// State change of each reaction, from the stoichiometry table when available
+	for (size_t j = 0; j < R; j++)
+	{
+		if (model->stoich_ptr != NULL)
+		{
+			for (size_t k = model->stoich_ptr[j]; k < model->stoich_ptr[j+1]; k++)
+				changes[j*N + model->stoich_idx[k]] = (model->stoich_val[k] != 0);
+			continue;
+		}
+		gsl_vector_memcpy (Y, X);
+		if (model->update (Y, j) != GSL_SUCCESS)
+			goto cleanup;
+		for (size_t i = 0; i < N; i++)
+			changes[j*N + i] = (gsl_vector_get (Y, i) != gsl_vector_get (X, i));
+	}
+
+	// Species read by each propensity, from the reactant table when available
+	if (model->react_ptr != NULL)
+	{
+		for (size_t j = 0; j < R; j++)
+			for (size_t k = model->react_ptr[j]; k < model->react_ptr[j+1]; k++)
+				reads[j*N + model->react_idx[k]] = 1;
+		status = GSL_SUCCESS;
+		goto cleanup;
+	}
+	if (model->propensity (X, params, prop0) != GSL_SUCCESS)
+		goto cleanup;
+	for (size_t i = 0; i < N; i++)
+	{
+		gsl_vector_memcpy (Y, X);
+		gsl_vector_set (Y, i, gsl_vector_get (X, i) + 1.0);
+		if (model->propensity (Y, params, prop1) != GSL_SUCCESS)
+			goto cleanup;
+		for (size_t j = 0; j < R; j++)
+			reads[j*N + i] = (gsl_vector_get (prop1, j) != gsl_vector_get (prop0, j));
+	}
+	status = GSL_SUCCESS;
+
+cleanup:
+	gsl_vector_free (X);
+	gsl_vector_free (Y);
+	gsl_vector_free (params);
+	gsl_vector_free (prop0);
+	gsl_vector_free (prop1);
+	return status;
+}
+
+
+/**
+ Build the dependency graph of a model: for each reaction j, the list of the
+ reactions whose propensity has to be recomputed after j fires. Reaction j
+ itself is always part of its own list.
+ */
+sm_depgraph * sm_depgraph_alloc (const stochmod * model)
+{
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+
+	char * changes = calloc (R*N + 1, 1);
+	char * reads = calloc (R*N + 1, 1);
+	sm_depgraph * g = malloc (sizeof (sm_depgraph));
+	if ((changes == NULL) || (reads == NULL) || (g == NULL))
+	{
+		fprintf (stderr, "error in sm_depgraph_alloc: failed to allocate memory\n");
+		free (changes);
+		free (reads);
+		free (g);
+		return NULL;
+	}
+	g->nrxns = R;
+	g->ptr = NULL;
+	g->idx = NULL;
+
+	if (sm_depgraph_probe (model, changes, reads) != GSL_SUCCESS)
+	{
+		fprintf (stderr, "error in sm_depgraph_alloc: model callbacks failed\n");
+		goto error;
+	}
+
+	// Two passes over the reaction pairs: count the dependents, then store them
+	g->ptr = malloc ((R + 1) * sizeof (size_t));
+	if (g->ptr == NULL)
+		goto error;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		size_t nnz = 0;
+		for (size_t j = 0; j < R; j++)
+		{
+			if (pass == 0)
+				g->ptr[j] = nnz;
+			for (size_t m = 0; m < R; m++)
+			{
+				int dep = (m == j);
+				for (size_t i = 0; (i < N) && !dep; i++)
+					dep = changes[j*N + i] && reads[m*N + i];
+				if (!dep)
+					continue;
+				if (pass == 1)
+					g->idx[nnz] = m;
+				nnz++;
+			}
+		}
+		if (pass == 0)
+		{
+			g->ptr[R] = nnz;
+			g->idx = malloc ((nnz + 1) * sizeof (size_t));
+			if (g->idx == NULL)
+				goto error;
+		}
+	}
+
+	free (changes);
+	free (reads);
+	return g;
+
+error:
+	free (changes);
+	free (reads);
+	sm_depgraph_free (g);
+	return NULL;
+}
+
+
+/**
+ Free a dependency graph allocated with sm_depgraph_alloc.
+ */
+void sm_depgraph_free (sm_depgraph * g)
+{
+	if (g == NULL)
+		return;
+
+	free (g->ptr);
+	free (g->idx);
+	free (g);
+}
+
+
+/**
+ Build the dependency graph of a model and attach it to the model struct, so
+ that any engine can use it. Nothing is done if a graph is already attached.
+ */
+int sm_depgraph_attach (stochmod * model)
+{
+	if (model->graph != NULL)
+		return GSL_SUCCESS;
+
+	model->graph = sm_depgraph_alloc (model);
+	if (model->graph == NULL)
+	{
+		fprintf (stderr, "error in sm_depgraph_attach: failed to build dependency graph for %s\n", model->name);
+		return GSL_EFAILED;
+	}
+
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,624 @@
+/*
+ *  ensemble.c
+ *  StochMod
+ *
+ *	Multithreaded runner for ensembles of independent trajectories
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <gsl/gsl_math.h>
+
+
+/**
+ Allocate, free and run the workspace of the simulation engine of a method.
+ */
+static void * ens_engine_alloc (sm_ens_method method, const stochmod * model)
+{
+	switch (method)
+	{
+	case SM_ENS_SSA:
+		return sm_ssa_workspace_alloc (model);
+	case SM_ENS_NRM:
+		return sm_nrm_workspace_alloc (model);
+	case SM_ENS_SDM:
+		return sm_sdm_workspace_alloc (model);
+	case SM_ENS_CR:
+		return sm_cr_workspace_alloc (model);
+	case SM_ENS_TAU:
+		return sm_tau_workspace_alloc (model);
+	case SM_ENS_IMPTAU:
+		return sm_imptau_workspace_alloc (model);
+	case SM_ENS_CLE:
+		return sm_cle_workspace_alloc (model);
+	case SM_ENS_SS:
+		return sm_ss_workspace_alloc (model);
+	case SM_ENS_HYB:
+		return sm_hyb_workspace_alloc (model);
+	case SM_ENS_LOCK:
+		return sm_lock_workspace_alloc (model);
+	default:
+		fprintf (stderr, "error in ens_engine_alloc: method %d is not correct\n", (int) method);
+		return NULL;
+	}
+}
+
+
+static void ens_engine_free (sm_ens_method method, void * w)
+{
+	switch (method)
+	{
+	case SM_ENS_SSA:
+		sm_ssa_workspace_free (w);
+		break;
+	case SM_ENS_NRM:
+		sm_nrm_workspace_free (w);
+		break;
+	case SM_ENS_SDM:
+		sm_sdm_workspace_free (w);
+		break;
+	case SM_ENS_CR:
+		sm_cr_workspace_free (w);
+		break;
+	case SM_ENS_TAU:
+		sm_tau_workspace_free (w);
+		break;
+	case SM_ENS_IMPTAU:
+		sm_imptau_workspace_free (w);
+		break;
+	case SM_ENS_CLE:
+		sm_cle_workspace_free (w);
+		break;
+	case SM_ENS_SS:
+		sm_ss_workspace_free (w);
+		break;
+	case SM_ENS_HYB:
+		sm_hyb_workspace_free (w);
+		break;
+	case SM_ENS_LOCK:
+		sm_lock_workspace_free (w);
+		break;
+	}
+}
+
+
+static int ens_engine_run (sm_ens_method method, const stochmod * model, const gsl_vector * params,
+		const gsl_vector * X0, const gsl_vector * tgrid, gsl_matrix * states, void * w, const gsl_rng * r)
+{
+	switch (method)
+	{
+	case SM_ENS_SSA:
+		return sm_ssa_direct_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_NRM:
+		return sm_nrm_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_SDM:
+		return sm_sdm_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_CR:
+		return sm_cr_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_TAU:
+		return sm_tau_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_IMPTAU:
+		return sm_imptau_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_CLE:
+		return sm_cle_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_SS:
+		return sm_ss_run (model, params, X0, tgrid, states, w, r);
+	case SM_ENS_HYB:
+		return sm_hyb_run (model, params, X0, tgrid, states, w, r);
+	default:
+		return GSL_EFAILED;
+	}
+}
+
+
+/**
+ === WORK STEALING ===
+ 	 The trajectories are grouped in batches of consecutive ids, and each
+ 	 thread starts with a deque holding a contiguous share of the batches. A
+ 	 thread takes its batches from the head of its own deque; when it runs out,
+ 	 it steals the back half of the deque of another thread. Since batches are
+ 	 coarse, each deque is simply a range of batch numbers guarded by a mutex.
+  */
+
+typedef struct
+{
+	size_t head;
+	size_t tail;
+	pthread_mutex_t lock;
+} ens_deque;
+
+
+static int ens_pop (ens_deque * d, size_t * b)
+{
+	pthread_mutex_lock (&d->lock);
+	int found = (d->head < d->tail);
+	if (found)
+		*b = d->head++;
+	pthread_mutex_unlock (&d->lock);
+	return found;
+}
+
+
+static int ens_steal (ens_deque * victim, ens_deque * d)
+{
+	pthread_mutex_lock (&victim->lock);
+	size_t n = victim->tail - victim->head;
+	size_t mid = victim->tail - (n + 1) / 2;
+	victim->tail = mid;
+	pthread_mutex_unlock (&victim->lock);
+	if (n == 0)
+		return 0;
+
+	pthread_mutex_lock (&d->lock);
+	d->head = mid;
+	d->tail = mid + (n + 1) / 2;
+	pthread_mutex_unlock (&d->lock);
+	return 1;
+}
+
+
+// Arguments and output of one worker thread
+typedef struct
+{
+	sm_ens_workspace * w;
+	size_t thread;
+	size_t nthreads;
+	ens_deque * deques;
+	size_t ntraj;
+	size_t batch;
+	const stochmod * model;
+	const gsl_vector * params;
+	const gsl_vector * X0;
+	const gsl_vector * tgrid;
+	unsigned long seed;
+	size_t steals;
+	int status;
+	pthread_t id;
+} ens_worker;
+
+
+/**
+ Add the states S as the c-th trajectory to the moments of a batch, with the
+ update of Welford.
+ */
+static void ens_accumulate (const gsl_matrix * S, size_t c, double * mean, double * m2)
+{
+	for (size_t t = 0; t < S->size1; t++)
+	{
+		const double * row = S->data + t * S->tda;
+		double * mt = mean + t * S->size2;
+		double * qt = m2 + t * S->size2;
+		for (size_t i = 0; i < S->size2; i++)
+		{
+			double d = row[i] - mt[i];
+			mt[i] += d / (double) c;
+			qt[i] += d * (row[i] - mt[i]);
+		}
+	}
+}
+
+
+/**
+ Simulate trajectory id with the workspace and random number generator of a
+ thread, and add it as the c-th trajectory to the moments of its batch.
+ */
+static int ens_trajectory (ens_worker * k, size_t id, size_t c, double * mean, double * m2)
+{
+	sm_ens_workspace * w = k->w;
+	gsl_matrix * S = w->states[k->thread];
+	const gsl_rng * r = w->rngs[k->thread];
+	const gsl_vector * X0 = k->X0;
+
+	sm_rng_key (r, k->seed, id);
+	if (X0 == NULL)
+	{
+		if (k->model->initial (w->x0s[k->thread], r) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		X0 = w->x0s[k->thread];
+	}
+	if (ens_engine_run (w->method, k->model, k->params, X0, k->tgrid, S, w->ws[k->thread], r) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	ens_accumulate (S, c, mean, m2);
+	if (w->observer != NULL)
+		w->observer (id, k->thread, S, w->data);
+
+	return GSL_SUCCESS;
+}
+
+
+// Batch run by the lockstep engine of a thread, and the trajectories it completed
+typedef struct
+{
+	ens_worker * k;
+	double * mean;
+	double * m2;
+	size_t c;
+} ens_lockbatch;
+
+
+/**
+ Add a trajectory completed by the lockstep engine to the moments of its batch.
+ */
+static void ens_lock_done (size_t id, const gsl_matrix * S, void * data)
+{
+	ens_lockbatch * lb = data;
+	sm_ens_workspace * w = lb->k->w;
+
+	ens_accumulate (S, ++lb->c, lb->mean, lb->m2);
+	if (w->observer != NULL)
+		w->observer (id, lb->k->thread, S, w->data);
+}
+
+
+/**
+ Run batches from the deque of a thread, stealing from the other threads
+ when it is empty, until no batch is left anywhere.
+ */
+static void * ens_work (void * arg)
+{
+	ens_worker * k = arg;
+	sm_ens_workspace * w = k->w;
+	size_t n = k->tgrid->size * w->nspecies;
+
+	k->steals = 0;
+	k->status = GSL_SUCCESS;
+
+	ens_deque * own = k->deques + k->thread;
+	for (;;)
+	{
+		size_t b;
+		if (!ens_pop (own, &b))
+		{
+			int found = 0;
+			for (size_t v = 1; !found && (v < k->nthreads); v++)
+				found = ens_steal (k->deques + (k->thread + v) % k->nthreads, own);
+			if (!found)
+				break;
+			k->steals++;
+			continue;
+		}
+
+		double * mean = w->mean + b * n;
+		double * m2 = w->m2 + b * n;
+		for (size_t i = 0; i < n; i++)
+		{
+			mean[i] = 0.0;
+			m2[i] = 0.0;
+		}
+
+		size_t first = b * k->batch;
+		size_t last = GSL_MIN (first + k->batch, k->ntraj);
+		if (w->method == SM_ENS_LOCK)
+		{
+			sm_lock_workspace * lw = w->ws[k->thread];
+			ens_lockbatch lb = {k, mean, m2, 0};
+			lw->done = &ens_lock_done;
+			lw->data = &lb;
+			if (sm_lock_run (k->model, k->params, k->X0, k->tgrid, k->seed, first, last - first, lw) != GSL_SUCCESS)
+			{
+				k->status = GSL_EFAILED;
+				return NULL;
+			}
+			continue;
+		}
+		for (size_t id = first; id < last; id++)
+		{
+			if (ens_trajectory (k, id, id - first + 1, mean, m2) != GSL_SUCCESS)
+			{
+				k->status = GSL_EFAILED;
+				return NULL;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+
+/**
+ Allocate a workspace to simulate ensembles of trajectories of the model
+ with the given method on nthreads threads, or on all the online processors
+ if nthreads is 0. Each thread gets its own engine workspace and random number
+ generator; the engine workspaces are in w->ws and can be tuned (for example
+ the leap condition of tau-leaping) before calling sm_ens_run.
+ */
+sm_ens_workspace * sm_ens_workspace_alloc (const stochmod * model, sm_ens_method method, size_t nthreads)
+{
+	if (nthreads == 0)
+	{
+		long ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+		nthreads = (ncpu > 0) ? (size_t) ncpu : 1;
+	}
+
+	sm_ens_workspace * w = malloc (sizeof (sm_ens_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_ens_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->method = method;
+	w->nthreads = nthreads;
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->ws = calloc (nthreads, sizeof (void *));
+	w->rngs = calloc (nthreads, sizeof (gsl_rng *));
+	w->states = calloc (nthreads, sizeof (gsl_matrix *));
+	w->x0s = calloc (nthreads, sizeof (gsl_vector *));
+	w->mean = NULL;
+	w->m2 = NULL;
+	w->nmom = 0;
+	w->ntimes = 0;
+	w->observer = NULL;
+	w->data = NULL;
+	w->batch = 0;
+	w->steals = 0;
+
+	if ((w->ws == NULL) || (w->rngs == NULL) || (w->states == NULL) || (w->x0s == NULL))
+	{
+		fprintf (stderr, "error in sm_ens_workspace_alloc: failed to allocate workspace members\n");
+		sm_ens_workspace_free (w);
+		return NULL;
+	}
+
+	for (size_t k = 0; k < nthreads; k++)
+	{
+		w->ws[k] = ens_engine_alloc (method, model);
+		w->rngs[k] = gsl_rng_alloc (sm_rng_philox);
+		w->x0s[k] = gsl_vector_alloc (model->nspecies);
+		if ((w->ws[k] == NULL) || (w->rngs[k] == NULL) || (w->x0s[k] == NULL))
+		{
+			fprintf (stderr, "error in sm_ens_workspace_alloc: failed to allocate thread %d\n", (int) k);
+			sm_ens_workspace_free (w);
+			return NULL;
+		}
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_ens_workspace_alloc.
+ */
+void sm_ens_workspace_free (sm_ens_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	for (size_t k = 0; k < w->nthreads; k++)
+	{
+		if ((w->ws != NULL) && (w->ws[k] != NULL))
+			ens_engine_free (w->method, w->ws[k]);
+		if ((w->rngs != NULL) && (w->rngs[k] != NULL))
+			gsl_rng_free (w->rngs[k]);
+		if ((w->states != NULL) && (w->states[k] != NULL))
+			gsl_matrix_free (w->states[k]);
+		if ((w->x0s != NULL) && (w->x0s[k] != NULL))
+			gsl_vector_free (w->x0s[k]);
+	}
+	free (w->ws);
+	free (w->rngs);
+	free (w->states);
+	free (w->x0s);
+	free (w->mean);
+	free (w->m2);
+	free (w);
+}
+
+
+/**
+ Simulate an ensemble of independent trajectories of the model.
+
+ Arguments:
+ 	 model: the model
+ 	 params: vector of parameters and inputs of the model
+ 	 X0: initial state, the same for all trajectories, or NULL to sample it
+ 	 	 for each trajectory with the initial conditions of the model
+ 	 tgrid: time points at which the states are stored
+ 	 ntraj: number of trajectories
+ 	 seed: seed of the ensemble
+ 	 means: on output, the sample means of the states (tgrid->size x nspecies)
+ 	 vars: on output, the sample variances of the states, or NULL
+ 	 w: workspace
+
+ The trajectories are scheduled over the threads of the workspace in
+ batches of w->batch consecutive ids (if 0, the ensemble is cut in at most
+ 1024 batches), with work stealing to keep the threads busy when the cost of
+ the trajectories varies; w->steals counts the steals of the last run.
+ Trajectory id draws its random numbers from the counter-based generator
+ sm_rng_philox keyed by (seed, id), and the moments of each batch are merged
+ in batch order, so for a given w->batch the output is bitwise the same for
+ any number of threads and any schedule, and any trajectory can be reproduced
+ alone. The moments of the batches take 2 x nbatches x tgrid->size x nspecies
+ doubles.
+
+ With SM_ENS_LOCK, each thread runs the trajectories of its batches with the
+ lockstep engine of its workspace (see sm_lock_run), and the default batches
+ hold at least 8 trajectories per lane. The trajectories of a batch are then
+ added to its moments in the order they complete, which does not depend on
+ the threads either.
+
+ If w->observer is not NULL, it is called by the thread that simulated each
+ trajectory with its id, the thread number and its states; it runs
+ concurrently on all threads, and should keep its results per thread to
+ avoid locking.
+ */
+int sm_ens_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, size_t ntraj, unsigned long seed, gsl_matrix * means, gsl_matrix * vars,
+		sm_ens_workspace * w)
+{
+	size_t N = model->nspecies;
+	size_t T = tgrid->size;
+
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ens_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0 == NULL) && (model->initial == NULL))
+	{
+		fprintf (stderr, "error in sm_ens_run: model has no random initial conditions\n");
+		return GSL_EFAILED;
+	}
+	if (((X0 != NULL) && (X0->size != N)) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_ens_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (X0 != NULL) ? (int) X0->size : -1, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((means->size1 != T) || (means->size2 != N)
+			|| ((vars != NULL) && ((vars->size1 != T) || (vars->size2 != N))))
+	{
+		fprintf (stderr, "error in sm_ens_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((T == 0) || (ntraj == 0))
+	{
+		fprintf (stderr, "error in sm_ens_run: time grid and ensemble must not be empty\n");
+		return GSL_EFAILED;
+	}
+
+	// Per-thread trajectory buffers for this time grid
+	if (w->ntimes != T)
+	{
+		w->ntimes = 0;
+		for (size_t k = 0; k < w->nthreads; k++)
+		{
+			if (w->states[k] != NULL)
+				gsl_matrix_free (w->states[k]);
+			if ((w->states[k] = gsl_matrix_alloc (T, N)) == NULL)
+			{
+				fprintf (stderr, "error in sm_ens_run: failed to allocate thread buffers\n");
+				return GSL_EFAILED;
+			}
+		}
+		w->ntimes = T;
+	}
+
+	// Moments of the batches
+	size_t nt = GSL_MIN (w->nthreads, ntraj);
+	size_t batch = (w->batch > 0) ? w->batch : (ntraj + 1023) / 1024;
+	if ((w->batch == 0) && (w->method == SM_ENS_LOCK))
+		batch = GSL_MAX (batch, 8 * SM_LOCK_LANES);
+	size_t nbatch = (ntraj + batch - 1) / batch;
+	if (nbatch * T * N > w->nmom)
+	{
+		free (w->mean);
+		free (w->m2);
+		w->mean = malloc (nbatch * T * N * sizeof (double));
+		w->m2 = malloc (nbatch * T * N * sizeof (double));
+		w->nmom = 0;
+		if ((w->mean == NULL) || (w->m2 == NULL))
+		{
+			fprintf (stderr, "error in sm_ens_run: failed to allocate batch moments\n");
+			return GSL_EFAILED;
+		}
+		w->nmom = nbatch * T * N;
+	}
+	ens_worker * k = malloc (nt * sizeof (ens_worker));
+	ens_deque * d = malloc (nt * sizeof (ens_deque));
+	int * started = calloc (nt, sizeof (int));
+	if ((k == NULL) || (d == NULL) || (started == NULL))
+	{
+		free (k);
+		free (d);
+		free (started);
+		fprintf (stderr, "error in sm_ens_run: failed to allocate threads\n");
+		return GSL_EFAILED;
+	}
+
+	for (size_t t = 0; t < nt; t++)
+	{
+		d[t].head = (nbatch * t) / nt;
+		d[t].tail = (nbatch * (t + 1)) / nt;
+		pthread_mutex_init (&d[t].lock, NULL);
+		k[t].w = w;
+		k[t].thread = t;
+		k[t].nthreads = nt;
+		k[t].deques = d;
+		k[t].ntraj = ntraj;
+		k[t].batch = batch;
+		k[t].model = model;
+		k[t].params = params;
+		k[t].X0 = X0;
+		k[t].tgrid = tgrid;
+		k[t].seed = seed;
+	}
+
+	// Threads that cannot be started are run by the calling thread
+	for (size_t t = 1; t < nt; t++)
+		started[t] = (pthread_create (&k[t].id, NULL, ens_work, &k[t]) == 0);
+	ens_work (&k[0]);
+	for (size_t t = 1; t < nt; t++)
+	{
+		if (started[t])
+			pthread_join (k[t].id, NULL);
+		else
+			ens_work (&k[t]);
+	}
+
+	int status = GSL_SUCCESS;
+	w->steals = 0;
+	for (size_t t = 0; t < nt; t++)
+	{
+		pthread_mutex_destroy (&d[t].lock);
+		w->steals += k[t].steals;
+		if (k[t].status != GSL_SUCCESS)
+			status = GSL_EFAILED;
+	}
+	free (k);
+	free (d);
+	free (started);
+	if (status != GSL_SUCCESS)
+	{
+		fprintf (stderr, "error in sm_ens_run: simulation of a trajectory failed\n");
+		return GSL_EFAILED;
+	}
+
+	// Merge the moments in batch order (Chan, Golub and LeVeque, 1979)
+	for (size_t t = 0; t < T; t++)
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			double m = 0.0;
+			double q = 0.0;
+			double c = 0.0;
+			for (size_t h = 0; h < nbatch; h++)
+			{
+				double ch = (double) (GSL_MIN ((h + 1) * batch, ntraj) - h * batch);
+				double mh = w->mean[(h * T + t) * N + i];
+				double d = mh - m;
+				q += w->m2[(h * T + t) * N + i] + d * d * c * ch / (c + ch);
+				m += d * ch / (c + ch);
+				c += ch;
+			}
+			gsl_matrix_set (means, t, i, m);
+			if (vars != NULL)
+				gsl_matrix_set (vars, t, i, (ntraj > 1) ? q / (ntraj - 1) : 0.0);
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,1431 @@
+/*
+ *  fsp.c
+ *  StochMod
+ *
+ *	Finite state projection solver for the chemical master equation
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <string.h>
+#include <pthread.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+
+// Marker of the empty slots of the hash table and of missing states
+#define SM_FSP_NONE ((size_t) -1)
+
+// Classes of the reactions in the affine decomposition of the generator
+#define SM_FSP_CONST -1
+#define SM_FSP_NONAFFINE -2
+#define SM_FSP_UNSEEN -3
+
+// Largest number of threads used to apply the generator in the box layout
+#define SM_FSP_MAXTHREADS 64
+
+
+/**
+ === PROJECTION ===
+ 	 The projection holds the states reachable from the initial state inside
+ 	 the box 0 <= X(i) <= bound(i). State s is stored in states(s*N) ...
+ 	 states(s*N + N-1) and found through an open addressing hash table. New
+ 	 states are always appended, so that the index of a state never changes
+ 	 when the projection is expanded.
+  */
+
+static size_t fsp_hash (const int * x, size_t N)
+{
+	size_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < N; i++)
+	{
+		h ^= (size_t) (unsigned int) x[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+
+static size_t fsp_lookup (const sm_fsp_workspace * w, const int * x)
+{
+	size_t N = w->nspecies;
+	size_t mask = w->hashsize - 1;
+	for (size_t h = fsp_hash (x, N) & mask; w->hash[h] != SM_FSP_NONE; h = (h + 1) & mask)
+		if (memcmp (w->states + w->hash[h] * N, x, N * sizeof (int)) == 0)
+			return w->hash[h];
+	return SM_FSP_NONE;
+}
+
+
+static void fsp_hash_put (sm_fsp_workspace * w, size_t s)
+{
+	size_t mask = w->hashsize - 1;
+	size_t h = fsp_hash (w->states + s * w->nspecies, w->nspecies) & mask;
+	while (w->hash[h] != SM_FSP_NONE)
+		h = (h + 1) & mask;
+	w->hash[h] = s;
+}
+
+
+/**
+ Make room for at least n states in the arrays that have one entry per state.
+ */
+static int fsp_reserve (sm_fsp_workspace * w, size_t n)
+{
+	if (n <= w->capacity)
+		return GSL_SUCCESS;
+
+	size_t cap = GSL_MAX (2 * w->capacity, n);
+	int * states = realloc (w->states, cap * w->nspecies * sizeof (int));
+	if (states != NULL)
+		w->states = states;
+	double * p = realloc (w->p, cap * sizeof (double));
+	if (p != NULL)
+		w->p = p;
+	double * diag = realloc (w->diag, cap * sizeof (double));
+	if (diag != NULL)
+		w->diag = diag;
+	size_t * gptr = realloc (w->gptr, (cap + 1) * sizeof (size_t));
+	if (gptr != NULL)
+		w->gptr = gptr;
+	double * P = realloc (w->P, cap * GSL_MAX (w->ntimes, 1) * sizeof (double));
+	if (P != NULL)
+		w->P = P;
+	double * obase = realloc (w->obase, cap * w->nrxns * sizeof (double));
+	if (obase != NULL)
+		w->obase = obase;
+	if ((states == NULL) || (p == NULL) || (diag == NULL) || (gptr == NULL) || (P == NULL) || (obase == NULL))
+		return GSL_EFAILED;
+	w->capacity = cap;
+
+	// Keep the load of the hash table below one half
+	if (2 * cap > w->hashsize)
+	{
+		size_t hs = w->hashsize;
+		while (2 * cap > hs)
+			hs *= 2;
+		size_t * hash = realloc (w->hash, hs * sizeof (size_t));
+		if (hash == NULL)
+			return GSL_EFAILED;
+		w->hash = hash;
+		w->hashsize = hs;
+		for (size_t h = 0; h < hs; h++)
+			hash[h] = SM_FSP_NONE;
+		for (size_t s = 0; s < w->nstates; s++)
+			fsp_hash_put (w, s);
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Append the state x to the projection, with zero probability.
+ */
+static size_t fsp_insert (sm_fsp_workspace * w, const int * x)
+{
+	if ((w->nstates >= w->maxstates) || (fsp_reserve (w, w->nstates + 1) != GSL_SUCCESS))
+		return SM_FSP_NONE;
+
+	size_t s = w->nstates++;
+	memcpy (w->states + s * w->nspecies, x, w->nspecies * sizeof (int));
+	fsp_hash_put (w, s);
+	w->p[s] = 0.0;
+	for (size_t k = 0; k < w->ntimes; k++)
+		w->P[s * w->ntimes + k] = 0.0;
+
+	return s;
+}
+
+
+/**
+ Propensities a of all reactions in the integer state x, with the parameters
+ par.
+ */
+static int fsp_propensity (const stochmod * model, sm_fsp_workspace * w, const double * par,
+		const int * x, double * a)
+{
+	if (model->propensity_int != NULL)
+	{
+		model->propensity_int (x, par, a);
+		return GSL_SUCCESS;
+	}
+
+	gsl_vector_const_view P = gsl_vector_const_view_array (par, w->npar);
+	gsl_vector_view A = gsl_vector_view_array (a, w->nrxns);
+	for (size_t i = 0; i < w->nspecies; i++)
+		gsl_vector_set (w->Xd, i, x[i]);
+	return model->propensity (w->Xd, &P.vector, &A.vector);
+}
+
+
+/**
+ Classify the reactions in the state x from the propensities aref at the
+ reference parameters: reaction j is affine in parameter i if doubling i
+ doubles its propensity and no other parameter changes it, and constant if
+ no parameter changes it. A reaction that falls in different classes in
+ different states is not affine.
+ */
+static int fsp_classify (const stochmod * model, sm_fsp_workspace * w, const int * x, const double * aref)
+{
+	size_t R = w->nrxns;
+	double * a = w->prop->data;
+	int * cls = w->xcls;
+
+	for (size_t j = 0; j < R; j++)
+		cls[j] = (aref[j] > 0.0) ? SM_FSP_CONST : SM_FSP_UNSEEN;
+
+	memcpy (w->probe, w->ref, w->npar * sizeof (double));
+	for (size_t i = 0; i < w->npar; i++)
+	{
+		w->probe[i] = 2.0 * w->ref[i];
+		if (fsp_propensity (model, w, w->probe, x, a) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		w->probe[i] = w->ref[i];
+
+		for (size_t j = 0; j < R; j++)
+		{
+			if ((cls[j] == SM_FSP_UNSEEN) || (fabs (a[j] - aref[j]) <= 1e-12 * aref[j]))
+				continue;
+			if ((cls[j] == SM_FSP_CONST) && (fabs (a[j] - 2.0 * aref[j]) <= 1e-12 * aref[j]))
+				cls[j] = (int) i;
+			else
+				cls[j] = SM_FSP_NONAFFINE;
+		}
+	}
+
+	for (size_t j = 0; j < R; j++)
+	{
+		if ((cls[j] == SM_FSP_UNSEEN) || (w->rxpar[j] == cls[j]))
+			continue;
+		w->rxpar[j] = (w->rxpar[j] == SM_FSP_UNSEEN) ? cls[j] : SM_FSP_NONAFFINE;
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Target of reaction j from the state x, into w->xt. Returns 0 when the target
+ lies outside the projection box.
+ */
+static int fsp_target (const stochmod * model, sm_fsp_workspace * w, const int * x, size_t j)
+{
+	memcpy (w->xt, x, w->nspecies * sizeof (int));
+	int inside = 1;
+	for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+	{
+		size_t i = model->stoich_idx[q];
+		w->xt[i] += model->stoich_val[q];
+		if ((w->xt[i] < 0) || (w->xt[i] > w->bound[i]))
+			inside = 0;
+	}
+	return inside;
+}
+
+
+/**
+ === BOX LAYOUT ===
+ 	 With w->box set, the projection is the whole box 0 <= X(i) <= bound(i)
+ 	 and state s is the one with lexicographic index s, species 0 running
+ 	 fastest. Since every reaction shifts the index by the constant offset
+ 	 boff(j), the generator is a stencil that is applied without storing the
+ 	 states, the hash table or the transitions: only the propensities aT(j*n + s)
+ 	 of each reaction in each state are kept. This suits models whose species
+ 	 all have broad distributions; with conserved species (gene copies,
+ 	 promoter states) most of the box is not reachable and the default layout
+ 	 is much smaller.
+  */
+
+static void fsp_box_decode (const int * bound, size_t N, size_t s, int * x)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		size_t b = (size_t) bound[i] + 1;
+		x[i] = (int) (s % b);
+		s /= b;
+	}
+}
+
+
+static size_t fsp_box_index (const sm_fsp_workspace * w, const int * x)
+{
+	size_t s = 0;
+	for (size_t i = 0; i < w->nspecies; i++)
+	{
+		if ((x[i] < 0) || (x[i] > w->bound[i]))
+			return SM_FSP_NONE;
+		s += (size_t) x[i] * w->bstride[i];
+	}
+	return s;
+}
+
+
+/**
+ Coordinates of state s of the projection, decoded into x in the box layout.
+ */
+static const int * fsp_state (const sm_fsp_workspace * w, size_t s, int * x)
+{
+	if (!w->box)
+		return w->states + s * w->nspecies;
+	fsp_box_decode (w->bound, w->nspecies, s, x);
+	return x;
+}
+
+
+/**
+ Set up the box layout for the current bounds and tabulate the propensities
+ with the parameters w->par. If bold is not NULL, the snapshots of the
+ distribution are carried over from the box with bounds bold, which must lie
+ inside the new one.
+ */
+static int fsp_box_build (const stochmod * model, sm_fsp_workspace * w, const int * bold)
+{
+	size_t N = w->nspecies;
+	size_t R = w->nrxns;
+	size_t ntimes = GSL_MAX (w->ntimes, 1);
+
+	size_t n = 1;
+	for (size_t i = 0; i < N; i++)
+	{
+		w->bstride[i] = n;
+		if ((size_t) w->bound[i] + 1 > w->maxstates / n)
+		{
+			fprintf (stderr, "error in fsp_box_build: projection exceeds %d states\n", (int) w->maxstates);
+			return GSL_EFAILED;
+		}
+		n *= (size_t) w->bound[i] + 1;
+	}
+	for (size_t j = 0; j < R; j++)
+	{
+		w->boff[j] = 0;
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			w->boff[j] += model->stoich_val[q] * (long) w->bstride[model->stoich_idx[q]];
+	}
+
+	// The arrays of the default layout are not sized for the box any more
+	w->capacity = 0;
+	double * p = realloc (w->p, n * sizeof (double));
+	if (p != NULL)
+		w->p = p;
+	double * diag = realloc (w->diag, n * sizeof (double));
+	if (diag != NULL)
+		w->diag = diag;
+	double * aT = realloc (w->aT, n * R * sizeof (double));
+	if (aT != NULL)
+		w->aT = aT;
+	double * P = calloc (n * ntimes, sizeof (double));
+	if ((p == NULL) || (diag == NULL) || (aT == NULL) || (P == NULL))
+	{
+		free (P);
+		fprintf (stderr, "error in fsp_box_build: failed to allocate projection\n");
+		return GSL_EFAILED;
+	}
+	if (bold != NULL)
+	{
+		int * x = w->bcoord;
+		for (size_t s = 0; s < w->nstates; s++)
+		{
+			fsp_box_decode (bold, N, s, x);
+			memcpy (P + fsp_box_index (w, x) * ntimes, w->P + s * ntimes, ntimes * sizeof (double));
+		}
+	}
+	free (w->P);
+	w->P = P;
+	w->nstates = n;
+
+	// Propensity table and 1-norm of the generator
+	int * x = w->bcoord;
+	for (size_t i = 0; i < N; i++)
+		x[i] = 0;
+	w->anorm = 0.0;
+	for (size_t s = 0; s < n; s++)
+	{
+		if (fsp_propensity (model, w, w->par, x, w->apar) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		double d = 0.0;
+		double c = 0.0;
+		for (size_t j = 0; j < R; j++)
+		{
+			double a = GSL_MAX (w->apar[j], 0.0);
+			aT[j*n + s] = a;
+			d += a;
+			if (fsp_target (model, w, x, j))
+				c += a;
+		}
+		w->diag[s] = -d;
+		w->anorm = GSL_MAX (w->anorm, c + d);
+
+		for (size_t i = 0; (i < N) && (++x[i] > w->bound[i]); i++)
+			x[i] = 0;
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+// Share of the rows of the box handled by one thread
+typedef struct
+{
+	const sm_fsp_workspace * w;
+	const double * x;
+	double * y;
+	size_t lo;
+	size_t hi;
+	int * coord;
+	struct sm_fsp_pool * pool;
+} fsp_box_task;
+
+
+// Threads that apply the generator in the box layout. The calling thread runs
+// task 0, and the others wait for a new round to run theirs; pending counts
+// the tasks of the round that are not done yet.
+struct sm_fsp_pool
+{
+	pthread_mutex_t lock;
+	pthread_cond_t go;
+	pthread_cond_t done;
+	fsp_box_task task[SM_FSP_MAXTHREADS];
+	pthread_t thread[SM_FSP_MAXTHREADS];
+	int started[SM_FSP_MAXTHREADS];
+	size_t nt;
+	size_t pending;
+	unsigned long round;
+	int stop;
+};
+
+
+/**
+ y = A x on the rows of a task, a row being the states that differ only in
+ species 0: the probability flows into s from s - nu(j) through each reaction
+ j whose source lies in the box. Along a row the sources of a reaction that
+ lie in the box form a contiguous range, so the inner loops run over
+ contiguous memory.
+ */
+static void * fsp_box_apply (void * arg)
+{
+	fsp_box_task * task = arg;
+	const sm_fsp_workspace * w = task->w;
+	const stochmod * model = w->model;
+	const double * x = task->x;
+	double * y = task->y;
+	size_t n = w->nstates;
+	size_t N = w->nspecies;
+	long b0 = w->bound[0];
+	int * c = task->coord;
+
+	fsp_box_decode (w->bound, N, task->lo * (size_t) (b0 + 1), c);
+	for (size_t r = task->lo; r < task->hi; r++)
+	{
+		size_t s0 = r * (size_t) (b0 + 1);
+		for (long k = 0; k <= b0; k++)
+			y[s0 + k] = w->diag[s0 + k] * x[s0 + k];
+
+		for (size_t j = 0; j < w->nrxns; j++)
+		{
+			long lo = 0;
+			long hi = b0;
+			int inside = 1;
+			for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			{
+				size_t i = model->stoich_idx[q];
+				int v = model->stoich_val[q];
+				if (i == 0)
+				{
+					lo = GSL_MAX (0, v);
+					hi = GSL_MIN (b0, b0 + v);
+				}
+				else
+					inside = inside && (c[i] - v >= 0) && (c[i] - v <= w->bound[i]);
+			}
+			if (!inside || (lo > hi))
+				continue;
+
+			size_t src = (size_t) ((long) (s0 + lo) - w->boff[j]);
+			const double * a = w->aT + j*n + src;
+			const double * xs = x + src;
+			double * yr = y + s0 + lo;
+			for (long k = 0; k <= hi - lo; k++)
+				yr[k] += a[k] * xs[k];
+		}
+
+		for (size_t i = 1; (i < N) && (++c[i] > w->bound[i]); i++)
+			c[i] = 0;
+	}
+
+	return NULL;
+}
+
+
+/**
+ Thread of the pool: run its task once per round, until the pool is stopped.
+ */
+static void * fsp_pool_work (void * arg)
+{
+	fsp_box_task * task = arg;
+	struct sm_fsp_pool * pool = task->pool;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock (&pool->lock);
+	for (;;)
+	{
+		while (!pool->stop && (pool->round == seen))
+			pthread_cond_wait (&pool->go, &pool->lock);
+		if (pool->stop)
+			break;
+		seen = pool->round;
+		pthread_mutex_unlock (&pool->lock);
+
+		fsp_box_apply (task);
+
+		pthread_mutex_lock (&pool->lock);
+		if (--pool->pending == 0)
+			pthread_cond_signal (&pool->done);
+	}
+	pthread_mutex_unlock (&pool->lock);
+
+	return NULL;
+}
+
+
+/**
+ Start the threads that apply the generator in the box layout, when w->box
+ is set and w->nthreads > 1. Without a pool the calling thread does all the
+ work, so failures to start it are not errors.
+ */
+static void fsp_pool_start (sm_fsp_workspace * w)
+{
+	size_t nt = GSL_MIN (GSL_MAX (w->nthreads, 1), SM_FSP_MAXTHREADS);
+	w->pool = NULL;
+	if (!w->box || (nt < 2))
+		return;
+
+	struct sm_fsp_pool * pool = malloc (sizeof (struct sm_fsp_pool));
+	if (pool == NULL)
+		return;
+	if (pthread_mutex_init (&pool->lock, NULL) != 0)
+	{
+		free (pool);
+		return;
+	}
+	pthread_cond_init (&pool->go, NULL);
+	pthread_cond_init (&pool->done, NULL);
+	pool->nt = nt;
+	pool->pending = 0;
+	pool->round = 0;
+	pool->stop = 0;
+
+	// Threads that cannot be started leave their tasks to the calling thread
+	pool->started[0] = 0;
+	for (size_t t = 0; t < nt; t++)
+	{
+		pool->task[t].pool = pool;
+		pool->task[t].coord = w->bcoord + (t + 1) * w->nspecies;
+		if (t > 0)
+			pool->started[t] = (pthread_create (pool->thread + t, NULL, fsp_pool_work, pool->task + t) == 0);
+	}
+	w->pool = pool;
+}
+
+
+/**
+ Stop and join the threads started by fsp_pool_start.
+ */
+static void fsp_pool_stop (sm_fsp_workspace * w)
+{
+	struct sm_fsp_pool * pool = w->pool;
+	if (pool == NULL)
+		return;
+
+	pthread_mutex_lock (&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast (&pool->go);
+	pthread_mutex_unlock (&pool->lock);
+	for (size_t t = 1; t < pool->nt; t++)
+		if (pool->started[t])
+			pthread_join (pool->thread[t], NULL);
+
+	pthread_cond_destroy (&pool->go);
+	pthread_cond_destroy (&pool->done);
+	pthread_mutex_destroy (&pool->lock);
+	free (pool);
+	w->pool = NULL;
+}
+
+
+/**
+ y = A x in the box layout, with the rows split over the threads of w->pool.
+ Each thread writes its own range of y, so the only synchronization is the
+ start and the end of the round. Boxes of less than 4096 states per thread
+ are not split further.
+ */
+static void fsp_box_matvec (const sm_fsp_workspace * w, const double * x, double * y)
+{
+	struct sm_fsp_pool * pool = w->pool;
+	size_t n = w->nstates;
+	size_t rows = n / ((size_t) w->bound[0] + 1);
+	size_t nt = (pool != NULL) ? pool->nt : 1;
+	size_t nact = GSL_MAX (GSL_MIN (nt, n / 4096), 1);
+	nact = GSL_MIN (nact, rows);
+
+	if (nact == 1)
+	{
+		fsp_box_task task = {w, x, y, 0, rows, w->bcoord + w->nspecies, pool};
+		fsp_box_apply (&task);
+		return;
+	}
+
+	// The threads beyond nact get empty ranges
+	size_t pending = 0;
+	for (size_t t = 0; t < nt; t++)
+	{
+		fsp_box_task * task = pool->task + t;
+		task->w = w;
+		task->x = x;
+		task->y = y;
+		task->lo = (t < nact) ? (rows * t) / nact : rows;
+		task->hi = (t < nact) ? (rows * (t + 1)) / nact : rows;
+		pending += pool->started[t];
+	}
+
+	pthread_mutex_lock (&pool->lock);
+	pool->pending = pending;
+	pool->round++;
+	pthread_cond_broadcast (&pool->go);
+	pthread_mutex_unlock (&pool->lock);
+
+	for (size_t t = 0; t < nt; t++)
+		if (!pool->started[t])
+			fsp_box_apply (pool->task + t);
+
+	pthread_mutex_lock (&pool->lock);
+	while (pool->pending > 0)
+		pthread_cond_wait (&pool->done, &pool->lock);
+	pthread_mutex_unlock (&pool->lock);
+}
+
+
+/**
+ Explore the projection from its current states and record its transitions
+ in compressed column storage: the probability flowing out of state s goes to
+ states gidx(gptr(s)) ... gidx(gptr(s+1)-1) through reactions grxn. The
+ propensities of all reactions of s at the reference parameters are kept in
+ obase(s*R) ... obase(s*R + R-1), and the reactions are classified along the
+ way, so that the generator can be assembled by fsp_combine for any vector
+ of parameters without exploring the projection again.
+ */
+static int fsp_build (const stochmod * model, sm_fsp_workspace * w)
+{
+	size_t N = w->nspecies;
+	size_t R = w->nrxns;
+	size_t nnz = 0;
+
+	// Reference parameters, with the zero ones moved away from zero
+	for (size_t i = 0; i < w->npar; i++)
+		w->ref[i] = (w->par[i] != 0.0) ? w->par[i] : 1.0;
+	for (size_t j = 0; j < R; j++)
+		w->rxpar[j] = SM_FSP_UNSEEN;
+
+	for (size_t s = 0; s < w->nstates; s++)
+	{
+		double * aref = w->obase + s*R;
+		if ((fsp_propensity (model, w, w->ref, w->states + s*N, aref) != GSL_SUCCESS)
+				|| (fsp_propensity (model, w, w->par, w->states + s*N, w->apar) != GSL_SUCCESS)
+				|| (fsp_classify (model, w, w->states + s*N, aref) != GSL_SUCCESS))
+			return GSL_EFAILED;
+
+		w->gptr[s] = nnz;
+		for (size_t j = 0; j < R; j++)
+		{
+			if (((w->obase[s*R + j] <= 0.0) && (w->apar[j] <= 0.0))
+					|| !fsp_target (model, w, w->states + s*N, j))
+				continue;
+
+			size_t t = fsp_lookup (w, w->xt);
+			if ((t == SM_FSP_NONE) && ((t = fsp_insert (w, w->xt)) == SM_FSP_NONE))
+			{
+				fprintf (stderr, "error in fsp_build: projection exceeds %d states\n", (int) w->maxstates);
+				return GSL_EFAILED;
+			}
+
+			if (nnz == w->nnzcap)
+			{
+				size_t cap = 2 * w->nnzcap + R;
+				size_t * gidx = realloc (w->gidx, cap * sizeof (size_t));
+				if (gidx != NULL)
+					w->gidx = gidx;
+				double * gval = realloc (w->gval, cap * sizeof (double));
+				if (gval != NULL)
+					w->gval = gval;
+				size_t * grxn = realloc (w->grxn, cap * sizeof (size_t));
+				if (grxn != NULL)
+					w->grxn = grxn;
+				if ((gidx == NULL) || (gval == NULL) || (grxn == NULL))
+				{
+					fprintf (stderr, "error in fsp_build: failed to allocate generator\n");
+					return GSL_EFAILED;
+				}
+				w->nnzcap = cap;
+			}
+			w->gidx[nnz] = t;
+			w->grxn[nnz] = j;
+			nnz++;
+		}
+	}
+	w->gptr[w->nstates] = nnz;
+
+	w->affine = 1;
+	for (size_t j = 0; j < R; j++)
+		if (w->rxpar[j] == SM_FSP_NONAFFINE)
+			w->affine = 0;
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Assemble the generator of the projection for the parameters w->par, as
+ A = sum_i par(i)/ref(i) A_i + A_c: the entries of the reactions that are
+ affine in parameter i are rescaled from their reference values, those of the
+ constant reactions are used as they are. Only the reactions that are not
+ affine need new propensities. diag(s) is minus the total propensity of s,
+ including the flows that leave the box.
+ */
+static int fsp_combine (const stochmod * model, sm_fsp_workspace * w)
+{
+	size_t R = w->nrxns;
+	double * coef = w->coef;
+	double * a = w->apar;
+
+	for (size_t j = 0; j < R; j++)
+		coef[j] = (w->rxpar[j] >= 0) ? w->par[w->rxpar[j]] / w->ref[w->rxpar[j]] : 1.0;
+
+	w->anorm = 0.0;
+	for (size_t s = 0; s < w->nstates; s++)
+	{
+		const double * b = w->obase + s*R;
+		if (!w->affine && (fsp_propensity (model, w, w->par, w->states + s*w->nspecies, a) != GSL_SUCCESS))
+			return GSL_EFAILED;
+		for (size_t j = 0; j < R; j++)
+			if (w->rxpar[j] != SM_FSP_NONAFFINE)
+				a[j] = GSL_MAX (coef[j] * b[j], 0.0);
+
+		double d = 0.0;
+		for (size_t j = 0; j < R; j++)
+			d += a[j];
+		w->diag[s] = -d;
+		double c = d;
+		for (size_t q = w->gptr[s]; q < w->gptr[s+1]; q++)
+			c += (w->gval[q] = a[w->grxn[q]]);
+
+		// 1-norm of the generator, for the step size control of the Krylov method
+		w->anorm = GSL_MAX (w->anorm, c);
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Enlarge the box along the species through which probability is leaking out
+ of the projection, weighted by the distribution w->p.
+ */
+static int fsp_expand (const stochmod * model, sm_fsp_workspace * w)
+{
+	size_t N = w->nspecies;
+	double * leak = w->leak;
+	for (size_t i = 0; i < N; i++)
+		leak[i] = 0.0;
+
+	for (size_t s = 0; s < w->nstates; s++)
+	{
+		if (w->p[s] <= 0.0)
+			continue;
+		const int * x = fsp_state (w, s, w->bcoord);
+		if (fsp_propensity (model, w, w->par, x, w->apar) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		for (size_t j = 0; j < w->nrxns; j++)
+		{
+			double aj = w->apar[j];
+			if ((aj <= 0.0) || fsp_target (model, w, x, j))
+				continue;
+			for (size_t i = 0; i < N; i++)
+				if (w->xt[i] > w->bound[i])
+					leak[i] += w->p[s] * aj;
+		}
+	}
+
+	// Only the species that carry a sizeable share of the leak are expanded
+	double lmax = 0.0;
+	for (size_t i = 0; i < N; i++)
+		lmax = GSL_MAX (lmax, leak[i]);
+	for (size_t i = 0; i < N; i++)
+		if ((leak[i] >= 0.01 * lmax) || (lmax == 0.0))
+			w->bound[i] = (int) ceil (w->bound[i] * w->expand) + 1;
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ y = A x with the generator of the projection.
+ */
+static void fsp_matvec (const sm_fsp_workspace * w, const double * x, double * y)
+{
+	if (w->box)
+	{
+		fsp_box_matvec (w, x, y);
+		return;
+	}
+
+	for (size_t s = 0; s < w->nstates; s++)
+		y[s] = w->diag[s] * x[s];
+	for (size_t s = 0; s < w->nstates; s++)
+	{
+		double xs = x[s];
+		if (xs == 0.0)
+			continue;
+		for (size_t q = w->gptr[s]; q < w->gptr[s+1]; q++)
+			y[w->gidx[q]] += w->gval[q] * xs;
+	}
+}
+
+
+/**
+ F = exp(H) for the dense n x n matrix H (row-major), with the degree 6 Pade
+ approximant and scaling and squaring. H is overwritten.
+ */
+static int fsp_expm (sm_fsp_workspace * w, size_t n, double * H, double * F)
+{
+	gsl_matrix_view Hm = gsl_matrix_view_array (H, n, n);
+	gsl_matrix_view Fm = gsl_matrix_view_array (F, n, n);
+	gsl_matrix_view Xm = gsl_matrix_view_array (w->eX, n, n);
+	gsl_matrix_view Tm = gsl_matrix_view_array (w->eT, n, n);
+	gsl_matrix_view Dm = gsl_matrix_view_array (w->eD, n, n);
+	gsl_permutation perm = {n, w->eperm->data};
+
+	// Scale H so that its norm is below 1/2
+	double norm = 0.0;
+	for (size_t i = 0; i < n; i++)
+	{
+		double r = 0.0;
+		for (size_t k = 0; k < n; k++)
+			r += fabs (H[i*n + k]);
+		norm = GSL_MAX (norm, r);
+	}
+	int sq = (norm > 0.5) ? (int) ceil (log2 (norm / 0.5)) : 0;
+	gsl_matrix_scale (&Hm.matrix, ldexp (1.0, -sq));
+
+	// Numerator F and denominator D of the Pade approximant
+	const int q = 6;
+	double c = 1.0;
+	gsl_matrix_set_identity (&Fm.matrix);
+	gsl_matrix_set_identity (&Dm.matrix);
+	gsl_matrix_set_identity (&Xm.matrix);
+	for (int k = 1; k <= q; k++)
+	{
+		c *= (double) (q - k + 1) / (double) (k * (2*q - k + 1));
+		gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Hm.matrix, &Xm.matrix, 0.0, &Tm.matrix);
+		gsl_matrix_memcpy (&Xm.matrix, &Tm.matrix);
+		for (size_t i = 0; i < n*n; i++)
+		{
+			F[i] += c * w->eX[i];
+			w->eD[i] += ((k % 2) ? -c : c) * w->eX[i];
+		}
+	}
+
+	// exp(H/2^sq) = D^-1 F, column by column
+	int signum;
+	if (gsl_linalg_LU_decomp (&Dm.matrix, &perm, &signum) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	for (size_t k = 0; k < n; k++)
+	{
+		gsl_vector_view col = gsl_matrix_column (&Fm.matrix, k);
+		if (gsl_linalg_LU_svx (&Dm.matrix, &perm, &col.vector) != GSL_SUCCESS)
+			return GSL_EFAILED;
+	}
+
+	// Undo the scaling
+	for (int k = 0; k < sq; k++)
+	{
+		gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Fm.matrix, &Fm.matrix, 0.0, &Tm.matrix);
+		gsl_matrix_memcpy (&Fm.matrix, &Tm.matrix);
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Round a step size to two significant digits, as in Expokit.
+ */
+static double fsp_round (double h)
+{
+	double s = pow (10.0, floor (log10 (h)) - 1.0);
+	return ceil (h / s) * s;
+}
+
+
+/**
+ v = exp(tau A) v with the Krylov method of Expokit (R. B. Sidje, ACM TOMS
+ 24, 1998): the exponential is applied on Krylov subspaces of dimension w->m
+ built with the Arnoldi process, with local error estimates that control the
+ size of the substeps.
+ */
+static int fsp_expv (sm_fsp_workspace * w, double tau, double * v)
+{
+	size_t n = w->nstates;
+	size_t m = GSL_MIN (w->m, n);
+	size_t ld = w->m + 2;
+	double * V = w->V;
+	double * H = w->H;
+	double * F = w->F;
+	double * Hs = w->Hs;
+	const double tol = w->ktol;
+	const double btol = 1e-7;
+	const double gamma = 0.9;
+	const double delta = 1.2;
+	const unsigned int mxrej = 10;
+
+	double beta = 0.0;
+	for (size_t s = 0; s < n; s++)
+		beta += v[s] * v[s];
+	beta = sqrt (beta);
+	if ((beta == 0.0) || (w->anorm == 0.0))
+		return GSL_SUCCESS;
+
+	double xm = 1.0 / m;
+	double fact = pow ((m + 1) / M_E, m + 1) * sqrt (2.0 * M_PI * (m + 1));
+	double t_new = fsp_round ((1.0 / w->anorm) * pow ((fact * tol) / (4.0 * beta * w->anorm), xm));
+	double t_now = 0.0;
+
+	while (t_now < tau)
+	{
+		double t_step = GSL_MIN (tau - t_now, t_new);
+		int k1 = 2;
+		size_t mb = m;
+
+		// Arnoldi process
+		for (size_t s = 0; s < n; s++)
+			V[s] = v[s] / beta;
+		for (size_t i = 0; i < ld*ld; i++)
+			H[i] = 0.0;
+		for (size_t j = 0; j < m; j++)
+		{
+			double * p = V + (j+1)*n;
+			fsp_matvec (w, V + j*n, p);
+			for (size_t i = 0; i <= j; i++)
+			{
+				double h = 0.0;
+				for (size_t s = 0; s < n; s++)
+					h += V[i*n + s] * p[s];
+				H[i*ld + j] = h;
+				for (size_t s = 0; s < n; s++)
+					p[s] -= h * V[i*n + s];
+			}
+			double nrm = 0.0;
+			for (size_t s = 0; s < n; s++)
+				nrm += p[s] * p[s];
+			nrm = sqrt (nrm);
+
+			// Happy breakdown: the subspace is invariant and the step is exact
+			if (nrm < btol * w->anorm)
+			{
+				k1 = 0;
+				mb = j + 1;
+				t_step = tau - t_now;
+				break;
+			}
+			H[(j+1)*ld + j] = nrm;
+			for (size_t s = 0; s < n; s++)
+				p[s] /= nrm;
+		}
+		double avnorm = 0.0;
+		if (k1 != 0)
+		{
+			H[(m+1)*ld + m] = 1.0;
+			fsp_matvec (w, V + m*n, w->av);
+			for (size_t s = 0; s < n; s++)
+				avnorm += w->av[s] * w->av[s];
+			avnorm = sqrt (avnorm);
+		}
+
+		// Exponential of the small matrix, shrinking the step until the error is small enough
+		size_t mx = mb + k1;
+		double err_loc = btol;
+		for (unsigned int ireject = 0; ; ireject++)
+		{
+			for (size_t i = 0; i < mx; i++)
+				for (size_t k = 0; k < mx; k++)
+					Hs[i*mx + k] = t_step * H[i*ld + k];
+			if (fsp_expm (w, mx, Hs, F) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			if (k1 == 0)
+				break;
+
+			double phi1 = fabs (beta * F[m*mx]);
+			double phi2 = fabs (beta * F[(m+1)*mx] * avnorm);
+			if (phi1 > 10.0 * phi2)
+			{
+				err_loc = phi2;
+				xm = 1.0 / m;
+			}
+			else if (phi1 > phi2)
+			{
+				err_loc = (phi1 * phi2) / (phi1 - phi2);
+				xm = 1.0 / m;
+			}
+			else
+			{
+				err_loc = phi1;
+				xm = 1.0 / (m > 1 ? m - 1 : 1);
+			}
+			if (err_loc <= delta * t_step * tol)
+				break;
+			if (ireject == mxrej)
+			{
+				fprintf (stderr, "error in fsp_expv: requested tolerance is too high\n");
+				return GSL_EFAILED;
+			}
+			t_step = fsp_round (gamma * t_step * pow (t_step * tol / err_loc, xm));
+		}
+
+		// New vector from the first column of the exponential
+		mx = mb + ((k1 > 0) ? 1 : 0);
+		for (size_t s = 0; s < n; s++)
+		{
+			double x = 0.0;
+			for (size_t i = 0; i < mx; i++)
+				x += V[i*n + s] * F[i*(mb + k1)];
+			v[s] = beta * x;
+		}
+		beta = 0.0;
+		for (size_t s = 0; s < n; s++)
+			beta += v[s] * v[s];
+		beta = sqrt (beta);
+
+		t_now += t_step;
+		t_new = fsp_round (gamma * t_step * pow (t_step * tol / GSL_MAX (err_loc, GSL_DBL_MIN), xm));
+		if (beta == 0.0)
+			break;
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Allocate a workspace for the FSP solver that fits the given model. The model
+ must export its stoichiometry. The Krylov workspace is sized for projections
+ up to w->maxstates states and grows with the projection.
+ */
+sm_fsp_workspace * sm_fsp_workspace_alloc (const stochmod * model)
+{
+	if (model->stoich_ptr == NULL)
+	{
+		fprintf (stderr, "error in sm_fsp_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_fsp_workspace * w = malloc (sizeof (sm_fsp_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_fsp_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	w->nspecies = N;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->m = 30;
+	size_t ld = w->m + 2;
+
+	w->states = NULL;
+	w->hash = malloc (1024 * sizeof (size_t));
+	w->hashsize = 1024;
+	w->nstates = 0;
+	w->capacity = 0;
+	w->gptr = NULL;
+	w->gidx = NULL;
+	w->gval = NULL;
+	w->grxn = NULL;
+	w->diag = NULL;
+	w->obase = NULL;
+	w->nnzcap = 0;
+	w->p = NULL;
+	w->P = NULL;
+	w->error = NULL;
+	w->ntimes = 0;
+	w->V = NULL;
+	w->av = NULL;
+	w->vcap = 0;
+	w->H = malloc (ld * ld * sizeof (double));
+	w->Hs = malloc (ld * ld * sizeof (double));
+	w->F = malloc (ld * ld * sizeof (double));
+	w->eX = malloc (ld * ld * sizeof (double));
+	w->eT = malloc (ld * ld * sizeof (double));
+	w->eD = malloc (ld * ld * sizeof (double));
+	w->eperm = gsl_permutation_alloc (ld);
+	w->bound = malloc ((N + 1) * sizeof (int));
+	w->xt = malloc ((N + 1) * sizeof (int));
+	w->leak = malloc ((N + 1) * sizeof (double));
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->ref = malloc ((w->npar + 1) * sizeof (double));
+	w->probe = malloc ((w->npar + 1) * sizeof (double));
+	w->apar = malloc (model->nrxns * sizeof (double));
+	w->coef = malloc (model->nrxns * sizeof (double));
+	w->rxpar = malloc (model->nrxns * sizeof (int));
+	w->xcls = malloc (model->nrxns * sizeof (int));
+	w->x0 = malloc ((N + 1) * sizeof (int));
+	w->model = NULL;
+	w->affine = 1;
+	w->aT = NULL;
+	w->boff = malloc (model->nrxns * sizeof (long));
+	w->bstride = malloc ((N + 1) * sizeof (size_t));
+	w->bcoord = malloc ((SM_FSP_MAXTHREADS + 1) * (N + 1) * sizeof (int));
+	w->bold = malloc ((N + 1) * sizeof (int));
+	w->pool = NULL;
+	w->box = 0;
+	w->boxed = 0;
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->Xd = gsl_vector_alloc (N);
+
+	if ((w->hash == NULL) || (w->H == NULL) || (w->Hs == NULL) || (w->F == NULL) || (w->eX == NULL)
+			|| (w->eT == NULL) || (w->eD == NULL) || (w->eperm == NULL) || (w->bound == NULL)
+			|| (w->xt == NULL) || (w->leak == NULL) || (w->par == NULL) || (w->ref == NULL)
+			|| (w->probe == NULL) || (w->apar == NULL) || (w->coef == NULL) || (w->rxpar == NULL)
+			|| (w->xcls == NULL) || (w->x0 == NULL) || (w->boff == NULL) || (w->bstride == NULL)
+			|| (w->bcoord == NULL) || (w->bold == NULL) || (w->prop == NULL)
+			|| (w->Xd == NULL))
+	{
+		fprintf (stderr, "error in sm_fsp_workspace_alloc: failed to allocate workspace members\n");
+		sm_fsp_workspace_free (w);
+		return NULL;
+	}
+
+	// Default tuning
+	w->tol = 1e-6;
+	w->ktol = 1e-10;
+	w->expand = 1.5;
+	w->nbound = 20;
+	w->maxstates = 1 << 22;
+	w->nthreads = 1;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_fsp_workspace_alloc.
+ */
+void sm_fsp_workspace_free (sm_fsp_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	free (w->states);
+	free (w->hash);
+	free (w->gptr);
+	free (w->gidx);
+	free (w->gval);
+	free (w->grxn);
+	free (w->diag);
+	free (w->obase);
+	free (w->p);
+	free (w->P);
+	free (w->error);
+	free (w->V);
+	free (w->av);
+	free (w->H);
+	free (w->Hs);
+	free (w->F);
+	free (w->eX);
+	free (w->eT);
+	free (w->eD);
+	if (w->eperm != NULL)
+		gsl_permutation_free (w->eperm);
+	free (w->bound);
+	free (w->xt);
+	free (w->leak);
+	free (w->par);
+	free (w->ref);
+	free (w->probe);
+	free (w->apar);
+	free (w->coef);
+	free (w->rxpar);
+	free (w->xcls);
+	free (w->x0);
+	free (w->aT);
+	free (w->boff);
+	free (w->bstride);
+	free (w->bcoord);
+	free (w->bold);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->Xd != NULL)
+		gsl_vector_free (w->Xd);
+	free (w);
+}
+
+
+/**
+ Propagate the distribution in w->p from tgrid(0) through the time points of
+ tgrid, recording it in w->P and expanding the projection whenever more than
+ w->tol of the probability leaves it.
+ */
+static int fsp_advance (const stochmod * model, const gsl_vector * tgrid, sm_fsp_workspace * w)
+{
+	size_t N = model->nspecies;
+	size_t ntimes = tgrid->size;
+
+	double t = gsl_vector_get (tgrid, 0);
+	for (size_t k = 0; k < ntimes; k++)
+	{
+		double tk = gsl_vector_get (tgrid, k);
+		double sum;
+		for (;;)
+		{
+			// Krylov basis for the current size of the projection
+			if (w->vcap < w->nstates)
+			{
+				size_t cap = GSL_MAX (w->capacity, w->nstates);
+				double * V = realloc (w->V, (w->m + 1) * cap * sizeof (double));
+				if (V != NULL)
+					w->V = V;
+				double * av = realloc (w->av, cap * sizeof (double));
+				if (av != NULL)
+					w->av = av;
+				if ((V == NULL) || (av == NULL))
+				{
+					fprintf (stderr, "error in sm_fsp_run: failed to allocate Krylov basis\n");
+					return GSL_EFAILED;
+				}
+				w->vcap = cap;
+			}
+
+			if ((tk > t) && (fsp_expv (w, tk - t, w->p) != GSL_SUCCESS))
+				return GSL_EFAILED;
+
+			sum = 0.0;
+			for (size_t s = 0; s < w->nstates; s++)
+				sum += w->p[s];
+			if ((1.0 - sum <= w->tol) || (tk <= t))
+				break;
+
+			// Too much probability has left: enlarge the projection and retry from tgrid(k-1)
+			w->model = NULL;
+			memcpy (w->bold, w->bound, N * sizeof (int));
+			if (fsp_expand (model, w) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			if (w->box ? (fsp_box_build (model, w, w->bold) != GSL_SUCCESS)
+					: ((fsp_build (model, w) != GSL_SUCCESS) || (fsp_combine (model, w) != GSL_SUCCESS)))
+				return GSL_EFAILED;
+			w->model = model;
+			for (size_t s = 0; s < w->nstates; s++)
+				w->p[s] = w->P[s * ntimes + k - 1];
+		}
+
+		for (size_t s = 0; s < w->nstates; s++)
+			w->P[s * ntimes + k] = w->p[s];
+		w->error[k] = GSL_MAX (1.0 - sum, 0.0);
+		t = tk;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Solve the chemical master equation of the model with the finite state
+ projection method of Munsky and Khammash (J. Chem. Phys. 124, 2006).
+
+ Arguments:
+ 	 model: the model
+ 	 params: vector of parameters and inputs of the model
+ 	 X0: initial state (non-negative integers)
+ 	 tgrid: time points at which the distribution is stored
+ 	 w: workspace
+
+ The projection starts as the states reachable from X0 inside the box
+ 0 <= X(i) <= X0(i) + w->nbound. The distribution is propagated from one point
+ of tgrid to the next with a Krylov matrix exponential; when more than w->tol
+ of the probability has left the projection, the box is enlarged by w->expand
+ along the species through which it leaked and the step is repeated. On
+ output, sm_fsp_prob and sm_fsp_marginal give access to the distributions,
+ and w->error(k) is the probability lost at time tgrid(k), a bound on the
+ 1-norm error of the distribution.
+
+ The projection is kept in the workspace: a new run with the same model and
+ initial state, typically with other parameters in the evaluation of a
+ likelihood, starts from it and only reassembles the generator from its
+ affine decomposition in the parameters (see fsp_combine), which costs one
+ pass over its transitions. Propensities that are not proportional to a
+ single parameter, such as Hill functions, are evaluated again in each state.
+
+ With w->box set, the projection is the whole box instead and the generator
+ is applied as a stencil without assembling it (see fsp_box_build), on
+ w->nthreads threads that are started once per run and handed every product
+ of the Krylov iterations. This needs a fraction of the memory of the default
+ layout per state, at the price of the unreachable states of the box.
+ */
+int sm_fsp_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, sm_fsp_workspace * w)
+{
+	size_t N = model->nspecies;
+
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_fsp_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != N) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_fsp_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	for (size_t i = 0; i < N; i++)
+	{
+		double x = gsl_vector_get (X0, i);
+		if ((x < 0.0) || (x != floor (x)))
+		{
+			fprintf (stderr, "error in sm_fsp_run: initial state must be a non-negative integer\n");
+			return GSL_EFAILED;
+		}
+		w->xt[i] = (int) x;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+
+	// Snapshots of the distribution
+	size_t ntimes = tgrid->size;
+	double * err = realloc (w->error, ntimes * sizeof (double));
+	if (err == NULL)
+	{
+		fprintf (stderr, "error in sm_fsp_run: failed to allocate snapshots\n");
+		return GSL_EFAILED;
+	}
+	w->error = err;
+	double * P = realloc (w->P, GSL_MAX (w->capacity, 1) * ntimes * sizeof (double));
+	if (P == NULL)
+	{
+		fprintf (stderr, "error in sm_fsp_run: failed to allocate snapshots\n");
+		return GSL_EFAILED;
+	}
+	w->P = P;
+	w->ntimes = ntimes;
+
+	if ((w->model == model) && (w->nstates > 0) && (w->boxed == w->box)
+			&& (memcmp (w->x0, w->xt, N * sizeof (int)) == 0))
+	{
+		// Same model, layout and initial state as the last run: keep its projection
+		if (w->box && (fsp_box_build (model, w, NULL) != GSL_SUCCESS))
+			return GSL_EFAILED;
+	}
+	else
+	{
+		// Initial projection
+		w->model = NULL;
+		w->nstates = 0;
+		for (size_t h = 0; h < w->hashsize; h++)
+			w->hash[h] = SM_FSP_NONE;
+		for (size_t i = 0; i < N; i++)
+			w->bound[i] = w->xt[i] + w->nbound;
+		memcpy (w->x0, w->xt, N * sizeof (int));
+		if (w->box)
+		{
+			if (fsp_box_build (model, w, NULL) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+		else
+		{
+			if (fsp_insert (w, w->x0) != 0)
+			{
+				fprintf (stderr, "error in sm_fsp_run: failed to allocate projection\n");
+				return GSL_EFAILED;
+			}
+			if (fsp_build (model, w) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+		w->boxed = w->box;
+		w->model = model;
+	}
+	if (!w->box && (fsp_combine (model, w) != GSL_SUCCESS))
+		return GSL_EFAILED;
+	for (size_t s = 0; s < w->nstates; s++)
+		w->p[s] = 0.0;
+	w->p[w->box ? fsp_box_index (w, w->x0) : 0] = 1.0;
+
+	// The threads of the box layout live as long as the run
+	fsp_pool_start (w);
+	int status = fsp_advance (model, tgrid, w);
+	fsp_pool_stop (w);
+
+	return status;
+}
+
+
+/**
+ Probability of the state x at time tgrid(k), from the last call to
+ sm_fsp_run. States outside the projection have probability zero.
+ */
+double sm_fsp_prob (sm_fsp_workspace * w, size_t k, const gsl_vector_int * x)
+{
+	if ((k >= w->ntimes) || (x->size != w->nspecies))
+		return 0.0;
+
+	for (size_t i = 0; i < w->nspecies; i++)
+		w->xt[i] = gsl_vector_int_get (x, i);
+	size_t s = w->box ? fsp_box_index (w, w->xt) : fsp_lookup (w, w->xt);
+
+	return (s == SM_FSP_NONE) ? 0.0 : w->P[s * w->ntimes + k];
+}
+
+
+/**
+ Marginal distribution of a species at time tgrid(k), from the last call to
+ sm_fsp_run: m(n) is the probability that the species has n molecules. The
+ probability of populations beyond the size of m is discarded.
+ */
+int sm_fsp_marginal (const sm_fsp_workspace * w, size_t k, size_t species, gsl_vector * m)
+{
+	if ((k >= w->ntimes) || (species >= w->nspecies))
+	{
+		fprintf (stderr, "error in sm_fsp_marginal: time index or species is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	gsl_vector_set_zero (m);
+	for (size_t s = 0; s < w->nstates; s++)
+	{
+		size_t n = w->box ? (s / w->bstride[species]) % ((size_t) w->bound[species] + 1)
+				: (size_t) w->states[s * w->nspecies + species];
+		if (n < m->size)
+			gsl_vector_set (m, n, gsl_vector_get (m, n) + w->P[s * w->ntimes + k]);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,441 @@
+/*
+ *  hybrid.c
+ *  StochMod
+ *
+ *	Hybrid SSA/ODE simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_math.h>
+
+// Relative tolerance and maximum number of iterations of the search for the
+// time of the next discrete event inside a step
+#define HYB_EVENT_TOL 1e-10
+#define HYB_EVENT_MAXITER 50
+
+
+/**
+ Evaluate the propensities in the state X into w->prop, clamped to
+ non-negative values.
+ */
+static int hyb_propensity (const stochmod * model, const gsl_vector * params, sm_hyb_workspace * w,
+		gsl_vector * X)
+{
+	if (w->fast)
+		model->propensity_raw (X->data, w->par, w->prop->data);
+	else if (model->propensity (X, params, w->prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	double * a = w->prop->data;
+	for (size_t j = 0; j < w->nrxns; j++)
+		a[j] = GSL_MAX (a[j], 0.0);
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Right hand side of the hybrid system in the state w->Xt: dx is the drift of
+ the continuous reactions, *g the total propensity of the discrete ones.
+ */
+static int hyb_rhs (const stochmod * model, const gsl_vector * params, sm_hyb_workspace * w,
+		double * dx, double * g)
+{
+	if (hyb_propensity (model, params, w, w->Xt) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	const double * a = w->prop->data;
+	for (size_t i = 0; i < w->nspecies; i++)
+		dx[i] = 0.0;
+	*g = 0.0;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		if (!w->cont[j])
+		{
+			*g += a[j];
+			continue;
+		}
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			dx[model->stoich_idx[q]] += model->stoich_val[q] * a[j];
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Advance the continuous species by h with the classical Runge-Kutta scheme,
+ starting from the state saved in w->Xs. The integral of the total discrete
+ propensity over the step is returned in *dG.
+ */
+static int hyb_step (const stochmod * model, const gsl_vector * params, sm_hyb_workspace * w,
+		double h, double * dG)
+{
+	size_t N = w->nspecies;
+	const double * xs = w->Xs;
+	double * x = w->X->data;
+	double * xt = w->Xt->data;
+	double * k = w->k;
+	double g[4];
+	const double c[4] = {0.0, 0.5, 0.5, 1.0};
+
+	for (size_t s = 0; s < 4; s++)
+	{
+		for (size_t i = 0; i < N; i++)
+			xt[i] = (s == 0) ? xs[i] : GSL_MAX (xs[i] + c[s] * h * k[(s-1)*N + i], 0.0);
+		if (hyb_rhs (model, params, w, k + s*N, g + s) != GSL_SUCCESS)
+			return GSL_EFAILED;
+	}
+
+	for (size_t i = 0; i < N; i++)
+		x[i] = GSL_MAX (xs[i] + h/6.0 * (k[i] + 2.0*k[N+i] + 2.0*k[2*N+i] + k[3*N+i]), 0.0);
+	*dG = h/6.0 * (g[0] + 2.0*g[1] + 2.0*g[2] + g[3]);
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Split the model for the next step. A species is continuous when its
+ population is at least w->threshold; discrete species are rounded to the
+ nearest integer. A reaction is continuous when it would fire at least
+ w->nfire times in a step of length w->dt and all the species it reads or
+ changes are continuous. Returns the number of continuous reactions, and
+ leaves the propensities in the current state in w->prop.
+ */
+static int hyb_partition (const stochmod * model, const gsl_vector * params, sm_hyb_workspace * w,
+		size_t * ncont)
+{
+	double * x = w->X->data;
+	for (size_t i = 0; i < w->nspecies; i++)
+	{
+		w->contsp[i] = (x[i] >= w->threshold);
+		if (!w->contsp[i])
+			x[i] = floor (x[i] + 0.5);
+	}
+
+	if (hyb_propensity (model, params, w, w->X) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	const double * a = w->prop->data;
+	*ncont = 0;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		char c = (a[j] * w->dt >= w->nfire);
+		for (size_t q = model->react_ptr[j]; c && (q < model->react_ptr[j+1]); q++)
+			c = w->contsp[model->react_idx[q]];
+		for (size_t q = model->stoich_ptr[j]; c && (q < model->stoich_ptr[j+1]); q++)
+			c = w->contsp[model->stoich_idx[q]];
+		w->cont[j] = c;
+		*ncont += c;
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Fire one of the discrete reactions, chosen with probability proportional to
+ its propensity in w->prop.
+ */
+static void hyb_fire (const stochmod * model, sm_hyb_workspace * w)
+{
+	const double * a = w->prop->data;
+	double * x = w->X->data;
+	double a0 = 0.0;
+	for (size_t j = 0; j < w->nrxns; j++)
+		if (!w->cont[j])
+			a0 += a[j];
+	if (a0 <= 0.0)
+		return;
+
+	double target = a0 * sm_rngbuf_uniform (&w->rb);
+	double cumsum = 0.0;
+	size_t rxnid = w->nrxns;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		if (w->cont[j] || (a[j] <= 0.0))
+			continue;
+		rxnid = j;
+		cumsum += a[j];
+		if (target < cumsum)
+			break;
+	}
+
+	for (size_t q = model->stoich_ptr[rxnid]; q < model->stoich_ptr[rxnid+1]; q++)
+	{
+		size_t i = model->stoich_idx[q];
+		x[i] = GSL_MAX (x[i] + model->stoich_val[q], 0.0);
+	}
+}
+
+
+/**
+ Allocate a workspace for the hybrid engine that fits the given model. The
+ model must export its stoichiometry and reactant tables, which are used to
+ partition the reactions.
+ */
+sm_hyb_workspace * sm_hyb_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->react_ptr == NULL))
+	{
+		fprintf (stderr, "error in sm_hyb_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_hyb_workspace * w = malloc (sizeof (sm_hyb_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_hyb_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	w->nspecies = N;
+	w->nrxns = R;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (N);
+	w->Xt = gsl_vector_alloc (N);
+	w->prop = gsl_vector_alloc (R);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->Xs = malloc ((N + 1) * sizeof (double));
+	w->k = malloc ((4*N + 1) * sizeof (double));
+	w->contsp = malloc (N + 1);
+	w->cont = malloc (R + 1);
+
+	if ((w->X == NULL) || (w->Xt == NULL) || (w->prop == NULL) || (w->par == NULL) || (w->Xs == NULL)
+			|| (w->k == NULL) || (w->contsp == NULL) || (w->cont == NULL))
+	{
+		fprintf (stderr, "error in sm_hyb_workspace_alloc: failed to allocate workspace members\n");
+		sm_hyb_workspace_free (w);
+		return NULL;
+	}
+
+	// Default tuning
+	w->dt = 0.1;
+	w->threshold = 100.0;
+	w->nfire = 10.0;
+	w->fast = 0;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_hyb_workspace_alloc.
+ */
+void sm_hyb_workspace_free (sm_hyb_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->Xt != NULL)
+		gsl_vector_free (w->Xt);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	free (w->par);
+	free (w->Xs);
+	free (w->k);
+	free (w->contsp);
+	free (w->cont);
+	free (w);
+}
+
+
+/**
+ Find the length hf of the step from w->Xs at which the integrated discrete
+ propensity reaches the threshold of the next event, and leave the state
+ after that step in w->X. The threshold is rem above the start of the step,
+ and the step of length h overshoots it by over >= 0. The integral increases
+ with the length of the step, so the crossing is bracketed and found by
+ regula falsi with the Illinois modification.
+ */
+static int hyb_event (const stochmod * model, const gsl_vector * params, sm_hyb_workspace * w,
+		double h, double over, double rem, double * hf)
+{
+	double lo = 0.0, flo = -rem;
+	double hi = h, fhi = over;
+	int side = 0;
+
+	*hf = h * rem / (rem + over);
+	for (unsigned int iter = 1; ; iter++)
+	{
+		double dG;
+		if (hyb_step (model, params, w, *hf, &dG) != GSL_SUCCESS)
+			return GSL_EFAILED;
+
+		double f = dG - rem;
+		if ((fabs (f) <= HYB_EVENT_TOL * rem) || (hi - lo <= GSL_DBL_EPSILON * h)
+				|| (iter == HYB_EVENT_MAXITER))
+			break;
+		if (f < 0.0)
+		{
+			lo = *hf;
+			flo = f;
+			if (side == -1)
+				fhi /= 2.0;
+			side = -1;
+		}
+		else
+		{
+			hi = *hf;
+			fhi = f;
+			if (side == 1)
+				flo /= 2.0;
+			side = 1;
+		}
+		*hf = lo + (hi - lo) * flo / (flo - fhi);
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Simulate one trajectory of the model with a hybrid method in the spirit of
+ Haseltine and Rawlings (J. Chem. Phys. 117, 2002) and Salis and Kaznessis
+ (J. Chem. Phys. 122, 2005).
+
+ Arguments and output are the same as in sm_ssa_direct_run. At the start of
+ every step the reactions are split as described in hyb_partition: the
+ continuous ones are integrated as reaction rate equations with a fixed step
+ w->dt (shortened to land on the points of tgrid), while the discrete ones
+ fire as in the SSA. The time of the next discrete event accounts for the
+ time-varying propensities by integrating their sum along with the
+ continuous species, until it reaches an exponential random threshold; the
+ step in which this happens is shortened to the crossing point, located by
+ hyb_event to a relative tolerance of HYB_EVENT_TOL. Species move between
+ the two regimes as their populations cross w->threshold, so that promoter
+ states and other low copy species are always simulated exactly.
+ When no reaction is continuous the engine reduces to the direct SSA.
+ */
+int sm_hyb_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_hyb_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_hyb_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_hyb_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_hyb_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (w->dt <= 0.0)
+	{
+		fprintf (stderr, "error in sm_hyb_run: step size must be positive\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	double * x = w->X->data;
+	const double * a = w->prop->data;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	// Integrated discrete propensity and its threshold for the next event
+	double G = 0.0;
+	double xi = sm_rngbuf_exponential (&w->rb);
+
+	w->fast = (model->propensity_raw != NULL);
+	gsl_vector_memcpy (w->X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+
+	while (k < ntimes)
+	{
+		// Record the time points that have been reached
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) <= t))
+		{
+			gsl_matrix_set_row (states, k, w->X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		size_t ncont;
+		if (hyb_partition (model, params, w, &ncont) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		double horizon = gsl_vector_get (tgrid, k) - t;
+
+		// Purely discrete: the propensities are constant until the next event
+		if (ncont == 0)
+		{
+			double a0 = 0.0;
+			for (size_t j = 0; j < R; j++)
+				a0 += a[j];
+			double tau = (a0 > 0.0) ? (xi - G) / a0 : INFINITY;
+			if (tau >= horizon)
+			{
+				G += a0 * horizon;
+				t = gsl_vector_get (tgrid, k);
+				continue;
+			}
+			t += tau;
+			hyb_fire (model, w);
+			G = 0.0;
+			xi = sm_rngbuf_exponential (&w->rb);
+			continue;
+		}
+
+		double h = GSL_MIN (w->dt, horizon);
+		double dG;
+		for (size_t i = 0; i < N; i++)
+			w->Xs[i] = x[i];
+		if (hyb_step (model, params, w, h, &dG) != GSL_SUCCESS)
+			return GSL_EFAILED;
+
+		if (G + dG < xi)
+		{
+			G += dG;
+			t = (h == horizon) ? gsl_vector_get (tgrid, k) : t + h;
+			continue;
+		}
+
+		// A discrete event falls inside the step: integrate up to it and fire
+		double hf;
+		if (hyb_event (model, params, w, h, G + dG - xi, xi - G, &hf) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		t += hf;
+		if (hyb_propensity (model, params, w, w->X) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		hyb_fire (model, w);
+		G = 0.0;
+		xi = sm_rngbuf_exponential (&w->rb);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -102,6 +102,538 @@ int iff_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_ve
 }
 
 
+/**
+ Incremental propensity update function for iFF.
+ */
+int iff_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != N) || (params->size != L+Z) || (prop->size != R))
+	{
+		fprintf (stderr, "error in iff_propensity_update: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - propensities: %d\n", (int) X->size, (int) params->size, (int) prop->size);
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= R)
+	{
+		fprintf (stderr, "error in iff_propensity_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		double k5 = gsl_vector_get (params, 4);
+		gsl_vector_set (prop, 1, (k2)*X1);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		gsl_vector_set (prop, 4, (k5)*X1);
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		double k5 = gsl_vector_get (params, 4);
+		gsl_vector_set (prop, 1, (k2)*X1);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		gsl_vector_set (prop, 4, (k5)*X1);
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k6 = gsl_vector_get (params, 5);
+		gsl_vector_set (prop, 3, (k4)*X2);
+		gsl_vector_set (prop, 5, (k6)*X2*X3);
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k6 = gsl_vector_get (params, 5);
+		gsl_vector_set (prop, 3, (k4)*X2);
+		gsl_vector_set (prop, 5, (k6)*X2*X3);
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = 1.0;
+		double k8 = 1.0;
+		gsl_vector_set (prop, 5, (k6)*X2*X3);
+		gsl_vector_set (prop, 6, (k7)*X3);
+		gsl_vector_set (prop, 7, (k8)*X3);
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = 1.0;
+		double k8 = 1.0;
+		gsl_vector_set (prop, 5, (k6)*X2*X3);
+		gsl_vector_set (prop, 6, (k7)*X3);
+		gsl_vector_set (prop, 7, (k8)*X3);
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = 1.0;
+		double k8 = 1.0;
+		gsl_vector_set (prop, 5, (k6)*X2*X3);
+		gsl_vector_set (prop, 6, (k7)*X3);
+		gsl_vector_set (prop, 7, (k8)*X3);
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double k9 = 1.0;
+		gsl_vector_set (prop, 8, (k9)*X4);
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double k9 = 1.0;
+		gsl_vector_set (prop, 8, (k9)*X4);
+		break;
+	}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for iFF: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int iff_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in iff_propensity_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X2 = gsl_vector_get (X, 1);
+	double X3 = gsl_vector_get (X, 2);
+
+	// Get the parameters
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = 1.0;
+	double k8 = 1.0;
+	double k9 = 1.0;
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, (k2));
+	gsl_matrix_set (J, 2, 0, (k3));
+	gsl_matrix_set (J, 3, 1, (k4));
+	gsl_matrix_set (J, 4, 0, (k5));
+	gsl_matrix_set (J, 5, 1, (k6)*X3);
+	gsl_matrix_set (J, 5, 2, (k6)*X2);
+	gsl_matrix_set (J, 6, 2, (k7));
+	gsl_matrix_set (J, 7, 2, (k8));
+	gsl_matrix_set (J, 8, 3, (k9));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for iFF: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int iff_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (H->size1 != R) || (H->size2 != N*N))
+	{
+		fprintf (stderr, "error in iff_propensity_hessian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - hessian: %d x %d\n", (int) X->size, (int) params->size, (int) H->size1, (int) H->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k6 = gsl_vector_get (params, 5);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 5, 6, (k6));
+	gsl_matrix_set (H, 5, 9, (k6));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for iFF, on contiguous arrays.
+ */
+void iff_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = 1.0;
+	double k8 = 1.0;
+	double k9 = 1.0;
+
+	// Compute the propensities
+	prop[0] = (k1);
+	prop[1] = (k2)*X1;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4)*X2;
+	prop[4] = (k5)*X1;
+	prop[5] = (k6)*X2*X3;
+	prop[6] = (k7)*X3;
+	prop[7] = (k8)*X3;
+	prop[8] = (k9)*X4;
+}
+
+
+/**
+ Unchecked incremental propensity update function for iFF, on contiguous arrays.
+ */
+void iff_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k5 = params[4];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		prop[4] = (k5)*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k5 = params[4];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		prop[4] = (k5)*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k4 = params[3];
+		double k6 = params[5];
+		prop[3] = (k4)*X2;
+		prop[5] = (k6)*X2*X3;
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k4 = params[3];
+		double k6 = params[5];
+		prop[3] = (k4)*X2;
+		prop[5] = (k6)*X2*X3;
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = X[3];
+		double k9 = 1.0;
+		prop[8] = (k9)*X4;
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = X[3];
+		double k9 = 1.0;
+		prop[8] = (k9)*X4;
+		break;
+	}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for iFF, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void iff_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = 1.0;
+	double k8 = 1.0;
+	double k9 = 1.0;
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = (k1);
+		prop[SM_LOCK_LANES+l] = (k2)*X1;
+		prop[2*SM_LOCK_LANES+l] = (k3)*X1;
+		prop[3*SM_LOCK_LANES+l] = (k4)*X2;
+		prop[4*SM_LOCK_LANES+l] = (k5)*X1;
+		prop[5*SM_LOCK_LANES+l] = (k6)*X2*X3;
+		prop[6*SM_LOCK_LANES+l] = (k7)*X3;
+		prop[7*SM_LOCK_LANES+l] = (k8)*X3;
+		prop[8*SM_LOCK_LANES+l] = (k9)*X4;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for iFF, on an integer state array.
+ */
+void iff_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = 1.0;
+	double k8 = 1.0;
+	double k9 = 1.0;
+
+	// Compute the propensities
+	prop[0] = (k1);
+	prop[1] = (k2)*X1;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4)*X2;
+	prop[4] = (k5)*X1;
+	prop[5] = (k6)*X2*X3;
+	prop[6] = (k7)*X3;
+	prop[7] = (k8)*X3;
+	prop[8] = (k9)*X4;
+}
+
+
+/**
+ Unchecked incremental propensity update function for iFF, on an integer state array.
+ */
+void iff_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k5 = params[4];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		prop[4] = (k5)*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k5 = params[4];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		prop[4] = (k5)*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k4 = params[3];
+		double k6 = params[5];
+		prop[3] = (k4)*X2;
+		prop[5] = (k6)*X2*X3;
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k4 = params[3];
+		double k6 = params[5];
+		prop[3] = (k4)*X2;
+		prop[5] = (k6)*X2*X3;
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double k6 = params[5];
+		double k7 = 1.0;
+		double k8 = 1.0;
+		prop[5] = (k6)*X2*X3;
+		prop[6] = (k7)*X3;
+		prop[7] = (k8)*X3;
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = X[3];
+		double k9 = 1.0;
+		prop[8] = (k9)*X4;
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = X[3];
+		double k9 = 1.0;
+		prop[8] = (k9)*X4;
+		break;
+	}
+	}
+}
+
+
 /**
  State update function for iFF.
  */
@@ -166,6 +698,100 @@ int iff_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for iFF, on a contiguous array.
+ */
+void iff_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[2] += 1;
+		break;
+
+	case 5:
+		X[2] -= 1;
+		break;
+
+	case 6:
+		X[2] -= 1;
+		break;
+
+	case 7:
+		X[3] += 1;
+		break;
+
+	case 8:
+		X[3] -= 1;
+		break;
+	}
+}
+
+
+/**
+ Unchecked state update function for iFF, on an integer state array.
+ */
+void iff_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[2] += 1;
+		break;
+
+	case 5:
+		X[2] -= 1;
+		break;
+
+	case 6:
+		X[2] -= 1;
+		break;
+
+	case 7:
+		X[3] += 1;
+		break;
+
+	case 8:
+		X[3] -= 1;
+		break;
+	}
+}
+
+
 /**
  Sample a new random initial state for iFF.
  */
@@ -189,6 +815,29 @@ int iff_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for iFF, as an integer vector.
+ */
+int iff_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != N)
+	{
+		fprintf (stderr, "error in iff_initial_conditions_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample a new initial state
+	gsl_vector_int_set (X0, 0, 0);
+	gsl_vector_int_set (X0, 1, 0);
+	gsl_vector_int_set (X0, 2, 0);
+	gsl_vector_int_set (X0, 3, 0);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for iFF.
  */
@@ -211,13 +860,110 @@ int iff_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for iFF.
+ */
+int iff_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != P) || (out->size2 != N))
+	{
+		fprintf (stderr, "error in iff_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	gsl_matrix_int_set (out, 0, 2, 1);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of iFF in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t iff_stoich_ptr[R+1] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9
+};
+static const size_t iff_stoich_idx[9] = {
+	0,
+	0,
+	1,
+	1,
+	2,
+	2,
+	2,
+	3,
+	3
+};
+static const int iff_stoich_val[9] = {
+	1,
+	-1,
+	1,
+	-1,
+	1,
+	-1,
+	-1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of iFF in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t iff_react_ptr[R+1] = {
+	0, 0, 1, 2, 3, 4, 6, 7, 8, 9
+};
+static const size_t iff_react_idx[9] = {
+	0,
+	0,
+	1,
+	0,
+	1, 2,
+	2,
+	2,
+	3
+};
+static const int iff_react_val[9] = {
+	1,
+	1,
+	1,
+	1,
+	1, 1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for iFF.
  */
 void iff_mod_setup (stochmod * model)
 {
 	model->propensity = &iff_propensity_eval;
+	model->propensity_update = &iff_propensity_update;
+	model->jacobian = &iff_propensity_jacobian;
+	model->hessian = &iff_propensity_hessian;
+	model->rate_raw = &iff_propensity_raw;
+	model->rate_jacobian = &iff_propensity_jacobian;
 	model->update = &iff_state_update;
+	model->propensity_raw = &iff_propensity_raw;
+	model->propensity_update_raw = &iff_propensity_update_raw;
+	model->update_raw = &iff_state_update_raw;
+	model->propensity_lanes = &iff_propensity_lanes;
+	model->propensity_int = &iff_propensity_int;
+	model->propensity_update_int = &iff_propensity_update_int;
+	model->update_int = &iff_state_update_int;
+	model->initial_int = &iff_initial_conditions_int;
+	model->output_int = &iff_output_int;
 	model->initial = &iff_initial_conditions;
 	model->output = &iff_output;
 	model->nspecies = N;
@@ -226,4 +972,11 @@ void iff_mod_setup (stochmod * model)
 	model->nin = Z;
 	model->nout = P;
 	model->name = "Incoherent feed-forward loop (iFF)";
+	model->stoich_ptr = iff_stoich_ptr;
+	model->stoich_idx = iff_stoich_idx;
+	model->stoich_val = iff_stoich_val;
+	model->react_ptr = iff_react_ptr;
+	model->react_idx = iff_react_idx;
+	model->react_val = iff_react_val;
+	model->graph = NULL;
 }
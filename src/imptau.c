@@ -0,0 +1,290 @@
+/*
+ *  imptau.c
+ *  StochMod
+ *
+ *	Implicit tau-leaping simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+
+/**
+ Allocate a workspace for the implicit tau-leaping engine that fits the given
+ model. The model must export its stoichiometry and its propensity Jacobian.
+ */
+sm_imptau_workspace * sm_imptau_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->jacobian == NULL))
+	{
+		fprintf (stderr, "error in sm_imptau_workspace_alloc: model does not export its stoichiometry and Jacobian\n");
+		return NULL;
+	}
+
+	sm_imptau_workspace * w = malloc (sizeof (sm_imptau_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_imptau_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	w->nspecies = N;
+	w->nrxns = R;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (N);
+	w->Y = gsl_vector_alloc (N);
+	w->c = gsl_vector_alloc (N);
+	w->F = gsl_vector_alloc (N);
+	w->dY = gsl_vector_alloc (N);
+	w->prop = gsl_vector_alloc (R);
+	w->propY = gsl_vector_alloc (R);
+	w->P = gsl_vector_alloc (R);
+	w->S = gsl_matrix_alloc (N, R);
+	w->Ja = gsl_matrix_alloc (R, N);
+	w->Jf = gsl_matrix_alloc (N, N);
+	w->perm = gsl_permutation_alloc (N);
+
+	if ((w->X == NULL) || (w->Y == NULL) || (w->c == NULL) || (w->F == NULL) || (w->dY == NULL)
+			|| (w->prop == NULL) || (w->propY == NULL) || (w->P == NULL) || (w->S == NULL)
+			|| (w->Ja == NULL) || (w->Jf == NULL) || (w->perm == NULL))
+	{
+		fprintf (stderr, "error in sm_imptau_workspace_alloc: failed to allocate workspace members\n");
+		sm_imptau_workspace_free (w);
+		return NULL;
+	}
+	sm_stoich_matrix (model, w->S);
+
+	// Default tuning
+	w->tau = 0.1;
+	w->tol = 1e-8;
+	w->maxiter = 20;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_imptau_workspace_alloc.
+ */
+void sm_imptau_workspace_free (sm_imptau_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->Y != NULL)
+		gsl_vector_free (w->Y);
+	if (w->c != NULL)
+		gsl_vector_free (w->c);
+	if (w->F != NULL)
+		gsl_vector_free (w->F);
+	if (w->dY != NULL)
+		gsl_vector_free (w->dY);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->propY != NULL)
+		gsl_vector_free (w->propY);
+	if (w->P != NULL)
+		gsl_vector_free (w->P);
+	if (w->S != NULL)
+		gsl_matrix_free (w->S);
+	if (w->Ja != NULL)
+		gsl_matrix_free (w->Ja);
+	if (w->Jf != NULL)
+		gsl_matrix_free (w->Jf);
+	if (w->perm != NULL)
+		gsl_permutation_free (w->perm);
+	free (w);
+}
+
+
+/**
+ Solve the implicit leap equation
+ 	 Y = c + tau * S * a(Y),   with c = X + S * (P - tau * a(X))
+ with Newton's method, starting from the explicit leap Y = X + S * P.
+ Returns GSL_EMAXITER if the iteration has not converged after w->maxiter
+ steps.
+ */
+static int imptau_newton (const stochmod * model, const gsl_vector * params, sm_imptau_workspace * w, double tau)
+{
+	size_t N = w->nspecies;
+
+	// Right hand side c and initial guess
+	gsl_vector_memcpy (w->Y, w->X);
+	gsl_blas_dgemv (CblasNoTrans, 1.0, w->S, w->P, 1.0, w->Y);
+	gsl_vector_memcpy (w->c, w->Y);
+	gsl_blas_dgemv (CblasNoTrans, -tau, w->S, w->prop, 1.0, w->c);
+
+	for (unsigned int iter = 0; iter < w->maxiter; iter++)
+	{
+		// Residual F = Y - c - tau * S * a(Y)
+		if (model->propensity (w->Y, params, w->propY) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		gsl_vector_memcpy (w->F, w->Y);
+		gsl_vector_sub (w->F, w->c);
+		gsl_blas_dgemv (CblasNoTrans, -tau, w->S, w->propY, 1.0, w->F);
+
+		// Jacobian of the residual I - tau * S * da/dY
+		if (model->jacobian (w->Y, params, w->Ja) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		gsl_matrix_set_identity (w->Jf);
+		gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -tau, w->S, w->Ja, 1.0, w->Jf);
+
+		// Newton step
+		int signum;
+		gsl_linalg_LU_decomp (w->Jf, w->perm, &signum);
+		if (gsl_linalg_LU_solve (w->Jf, w->perm, w->F, w->dY) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		gsl_vector_sub (w->Y, w->dY);
+
+		double err = 0.0;
+		for (size_t i = 0; i < N; i++)
+			err = GSL_MAX (err, fabs (gsl_vector_get (w->dY, i)) / (1.0 + fabs (gsl_vector_get (w->Y, i))));
+		if (err < w->tol)
+		{
+			// Propensities at the solution
+			return model->propensity (w->Y, params, w->propY);
+		}
+	}
+
+	return GSL_EMAXITER;
+}
+
+
+/**
+ Simulate one trajectory of the model with the implicit tau-leaping method of
+ Rathinam, Petzold, Cao and Gillespie (J. Chem. Phys. 119, 2003).
+
+ Arguments and output are the same as in sm_ssa_direct_run. Each step of
+ length w->tau (shortened to land on the points of tgrid) draws the Poisson
+ numbers of firings P(j) with mean tau * a(j)(X), solves the implicit equation
+ above for the new state with the propensity Jacobian of the model, and fires
+ each reaction round(P(j) - tau * a(j)(X) + tau * a(j)(Y)) times. The implicit
+ step damps the fast reversible reactions (e.g. repressor binding) towards
+ their equilibrium, so that tau can be chosen on the time scale of the slow
+ species. Steps whose implicit equation does not converge, or that would make
+ a population negative, are retried with half the length.
+ */
+int sm_imptau_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_imptau_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_imptau_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_imptau_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_imptau_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (w->tau <= 0.0)
+	{
+		fprintf (stderr, "error in sm_imptau_run: step size must be positive\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	gsl_vector_memcpy (w->X, X0);
+
+	while (k < ntimes)
+	{
+		// Record the time points that have been reached
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) <= t))
+		{
+			gsl_matrix_set_row (states, k, w->X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		if (model->propensity (w->X, params, w->prop) != GSL_SUCCESS)
+			return GSL_EFAILED;
+
+		double horizon = gsl_vector_get (tgrid, k) - t;
+		double tau = GSL_MIN (w->tau, horizon);
+		for (;;)
+		{
+			// Poisson numbers of firings at the current state
+			for (size_t j = 0; j < R; j++)
+			{
+				double aj = gsl_vector_get (w->prop, j);
+				gsl_vector_set (w->P, j, (aj > 0.0) ? sm_rngbuf_poisson (&w->rb, aj * tau) : 0.0);
+			}
+
+			int status = imptau_newton (model, params, w, tau);
+			if (status == GSL_EMAXITER)
+			{
+				// No solution within w->maxiter iterations: retry with a shorter step
+				tau /= 2.0;
+				if (tau < horizon * GSL_DBL_EPSILON)
+				{
+					fprintf (stderr, "error in sm_imptau_run: implicit equation did not converge at t = %g\n", t);
+					return GSL_EFAILED;
+				}
+				continue;
+			}
+			if (status != GSL_SUCCESS)
+				return GSL_EFAILED;
+
+			// Integer numbers of firings from the implicit solution
+			for (size_t j = 0; j < R; j++)
+			{
+				double kj = gsl_vector_get (w->P, j)
+						+ tau * (gsl_vector_get (w->propY, j) - gsl_vector_get (w->prop, j));
+				gsl_vector_set (w->P, j, (kj > 0.0) ? floor (kj + 0.5) : 0.0);
+			}
+			gsl_vector_memcpy (w->Y, w->X);
+			gsl_blas_dgemv (CblasNoTrans, 1.0, w->S, w->P, 1.0, w->Y);
+
+			int negative = 0;
+			for (size_t i = 0; i < N; i++)
+				negative |= (gsl_vector_get (w->Y, i) < 0.0);
+			if (!negative)
+				break;
+			tau /= 2.0;
+		}
+
+		gsl_vector_memcpy (w->X, w->Y);
+		t = (tau == horizon) ? gsl_vector_get (tgrid, k) : t + tau;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -94,6 +94,377 @@ int lacgfp10_propensity_eval (const gsl_vector * X, const gsl_vector * params, g
 }
 
 
+/**
+ Incremental propensity update function for Lacgfp10.
+ */
+int lacgfp10_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != N) || (params->size != L+Z) || (prop->size != R))
+	{
+		fprintf (stderr, "error in lacgfp10_propensity_update: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - propensities: %d\n", (int) X->size, (int) params->size, (int) prop->size);
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= R)
+	{
+		fprintf (stderr, "error in lacgfp10_propensity_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, (k2)*X2);
+		gsl_vector_set (prop, 2, (k3)*X2);
+		break;
+	}
+
+	case 1:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, (k2)*X2);
+		gsl_vector_set (prop, 2, (k3)*X2);
+		break;
+	}
+
+	case 2:
+	{
+		double X3 = gsl_vector_get (X, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		gsl_vector_set (prop, 3, (k4)*X3);
+		gsl_vector_set (prop, 4, (k5)*X3);
+		break;
+	}
+
+	case 3:
+	{
+		double X3 = gsl_vector_get (X, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		gsl_vector_set (prop, 3, (k4)*X3);
+		gsl_vector_set (prop, 4, (k5)*X3);
+		break;
+	}
+
+	case 4:
+	{
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		gsl_vector_set (prop, 3, (k4)*X3);
+		gsl_vector_set (prop, 4, (k5)*X3);
+		gsl_vector_set (prop, 5, (k4)*X4);
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double k4 = gsl_vector_get (params, 3);
+		gsl_vector_set (prop, 5, (k4)*X4);
+		break;
+	}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for Lacgfp10: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int lacgfp10_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in lacgfp10_propensity_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 0, 0, (k1));
+	gsl_matrix_set (J, 1, 1, (k2));
+	gsl_matrix_set (J, 2, 1, (k3));
+	gsl_matrix_set (J, 3, 2, (k4));
+	gsl_matrix_set (J, 4, 2, (k5));
+	gsl_matrix_set (J, 5, 3, (k4));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Lacgfp10: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int lacgfp10_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (H->size1 != R) || (H->size2 != N*N))
+	{
+		fprintf (stderr, "error in lacgfp10_propensity_hessian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - hessian: %d x %d\n", (int) X->size, (int) params->size, (int) H->size1, (int) H->size2);
+		return GSL_EFAILED;
+	}
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp10, on contiguous arrays.
+ */
+void lacgfp10_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+
+	// Compute the propensities
+	prop[0] = (k1)*X1;
+	prop[1] = (k2)*X2;
+	prop[2] = (k3)*X2;
+	prop[3] = (k4)*X3;
+	prop[4] = (k5)*X3;
+	prop[5] = (k4)*X4;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp10, on contiguous arrays.
+ */
+void lacgfp10_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X2 = X[1];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X2;
+		break;
+	}
+
+	case 1:
+	{
+		double X2 = X[1];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X2;
+		break;
+	}
+
+	case 2:
+	{
+		double X3 = X[2];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		break;
+	}
+
+	case 3:
+	{
+		double X3 = X[2];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		break;
+	}
+
+	case 4:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		prop[5] = (k4)*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = X[3];
+		double k4 = params[3];
+		prop[5] = (k4)*X4;
+		break;
+	}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp10, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void lacgfp10_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = (k1)*X1;
+		prop[SM_LOCK_LANES+l] = (k2)*X2;
+		prop[2*SM_LOCK_LANES+l] = (k3)*X2;
+		prop[3*SM_LOCK_LANES+l] = (k4)*X3;
+		prop[4*SM_LOCK_LANES+l] = (k5)*X3;
+		prop[5*SM_LOCK_LANES+l] = (k4)*X4;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp10, on an integer state array.
+ */
+void lacgfp10_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+
+	// Compute the propensities
+	prop[0] = (k1)*X1;
+	prop[1] = (k2)*X2;
+	prop[2] = (k3)*X2;
+	prop[3] = (k4)*X3;
+	prop[4] = (k5)*X3;
+	prop[5] = (k4)*X4;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp10, on an integer state array.
+ */
+void lacgfp10_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X2 = X[1];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X2;
+		break;
+	}
+
+	case 1:
+	{
+		double X2 = X[1];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X2;
+		break;
+	}
+
+	case 2:
+	{
+		double X3 = X[2];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		break;
+	}
+
+	case 3:
+	{
+		double X3 = X[2];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		break;
+	}
+
+	case 4:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		prop[3] = (k4)*X3;
+		prop[4] = (k5)*X3;
+		prop[5] = (k4)*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = X[3];
+		double k4 = params[3];
+		prop[5] = (k4)*X4;
+		break;
+	}
+	}
+}
+
+
 /**
  State update function for Lacgfp10.
  */
@@ -148,6 +519,78 @@ int lacgfp10_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for Lacgfp10, on a contiguous array.
+ */
+void lacgfp10_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[1] += 1;
+		break;
+
+	case 1:
+		X[1] -= 1;
+		break;
+
+	case 2:
+		X[2] += 1;
+		break;
+
+	case 3:
+		X[2] -= 1;
+		break;
+
+	case 4:
+		X[2] -= 1;
+		X[3] += 1;
+		break;
+
+	case 5:
+		X[3] -= 1;
+		break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Lacgfp10, on an integer state array.
+ */
+void lacgfp10_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[1] += 1;
+		break;
+
+	case 1:
+		X[1] -= 1;
+		break;
+
+	case 2:
+		X[2] += 1;
+		break;
+
+	case 3:
+		X[2] -= 1;
+		break;
+
+	case 4:
+		X[2] -= 1;
+		X[3] += 1;
+		break;
+
+	case 5:
+		X[3] -= 1;
+		break;
+	}
+}
+
+
 /**
  Sample a new random initial state for Lacgfp10.
  */
@@ -171,6 +614,29 @@ int lacgfp10_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for Lacgfp10, as an integer vector.
+ */
+int lacgfp10_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != N)
+	{
+		fprintf (stderr, "error in lacgfp10_initial_conditions_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample a new initial state
+	gsl_vector_int_set (X0, 0, 1 + gsl_rng_uniform_int (r, 101) + gsl_rng_uniform_int (r, 101));
+	gsl_vector_int_set (X0, 1, 0);
+	gsl_vector_int_set (X0, 2, 0);
+	gsl_vector_int_set (X0, 3, 0);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for Lacgfp10.
  */
@@ -193,13 +659,100 @@ int lacgfp10_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for Lacgfp10.
+ */
+int lacgfp10_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != P) || (out->size2 != N))
+	{
+		fprintf (stderr, "error in lacgfp10_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	gsl_matrix_int_set (out, 0, 3, 1);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of Lacgfp10 in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t lacgfp10_stoich_ptr[R+1] = {
+	0, 1, 2, 3, 4, 6, 7
+};
+static const size_t lacgfp10_stoich_idx[7] = {
+	1,
+	1,
+	2,
+	2,
+	2, 3,
+	3
+};
+static const int lacgfp10_stoich_val[7] = {
+	1,
+	-1,
+	1,
+	-1,
+	-1, 1,
+	-1
+};
+
+
+/**
+ Reactants of Lacgfp10 in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t lacgfp10_react_ptr[R+1] = {
+	0, 1, 2, 3, 4, 5, 6
+};
+static const size_t lacgfp10_react_idx[6] = {
+	0,
+	1,
+	1,
+	2,
+	2,
+	3
+};
+static const int lacgfp10_react_val[6] = {
+	1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Lacgfp10.
  */
 void lacgfp10_mod_setup (stochmod * model)
 {
 	model->propensity = &lacgfp10_propensity_eval;
+	model->propensity_update = &lacgfp10_propensity_update;
+	model->jacobian = &lacgfp10_propensity_jacobian;
+	model->hessian = &lacgfp10_propensity_hessian;
+	model->rate_raw = &lacgfp10_propensity_raw;
+	model->rate_jacobian = &lacgfp10_propensity_jacobian;
 	model->update = &lacgfp10_state_update;
+	model->propensity_raw = &lacgfp10_propensity_raw;
+	model->propensity_update_raw = &lacgfp10_propensity_update_raw;
+	model->update_raw = &lacgfp10_state_update_raw;
+	model->propensity_lanes = &lacgfp10_propensity_lanes;
+	model->propensity_int = &lacgfp10_propensity_int;
+	model->propensity_update_int = &lacgfp10_propensity_update_int;
+	model->update_int = &lacgfp10_state_update_int;
+	model->initial_int = &lacgfp10_initial_conditions_int;
+	model->output_int = &lacgfp10_output_int;
 	model->initial = &lacgfp10_initial_conditions;
 	model->output = &lacgfp10_output;
 	model->nspecies = N;
@@ -208,4 +761,11 @@ void lacgfp10_mod_setup (stochmod * model)
 	model->nin = Z;
 	model->nout = P;
 	model->name = "Lac-GFP construct model v10 (LACGFP10)";
+	model->stoich_ptr = lacgfp10_stoich_ptr;
+	model->stoich_idx = lacgfp10_stoich_idx;
+	model->stoich_val = lacgfp10_stoich_val;
+	model->react_ptr = lacgfp10_react_ptr;
+	model->react_idx = lacgfp10_react_idx;
+	model->react_val = lacgfp10_react_val;
+	model->graph = NULL;
 }
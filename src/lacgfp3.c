@@ -135,6 +135,1380 @@ int lacgfp3_propensity_eval (const gsl_vector * X, const gsl_vector * params, gs
 }
 
 
+/**
+ Incremental propensity update function for Lacgfp2.
+ */
+int lacgfp3_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != 9) || (params->size != 15) || (prop->size != 20))
+	{
+		fprintf (stderr, "error in lacgfp3_propensity_update: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - propensities: %d\n", (int) X->size, (int) params->size, (int) prop->size);
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= 20)
+	{
+		fprintf (stderr, "error in lacgfp3_propensity_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, k2*X1);
+		gsl_vector_set (prop, 2, k3*X1);
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, k2*X1);
+		gsl_vector_set (prop, 2, k3*X1);
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 8, k7/k8*X4);
+		gsl_vector_set (prop, 12, k9*X3);
+		gsl_vector_set (prop, 13, k10*X4);
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 8, k7/k8*X4);
+		gsl_vector_set (prop, 9, k7/(k14*k8)*X5);
+		gsl_vector_set (prop, 13, k10*X4);
+		gsl_vector_set (prop, 14, k10*X5);
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 9, k7/(k14*k8)*X5);
+		gsl_vector_set (prop, 10, k7/(k14*k14*k8)*X6);
+		gsl_vector_set (prop, 14, k10*X5);
+		gsl_vector_set (prop, 15, k10*X6);
+		break;
+	}
+
+	case 7:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double X7 = gsl_vector_get (X, 6);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 10, k7/(k14*k14*k8)*X6);
+		gsl_vector_set (prop, 11, k7/(k14*k14*k14*k8)*X7);
+		gsl_vector_set (prop, 15, k10*X6);
+		gsl_vector_set (prop, 16, k10*X7);
+		break;
+	}
+
+	case 8:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 8, k7/k8*X4);
+		gsl_vector_set (prop, 12, k9*X3);
+		gsl_vector_set (prop, 13, k10*X4);
+		break;
+	}
+
+	case 9:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 8, k7/k8*X4);
+		gsl_vector_set (prop, 9, k7/(k14*k8)*X5);
+		gsl_vector_set (prop, 13, k10*X4);
+		gsl_vector_set (prop, 14, k10*X5);
+		break;
+	}
+
+	case 10:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 9, k7/(k14*k8)*X5);
+		gsl_vector_set (prop, 10, k7/(k14*k14*k8)*X6);
+		gsl_vector_set (prop, 14, k10*X5);
+		gsl_vector_set (prop, 15, k10*X6);
+		break;
+	}
+
+	case 11:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double X7 = gsl_vector_get (X, 6);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k10 = gsl_vector_get (params, 9);
+		double k14 = gsl_vector_get (params, 13);
+		double u = gsl_vector_get (params, 14);
+		gsl_vector_set (prop, 3, (k4+k5*u)*X2);
+		gsl_vector_set (prop, 4, k6*X2*X3);
+		gsl_vector_set (prop, 5, k6*X2*X4);
+		gsl_vector_set (prop, 6, k6*X2*X5);
+		gsl_vector_set (prop, 7, k6*X2*X6);
+		gsl_vector_set (prop, 10, k7/(k14*k14*k8)*X6);
+		gsl_vector_set (prop, 11, k7/(k14*k14*k14*k8)*X7);
+		gsl_vector_set (prop, 15, k10*X6);
+		gsl_vector_set (prop, 16, k10*X7);
+		break;
+	}
+
+	case 12:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 13:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 16:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 17:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 17, k11*X8);
+		gsl_vector_set (prop, 18, k12*X8);
+		break;
+	}
+
+	case 18:
+	{
+		double X9 = gsl_vector_get (X, 8);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 19, k13*X9);
+		break;
+	}
+
+	case 19:
+	{
+		double X9 = gsl_vector_get (X, 8);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 19, k13*X9);
+		break;
+	}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for Lacgfp2: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int lacgfp3_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 9) || (params->size != 15) || (J->size1 != 20) || (J->size2 != 9))
+	{
+		fprintf (stderr, "error in lacgfp3_propensity_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X2 = gsl_vector_get (X, 1);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+	double X6 = gsl_vector_get (X, 5);
+
+	// Get the parameters
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double k14 = gsl_vector_get (params, 13);
+	double u = gsl_vector_get (params, 14);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, k2);
+	gsl_matrix_set (J, 2, 0, k3);
+	gsl_matrix_set (J, 3, 1, (k4+k5*u));
+	gsl_matrix_set (J, 4, 1, k6*X3);
+	gsl_matrix_set (J, 4, 2, k6*X2);
+	gsl_matrix_set (J, 5, 1, k6*X4);
+	gsl_matrix_set (J, 5, 3, k6*X2);
+	gsl_matrix_set (J, 6, 1, k6*X5);
+	gsl_matrix_set (J, 6, 4, k6*X2);
+	gsl_matrix_set (J, 7, 1, k6*X6);
+	gsl_matrix_set (J, 7, 5, k6*X2);
+	gsl_matrix_set (J, 8, 3, k7/k8);
+	gsl_matrix_set (J, 9, 4, k7/(k14*k8));
+	gsl_matrix_set (J, 10, 5, k7/(k14*k14*k8));
+	gsl_matrix_set (J, 11, 6, k7/(k14*k14*k14*k8));
+	gsl_matrix_set (J, 12, 2, k9);
+	gsl_matrix_set (J, 13, 3, k10);
+	gsl_matrix_set (J, 14, 4, k10);
+	gsl_matrix_set (J, 15, 5, k10);
+	gsl_matrix_set (J, 16, 6, k10);
+	gsl_matrix_set (J, 17, 7, k11);
+	gsl_matrix_set (J, 18, 7, k12);
+	gsl_matrix_set (J, 19, 8, k13);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Lacgfp2: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int lacgfp3_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 9) || (params->size != 15) || (H->size1 != 20) || (H->size2 != 81))
+	{
+		fprintf (stderr, "error in lacgfp3_propensity_hessian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - hessian: %d x %d\n", (int) X->size, (int) params->size, (int) H->size1, (int) H->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k6 = gsl_vector_get (params, 5);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 4, 11, k6);
+	gsl_matrix_set (H, 4, 19, k6);
+	gsl_matrix_set (H, 5, 12, k6);
+	gsl_matrix_set (H, 5, 28, k6);
+	gsl_matrix_set (H, 6, 13, k6);
+	gsl_matrix_set (H, 6, 37, k6);
+	gsl_matrix_set (H, 7, 14, k6);
+	gsl_matrix_set (H, 7, 46, k6);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp2, on contiguous arrays.
+ */
+void lacgfp3_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double X9 = X[8];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double u = params[14];
+
+	// Compute the propensities
+	prop[0] = k1;
+	prop[1] = k2*X1;
+	prop[2] = k3*X1;
+	prop[3] = (k4+k5*u)*X2;
+	prop[4] = k6*X2*X3;
+	prop[5] = k6*X2*X4;
+	prop[6] = k6*X2*X5;
+	prop[7] = k6*X2*X6;
+	prop[8] = k7/k8*X4;
+	prop[9] = k7/(k14*k8)*X5;
+	prop[10] = k7/(k14*k14*k8)*X6;
+	prop[11] = k7/(k14*k14*k14*k8)*X7;
+	prop[12] = k9*X3;
+	prop[13] = k10*X4;
+	prop[14] = k10*X5;
+	prop[15] = k10*X6;
+	prop[16] = k10*X7;
+	prop[17] = k11*X8;
+	prop[18] = k12*X8;
+	prop[19] = k13*X9;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp2, on contiguous arrays.
+ */
+void lacgfp3_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = k2*X1;
+		prop[2] = k3*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = k2*X1;
+		prop[2] = k3*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[12] = k9*X3;
+		prop[13] = k10*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[13] = k10*X4;
+		prop[14] = k10*X5;
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[14] = k10*X5;
+		prop[15] = k10*X6;
+		break;
+	}
+
+	case 7:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X7 = X[6];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[11] = k7/(k14*k14*k14*k8)*X7;
+		prop[15] = k10*X6;
+		prop[16] = k10*X7;
+		break;
+	}
+
+	case 8:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[12] = k9*X3;
+		prop[13] = k10*X4;
+		break;
+	}
+
+	case 9:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[13] = k10*X4;
+		prop[14] = k10*X5;
+		break;
+	}
+
+	case 10:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[14] = k10*X5;
+		prop[15] = k10*X6;
+		break;
+	}
+
+	case 11:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X7 = X[6];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[11] = k7/(k14*k14*k14*k8)*X7;
+		prop[15] = k10*X6;
+		prop[16] = k10*X7;
+		break;
+	}
+
+	case 12:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 13:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 16:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 17:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 18:
+	{
+		double X9 = X[8];
+		double k13 = params[12];
+		prop[19] = k13*X9;
+		break;
+	}
+
+	case 19:
+	{
+		double X9 = X[8];
+		double k13 = params[12];
+		prop[19] = k13*X9;
+		break;
+	}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp2, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void lacgfp3_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double u = params[14];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+		double X5 = X[4*SM_LOCK_LANES+l];
+		double X6 = X[5*SM_LOCK_LANES+l];
+		double X7 = X[6*SM_LOCK_LANES+l];
+		double X8 = X[7*SM_LOCK_LANES+l];
+		double X9 = X[8*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = k1;
+		prop[SM_LOCK_LANES+l] = k2*X1;
+		prop[2*SM_LOCK_LANES+l] = k3*X1;
+		prop[3*SM_LOCK_LANES+l] = (k4+k5*u)*X2;
+		prop[4*SM_LOCK_LANES+l] = k6*X2*X3;
+		prop[5*SM_LOCK_LANES+l] = k6*X2*X4;
+		prop[6*SM_LOCK_LANES+l] = k6*X2*X5;
+		prop[7*SM_LOCK_LANES+l] = k6*X2*X6;
+		prop[8*SM_LOCK_LANES+l] = k7/k8*X4;
+		prop[9*SM_LOCK_LANES+l] = k7/(k14*k8)*X5;
+		prop[10*SM_LOCK_LANES+l] = k7/(k14*k14*k8)*X6;
+		prop[11*SM_LOCK_LANES+l] = k7/(k14*k14*k14*k8)*X7;
+		prop[12*SM_LOCK_LANES+l] = k9*X3;
+		prop[13*SM_LOCK_LANES+l] = k10*X4;
+		prop[14*SM_LOCK_LANES+l] = k10*X5;
+		prop[15*SM_LOCK_LANES+l] = k10*X6;
+		prop[16*SM_LOCK_LANES+l] = k10*X7;
+		prop[17*SM_LOCK_LANES+l] = k11*X8;
+		prop[18*SM_LOCK_LANES+l] = k12*X8;
+		prop[19*SM_LOCK_LANES+l] = k13*X9;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp2, on an integer state array.
+ */
+void lacgfp3_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double X9 = X[8];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double u = params[14];
+
+	// Compute the propensities
+	prop[0] = k1;
+	prop[1] = k2*X1;
+	prop[2] = k3*X1;
+	prop[3] = (k4+k5*u)*X2;
+	prop[4] = k6*X2*X3;
+	prop[5] = k6*X2*X4;
+	prop[6] = k6*X2*X5;
+	prop[7] = k6*X2*X6;
+	prop[8] = k7/k8*X4;
+	prop[9] = k7/(k14*k8)*X5;
+	prop[10] = k7/(k14*k14*k8)*X6;
+	prop[11] = k7/(k14*k14*k14*k8)*X7;
+	prop[12] = k9*X3;
+	prop[13] = k10*X4;
+	prop[14] = k10*X5;
+	prop[15] = k10*X6;
+	prop[16] = k10*X7;
+	prop[17] = k11*X8;
+	prop[18] = k12*X8;
+	prop[19] = k13*X9;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp2, on an integer state array.
+ */
+void lacgfp3_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = k2*X1;
+		prop[2] = k3*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = k2*X1;
+		prop[2] = k3*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[12] = k9*X3;
+		prop[13] = k10*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[13] = k10*X4;
+		prop[14] = k10*X5;
+		break;
+	}
+
+	case 6:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[14] = k10*X5;
+		prop[15] = k10*X6;
+		break;
+	}
+
+	case 7:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X7 = X[6];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[11] = k7/(k14*k14*k14*k8)*X7;
+		prop[15] = k10*X6;
+		prop[16] = k10*X7;
+		break;
+	}
+
+	case 8:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[12] = k9*X3;
+		prop[13] = k10*X4;
+		break;
+	}
+
+	case 9:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[8] = k7/k8*X4;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[13] = k10*X4;
+		prop[14] = k10*X5;
+		break;
+	}
+
+	case 10:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[9] = k7/(k14*k8)*X5;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[14] = k10*X5;
+		prop[15] = k10*X6;
+		break;
+	}
+
+	case 11:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X7 = X[6];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k10 = params[9];
+		double k14 = params[13];
+		double u = params[14];
+		prop[3] = (k4+k5*u)*X2;
+		prop[4] = k6*X2*X3;
+		prop[5] = k6*X2*X4;
+		prop[6] = k6*X2*X5;
+		prop[7] = k6*X2*X6;
+		prop[10] = k7/(k14*k14*k8)*X6;
+		prop[11] = k7/(k14*k14*k14*k8)*X7;
+		prop[15] = k10*X6;
+		prop[16] = k10*X7;
+		break;
+	}
+
+	case 12:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 13:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 16:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 17:
+	{
+		double X8 = X[7];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[17] = k11*X8;
+		prop[18] = k12*X8;
+		break;
+	}
+
+	case 18:
+	{
+		double X9 = X[8];
+		double k13 = params[12];
+		prop[19] = k13*X9;
+		break;
+	}
+
+	case 19:
+	{
+		double X9 = X[8];
+		double k13 = params[12];
+		prop[19] = k13*X9;
+		break;
+	}
+	}
+}
+
+
 /**
  State update function for Lacgfp2.
  */
@@ -259,6 +1633,220 @@ int lacgfp3_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for Lacgfp2, on a contiguous array.
+ */
+void lacgfp3_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[1] -= 1;
+		X[2] -= 1;
+		X[3] += 1;
+		break;
+
+	case 5:
+		X[1] -= 1;
+		X[3] -= 1;
+		X[4] += 1;
+		break;
+
+	case 6:
+		X[1] -= 1;
+		X[4] -= 1;
+		X[5] += 1;
+		break;
+
+	case 7:
+		X[1] -= 1;
+		X[5] -= 1;
+		X[6] += 1;
+		break;
+
+	case 8:
+		X[1] += 1;
+		X[2] += 1;
+		X[3] -= 1;
+		break;
+
+	case 9:
+		X[1] += 1;
+		X[3] += 1;
+		X[4] -= 1;
+		break;
+
+	case 10:
+		X[1] += 1;
+		X[4] += 1;
+		X[5] -= 1;
+		break;
+
+	case 11:
+		X[1] += 1;
+		X[5] += 1;
+		X[6] -= 1;
+		break;
+
+	case 12:
+		X[7] += 1;
+		break;
+
+	case 13:
+		X[7] += 1;
+		break;
+
+	case 14:
+		X[7] += 1;
+		break;
+
+	case 15:
+		X[7] += 1;
+		break;
+
+	case 16:
+		X[7] += 1;
+		break;
+
+	case 17:
+		X[7] -= 1;
+		break;
+
+	case 18:
+		X[8] += 1;
+		break;
+
+	case 19:
+		X[8] -= 1;
+		break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Lacgfp2, on an integer state array.
+ */
+void lacgfp3_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[1] -= 1;
+		X[2] -= 1;
+		X[3] += 1;
+		break;
+
+	case 5:
+		X[1] -= 1;
+		X[3] -= 1;
+		X[4] += 1;
+		break;
+
+	case 6:
+		X[1] -= 1;
+		X[4] -= 1;
+		X[5] += 1;
+		break;
+
+	case 7:
+		X[1] -= 1;
+		X[5] -= 1;
+		X[6] += 1;
+		break;
+
+	case 8:
+		X[1] += 1;
+		X[2] += 1;
+		X[3] -= 1;
+		break;
+
+	case 9:
+		X[1] += 1;
+		X[3] += 1;
+		X[4] -= 1;
+		break;
+
+	case 10:
+		X[1] += 1;
+		X[4] += 1;
+		X[5] -= 1;
+		break;
+
+	case 11:
+		X[1] += 1;
+		X[5] += 1;
+		X[6] -= 1;
+		break;
+
+	case 12:
+		X[7] += 1;
+		break;
+
+	case 13:
+		X[7] += 1;
+		break;
+
+	case 14:
+		X[7] += 1;
+		break;
+
+	case 15:
+		X[7] += 1;
+		break;
+
+	case 16:
+		X[7] += 1;
+		break;
+
+	case 17:
+		X[7] -= 1;
+		break;
+
+	case 18:
+		X[8] += 1;
+		break;
+
+	case 19:
+		X[8] -= 1;
+		break;
+	}
+}
+
+
 /**
  Sample a new random initial state for Lacgfp2.
  */
@@ -287,6 +1875,34 @@ int lacgfp3_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for Lacgfp2, as an integer vector.
+ */
+int lacgfp3_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != 9)
+	{
+		fprintf (stderr, "error in lacgfp3_initial_conditions_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample new initial state
+	gsl_vector_int_set (X0, 0, gsl_rng_uniform_int (r, 6));
+	gsl_vector_int_set (X0, 1, gsl_rng_uniform_int (r, 11));
+	gsl_vector_int_set (X0, 2, 1);
+	gsl_vector_int_set (X0, 3, 0);
+	gsl_vector_int_set (X0, 4, 0);
+	gsl_vector_int_set (X0, 5, 0);
+	gsl_vector_int_set (X0, 6, 0);
+	gsl_vector_int_set (X0, 7, 0);
+	gsl_vector_int_set (X0, 8, 0);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for Lacgfp2.
  */
@@ -309,13 +1925,154 @@ int lacgfp3_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for Lacgfp2.
+ */
+int lacgfp3_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != 1) || (out->size2 != 9))
+	{
+		fprintf (stderr, "error in lacgfp3_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	gsl_matrix_int_set (out, 0, 8, 1);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of Lacgfp2 in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t lacgfp3_stoich_ptr[21] = {
+	0, 1, 2, 3, 4, 7, 10, 13, 16, 19, 22, 25, 28, 29, 30, 31, 32, 33, 34, 35, 36
+};
+static const size_t lacgfp3_stoich_idx[36] = {
+	0,
+	0,
+	1,
+	1,
+	1, 2, 3,
+	1, 3, 4,
+	1, 4, 5,
+	1, 5, 6,
+	1, 2, 3,
+	1, 3, 4,
+	1, 4, 5,
+	1, 5, 6,
+	7,
+	7,
+	7,
+	7,
+	7,
+	7,
+	8,
+	8
+};
+static const int lacgfp3_stoich_val[36] = {
+	1,
+	-1,
+	1,
+	-1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	-1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of Lacgfp2 in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t lacgfp3_react_ptr[21] = {
+	0, 0, 1, 2, 3, 5, 7, 9, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23
+};
+static const size_t lacgfp3_react_idx[23] = {
+	0,
+	0,
+	1,
+	1, 2,
+	1, 3,
+	1, 4,
+	1, 5,
+	3,
+	4,
+	5,
+	6,
+	2,
+	3,
+	4,
+	5,
+	6,
+	7,
+	7,
+	8
+};
+static const int lacgfp3_react_val[23] = {
+	1,
+	1,
+	1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Lacgfp2.
  */
 void lacgfp3_mod_setup (stochmod * model)
 {
 	model->propensity = &lacgfp3_propensity_eval;
+	model->propensity_update = &lacgfp3_propensity_update;
+	model->jacobian = &lacgfp3_propensity_jacobian;
+	model->hessian = &lacgfp3_propensity_hessian;
+	model->rate_raw = &lacgfp3_propensity_raw;
+	model->rate_jacobian = &lacgfp3_propensity_jacobian;
 	model->update = &lacgfp3_state_update;
+	model->propensity_raw = &lacgfp3_propensity_raw;
+	model->propensity_update_raw = &lacgfp3_propensity_update_raw;
+	model->update_raw = &lacgfp3_state_update_raw;
+	model->propensity_lanes = &lacgfp3_propensity_lanes;
+	model->propensity_int = &lacgfp3_propensity_int;
+	model->propensity_update_int = &lacgfp3_propensity_update_int;
+	model->update_int = &lacgfp3_state_update_int;
+	model->initial_int = &lacgfp3_initial_conditions_int;
+	model->output_int = &lacgfp3_output_int;
 	model->initial = &lacgfp3_initial_conditions;
 	model->output = &lacgfp3_output;
 	model->nspecies = 9;
@@ -324,4 +2081,11 @@ void lacgfp3_mod_setup (stochmod * model)
 	model->nin = 1;
 	model->nout = 1;
 	model->name = "Lac-GFP construct model v3 (LACGFP3)";
+	model->stoich_ptr = lacgfp3_stoich_ptr;
+	model->stoich_idx = lacgfp3_stoich_idx;
+	model->stoich_val = lacgfp3_stoich_val;
+	model->react_ptr = lacgfp3_react_ptr;
+	model->react_idx = lacgfp3_react_idx;
+	model->react_val = lacgfp3_react_val;
+	model->graph = NULL;
 }
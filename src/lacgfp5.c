@@ -142,6 +142,1065 @@ int lacgfp5_propensity_eval (const gsl_vector * X, const gsl_vector * params, gs
 }
 
 
+/**
+ Incremental propensity update function for Lacgfp5.
+ */
+int lacgfp5_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != N) || (params->size != L+Z) || (prop->size != R))
+	{
+		fprintf (stderr, "error in lacgfp5_propensity_update: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - propensities: %d\n", (int) X->size, (int) params->size, (int) prop->size);
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= R)
+	{
+		fprintf (stderr, "error in lacgfp5_propensity_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, (k2)*X1);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		gsl_vector_set (prop, 1, (k2)*X1);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double u1 = gsl_vector_get (params, 17);
+		gsl_vector_set (prop, 3, (k4+k5*u1)*X2);
+		gsl_vector_set (prop, 4, (k6)*X2*(X2-1));
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double u1 = gsl_vector_get (params, 17);
+		gsl_vector_set (prop, 3, (k4+k5*u1)*X2);
+		gsl_vector_set (prop, 4, (k6)*X2*(X2-1));
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double u1 = gsl_vector_get (params, 17);
+		gsl_vector_set (prop, 3, (k4+k5*u1)*X2);
+		gsl_vector_set (prop, 4, (k6)*X2*(X2-1));
+		gsl_vector_set (prop, 5, (k7)*X3);
+		gsl_vector_set (prop, 6, (k8)*X3*X4);
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double k4 = gsl_vector_get (params, 3);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double u1 = gsl_vector_get (params, 17);
+		gsl_vector_set (prop, 3, (k4+k5*u1)*X2);
+		gsl_vector_set (prop, 4, (k6)*X2*(X2-1));
+		gsl_vector_set (prop, 5, (k7)*X3);
+		gsl_vector_set (prop, 6, (k8)*X3*X4);
+		break;
+	}
+
+	case 6:
+	{
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k12 = gsl_vector_get (params, 11);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 5, (k7)*X3);
+		gsl_vector_set (prop, 6, (k8)*X3*X4);
+		gsl_vector_set (prop, 7, (k9)*X5);
+		gsl_vector_set (prop, 8, (k10)*X5*(X5-1));
+		gsl_vector_set (prop, 10, (k12)*X4);
+		gsl_vector_set (prop, 11, (k13)*X5);
+		break;
+	}
+
+	case 7:
+	{
+		double X3 = gsl_vector_get (X, 2);
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k12 = gsl_vector_get (params, 11);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 5, (k7)*X3);
+		gsl_vector_set (prop, 6, (k8)*X3*X4);
+		gsl_vector_set (prop, 7, (k9)*X5);
+		gsl_vector_set (prop, 8, (k10)*X5*(X5-1));
+		gsl_vector_set (prop, 10, (k12)*X4);
+		gsl_vector_set (prop, 11, (k13)*X5);
+		break;
+	}
+
+	case 8:
+	{
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k11 = gsl_vector_get (params, 10);
+		double k13 = gsl_vector_get (params, 12);
+		double k14 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 7, (k9)*X5);
+		gsl_vector_set (prop, 8, (k10)*X5*(X5-1));
+		gsl_vector_set (prop, 9, (k11)*X6);
+		gsl_vector_set (prop, 11, (k13)*X5);
+		gsl_vector_set (prop, 12, (k14)*X6);
+		break;
+	}
+
+	case 9:
+	{
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k11 = gsl_vector_get (params, 10);
+		double k13 = gsl_vector_get (params, 12);
+		double k14 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 7, (k9)*X5);
+		gsl_vector_set (prop, 8, (k10)*X5*(X5-1));
+		gsl_vector_set (prop, 9, (k11)*X6);
+		gsl_vector_set (prop, 11, (k13)*X5);
+		gsl_vector_set (prop, 12, (k14)*X6);
+		break;
+	}
+
+	case 10:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k15 = gsl_vector_get (params, 14);
+		double k16 = gsl_vector_get (params, 15);
+		gsl_vector_set (prop, 13, (k15)*X7);
+		gsl_vector_set (prop, 14, (k16)*X7);
+		break;
+	}
+
+	case 11:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k15 = gsl_vector_get (params, 14);
+		double k16 = gsl_vector_get (params, 15);
+		gsl_vector_set (prop, 13, (k15)*X7);
+		gsl_vector_set (prop, 14, (k16)*X7);
+		break;
+	}
+
+	case 12:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k15 = gsl_vector_get (params, 14);
+		double k16 = gsl_vector_get (params, 15);
+		gsl_vector_set (prop, 13, (k15)*X7);
+		gsl_vector_set (prop, 14, (k16)*X7);
+		break;
+	}
+
+	case 13:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k15 = gsl_vector_get (params, 14);
+		double k16 = gsl_vector_get (params, 15);
+		gsl_vector_set (prop, 13, (k15)*X7);
+		gsl_vector_set (prop, 14, (k16)*X7);
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k17 = gsl_vector_get (params, 16);
+		gsl_vector_set (prop, 15, (k17)*X8);
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = gsl_vector_get (X, 7);
+		double k17 = gsl_vector_get (params, 16);
+		gsl_vector_set (prop, 15, (k17)*X8);
+		break;
+	}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for Lacgfp5: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int lacgfp5_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in lacgfp5_propensity_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X2 = gsl_vector_get (X, 1);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+
+	// Get the parameters
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double k14 = gsl_vector_get (params, 13);
+	double k15 = gsl_vector_get (params, 14);
+	double k16 = gsl_vector_get (params, 15);
+	double k17 = gsl_vector_get (params, 16);
+	double u1 = gsl_vector_get (params, 17);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, (k2));
+	gsl_matrix_set (J, 2, 0, (k3));
+	gsl_matrix_set (J, 3, 1, (k4+k5*u1));
+	gsl_matrix_set (J, 4, 1, (k6)*(X2-1)+(k6)*X2);
+	gsl_matrix_set (J, 5, 2, (k7));
+	gsl_matrix_set (J, 6, 2, (k8)*X4);
+	gsl_matrix_set (J, 6, 3, (k8)*X3);
+	gsl_matrix_set (J, 7, 4, (k9));
+	gsl_matrix_set (J, 8, 4, (k10)*(X5-1)+(k10)*X5);
+	gsl_matrix_set (J, 9, 5, (k11));
+	gsl_matrix_set (J, 10, 3, (k12));
+	gsl_matrix_set (J, 11, 4, (k13));
+	gsl_matrix_set (J, 12, 5, (k14));
+	gsl_matrix_set (J, 13, 6, (k15));
+	gsl_matrix_set (J, 14, 6, (k16));
+	gsl_matrix_set (J, 15, 7, (k17));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Lacgfp5: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int lacgfp5_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (H->size1 != R) || (H->size2 != N*N))
+	{
+		fprintf (stderr, "error in lacgfp5_propensity_hessian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - hessian: %d x %d\n", (int) X->size, (int) params->size, (int) H->size1, (int) H->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k6 = gsl_vector_get (params, 5);
+	double k8 = gsl_vector_get (params, 7);
+	double k10 = gsl_vector_get (params, 9);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 4, 9, 2*(k6));
+	gsl_matrix_set (H, 6, 19, (k8));
+	gsl_matrix_set (H, 6, 26, (k8));
+	gsl_matrix_set (H, 8, 36, 2*(k10));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Macroscopic rate Jacobian function for Lacgfp5: J(j,i) is the derivative of the
+ rate of reaction j (see lacgfp5_rate_raw) with respect to species i.
+ */
+int lacgfp5_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in lacgfp5_rate_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X2 = gsl_vector_get (X, 1);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+
+	// Get the parameters
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double k14 = gsl_vector_get (params, 13);
+	double k15 = gsl_vector_get (params, 14);
+	double k16 = gsl_vector_get (params, 15);
+	double k17 = gsl_vector_get (params, 16);
+	double u1 = gsl_vector_get (params, 17);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, (k2));
+	gsl_matrix_set (J, 2, 0, (k3));
+	gsl_matrix_set (J, 3, 1, (k4+k5*u1));
+	gsl_matrix_set (J, 4, 1, 2*(k6)*X2);
+	gsl_matrix_set (J, 5, 2, (k7));
+	gsl_matrix_set (J, 6, 2, (k8)*X4);
+	gsl_matrix_set (J, 6, 3, (k8)*X3);
+	gsl_matrix_set (J, 7, 4, (k9));
+	gsl_matrix_set (J, 8, 4, 2*(k10)*X5);
+	gsl_matrix_set (J, 9, 5, (k11));
+	gsl_matrix_set (J, 10, 3, (k12));
+	gsl_matrix_set (J, 11, 4, (k13));
+	gsl_matrix_set (J, 12, 5, (k14));
+	gsl_matrix_set (J, 13, 6, (k15));
+	gsl_matrix_set (J, 14, 6, (k16));
+	gsl_matrix_set (J, 15, 7, (k17));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked macroscopic rate function for Lacgfp5, on contiguous arrays: the
+ propensities, with X*X in place of X*(X-1) in the homodimerizations.
+ */
+void lacgfp5_rate_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double u1 = params[17];
+
+	// Compute the propensities
+	prop[0] = (k1);
+	prop[1] = (k2)*X1;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4+k5*u1)*X2;
+	prop[4] = (k6)*X2*X2;
+	prop[5] = (k7)*X3;
+	prop[6] = (k8)*X3*X4;
+	prop[7] = (k9)*X5;
+	prop[8] = (k10)*X5*X5;
+	prop[9] = (k11)*X6;
+	prop[10] = (k12)*X4;
+	prop[11] = (k13)*X5;
+	prop[12] = (k14)*X6;
+	prop[13] = (k15)*X7;
+	prop[14] = (k16)*X7;
+	prop[15] = (k17)*X8;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp5, on contiguous arrays.
+ */
+void lacgfp5_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double u1 = params[17];
+
+	// Compute the propensities
+	prop[0] = (k1);
+	prop[1] = (k2)*X1;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4+k5*u1)*X2;
+	prop[4] = (k6)*X2*(X2-1);
+	prop[5] = (k7)*X3;
+	prop[6] = (k8)*X3*X4;
+	prop[7] = (k9)*X5;
+	prop[8] = (k10)*X5*(X5-1);
+	prop[9] = (k11)*X6;
+	prop[10] = (k12)*X4;
+	prop[11] = (k13)*X5;
+	prop[12] = (k14)*X6;
+	prop[13] = (k15)*X7;
+	prop[14] = (k16)*X7;
+	prop[15] = (k17)*X8;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp5, on contiguous arrays.
+ */
+void lacgfp5_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		break;
+	}
+
+	case 6:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		double k13 = params[12];
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[10] = (k12)*X4;
+		prop[11] = (k13)*X5;
+		break;
+	}
+
+	case 7:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		double k13 = params[12];
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[10] = (k12)*X4;
+		prop[11] = (k13)*X5;
+		break;
+	}
+
+	case 8:
+	{
+		double X5 = X[4];
+		double X6 = X[5];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k11 = params[10];
+		double k13 = params[12];
+		double k14 = params[13];
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[9] = (k11)*X6;
+		prop[11] = (k13)*X5;
+		prop[12] = (k14)*X6;
+		break;
+	}
+
+	case 9:
+	{
+		double X5 = X[4];
+		double X6 = X[5];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k11 = params[10];
+		double k13 = params[12];
+		double k14 = params[13];
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[9] = (k11)*X6;
+		prop[11] = (k13)*X5;
+		prop[12] = (k14)*X6;
+		break;
+	}
+
+	case 10:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 11:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 12:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 13:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = X[7];
+		double k17 = params[16];
+		prop[15] = (k17)*X8;
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = X[7];
+		double k17 = params[16];
+		prop[15] = (k17)*X8;
+		break;
+	}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp5, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void lacgfp5_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double u1 = params[17];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+		double X5 = X[4*SM_LOCK_LANES+l];
+		double X6 = X[5*SM_LOCK_LANES+l];
+		double X7 = X[6*SM_LOCK_LANES+l];
+		double X8 = X[7*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = (k1);
+		prop[SM_LOCK_LANES+l] = (k2)*X1;
+		prop[2*SM_LOCK_LANES+l] = (k3)*X1;
+		prop[3*SM_LOCK_LANES+l] = (k4+k5*u1)*X2;
+		prop[4*SM_LOCK_LANES+l] = (k6)*X2*(X2-1);
+		prop[5*SM_LOCK_LANES+l] = (k7)*X3;
+		prop[6*SM_LOCK_LANES+l] = (k8)*X3*X4;
+		prop[7*SM_LOCK_LANES+l] = (k9)*X5;
+		prop[8*SM_LOCK_LANES+l] = (k10)*X5*(X5-1);
+		prop[9*SM_LOCK_LANES+l] = (k11)*X6;
+		prop[10*SM_LOCK_LANES+l] = (k12)*X4;
+		prop[11*SM_LOCK_LANES+l] = (k13)*X5;
+		prop[12*SM_LOCK_LANES+l] = (k14)*X6;
+		prop[13*SM_LOCK_LANES+l] = (k15)*X7;
+		prop[14*SM_LOCK_LANES+l] = (k16)*X7;
+		prop[15*SM_LOCK_LANES+l] = (k17)*X8;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Lacgfp5, on an integer state array.
+ */
+void lacgfp5_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double u1 = params[17];
+
+	// Compute the propensities
+	prop[0] = (k1);
+	prop[1] = (k2)*X1;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4+k5*u1)*X2;
+	prop[4] = (k6)*X2*(X2-1);
+	prop[5] = (k7)*X3;
+	prop[6] = (k8)*X3*X4;
+	prop[7] = (k9)*X5;
+	prop[8] = (k10)*X5*(X5-1);
+	prop[9] = (k11)*X6;
+	prop[10] = (k12)*X4;
+	prop[11] = (k13)*X5;
+	prop[12] = (k14)*X6;
+	prop[13] = (k15)*X7;
+	prop[14] = (k16)*X7;
+	prop[15] = (k17)*X8;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Lacgfp5, on an integer state array.
+ */
+void lacgfp5_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		prop[1] = (k2)*X1;
+		prop[2] = (k3)*X1;
+		break;
+	}
+
+	case 2:
+	{
+		double X2 = X[1];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		break;
+	}
+
+	case 3:
+	{
+		double X2 = X[1];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		break;
+	}
+
+	case 4:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		break;
+	}
+
+	case 5:
+	{
+		double X2 = X[1];
+		double X3 = X[2];
+		double X4 = X[3];
+		double k4 = params[3];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double u1 = params[17];
+		prop[3] = (k4+k5*u1)*X2;
+		prop[4] = (k6)*X2*(X2-1);
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		break;
+	}
+
+	case 6:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		double k13 = params[12];
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[10] = (k12)*X4;
+		prop[11] = (k13)*X5;
+		break;
+	}
+
+	case 7:
+	{
+		double X3 = X[2];
+		double X4 = X[3];
+		double X5 = X[4];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		double k13 = params[12];
+		prop[5] = (k7)*X3;
+		prop[6] = (k8)*X3*X4;
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[10] = (k12)*X4;
+		prop[11] = (k13)*X5;
+		break;
+	}
+
+	case 8:
+	{
+		double X5 = X[4];
+		double X6 = X[5];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k11 = params[10];
+		double k13 = params[12];
+		double k14 = params[13];
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[9] = (k11)*X6;
+		prop[11] = (k13)*X5;
+		prop[12] = (k14)*X6;
+		break;
+	}
+
+	case 9:
+	{
+		double X5 = X[4];
+		double X6 = X[5];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k11 = params[10];
+		double k13 = params[12];
+		double k14 = params[13];
+		prop[7] = (k9)*X5;
+		prop[8] = (k10)*X5*(X5-1);
+		prop[9] = (k11)*X6;
+		prop[11] = (k13)*X5;
+		prop[12] = (k14)*X6;
+		break;
+	}
+
+	case 10:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 11:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 12:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 13:
+	{
+		double X7 = X[6];
+		double k15 = params[14];
+		double k16 = params[15];
+		prop[13] = (k15)*X7;
+		prop[14] = (k16)*X7;
+		break;
+	}
+
+	case 14:
+	{
+		double X8 = X[7];
+		double k17 = params[16];
+		prop[15] = (k17)*X8;
+		break;
+	}
+
+	case 15:
+	{
+		double X8 = X[7];
+		double k17 = params[16];
+		prop[15] = (k17)*X8;
+		break;
+	}
+	}
+}
+
+
 /**
  State update function for Lacgfp5.
  */
@@ -242,6 +1301,172 @@ int lacgfp5_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for Lacgfp5, on a contiguous array.
+ */
+void lacgfp5_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[1] -= 2;
+		X[2] += 1;
+		break;
+
+	case 5:
+		X[1] += 2;
+		X[2] -= 1;
+		break;
+
+	case 6:
+		X[2] -= 1;
+		X[3] -= 1;
+		X[4] += 1;
+		break;
+
+	case 7:
+		X[2] += 1;
+		X[3] += 1;
+		X[4] -= 1;
+		break;
+
+	case 8:
+		X[4] -= 2;
+		X[5] += 1;
+		break;
+
+	case 9:
+		X[4] += 2;
+		X[5] -= 1;
+		break;
+
+	case 10:
+		X[6] += 1;
+		break;
+
+	case 11:
+		X[6] += 1;
+		break;
+
+	case 12:
+		X[6] += 1;
+		break;
+
+	case 13:
+		X[6] -= 1;
+		break;
+
+	case 14:
+		X[7] += 1;
+		break;
+
+	case 15:
+		X[7] -= 1;
+		break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Lacgfp5, on an integer state array.
+ */
+void lacgfp5_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] += 1;
+		break;
+
+	case 1:
+		X[0] -= 1;
+		break;
+
+	case 2:
+		X[1] += 1;
+		break;
+
+	case 3:
+		X[1] -= 1;
+		break;
+
+	case 4:
+		X[1] -= 2;
+		X[2] += 1;
+		break;
+
+	case 5:
+		X[1] += 2;
+		X[2] -= 1;
+		break;
+
+	case 6:
+		X[2] -= 1;
+		X[3] -= 1;
+		X[4] += 1;
+		break;
+
+	case 7:
+		X[2] += 1;
+		X[3] += 1;
+		X[4] -= 1;
+		break;
+
+	case 8:
+		X[4] -= 2;
+		X[5] += 1;
+		break;
+
+	case 9:
+		X[4] += 2;
+		X[5] -= 1;
+		break;
+
+	case 10:
+		X[6] += 1;
+		break;
+
+	case 11:
+		X[6] += 1;
+		break;
+
+	case 12:
+		X[6] += 1;
+		break;
+
+	case 13:
+		X[6] -= 1;
+		break;
+
+	case 14:
+		X[7] += 1;
+		break;
+
+	case 15:
+		X[7] -= 1;
+		break;
+	}
+}
+
+
 /**
  Sample a new random initial state for Lacgfp5.
  */
@@ -269,6 +1494,33 @@ int lacgfp5_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for Lacgfp5, as an integer vector.
+ */
+int lacgfp5_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != N)
+	{
+		fprintf (stderr, "error in lacgfp5_initial_conditions_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample a new initial state
+	gsl_vector_int_set (X0, 0, gsl_rng_uniform_int (r, 6));
+	gsl_vector_int_set (X0, 1, gsl_rng_uniform_int (r, 11));
+	gsl_vector_int_set (X0, 2, 0);
+	gsl_vector_int_set (X0, 3, 0);
+	gsl_vector_int_set (X0, 4, 0);
+	gsl_vector_int_set (X0, 5, 50 + gsl_rng_uniform_int (r, 21));
+	gsl_vector_int_set (X0, 6, 0);
+	gsl_vector_int_set (X0, 7, 0);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for Lacgfp5.
  */
@@ -291,13 +1543,138 @@ int lacgfp5_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for Lacgfp5.
+ */
+int lacgfp5_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != P) || (out->size2 != N))
+	{
+		fprintf (stderr, "error in lacgfp5_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	gsl_matrix_int_set (out, 0, 7, 1);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of Lacgfp5 in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t lacgfp5_stoich_ptr[R+1] = {
+	0, 1, 2, 3, 4, 6, 8, 11, 14, 16, 18, 19, 20, 21, 22, 23, 24
+};
+static const size_t lacgfp5_stoich_idx[24] = {
+	0,
+	0,
+	1,
+	1,
+	1, 2,
+	1, 2,
+	2, 3, 4,
+	2, 3, 4,
+	4, 5,
+	4, 5,
+	6,
+	6,
+	6,
+	6,
+	7,
+	7
+};
+static const int lacgfp5_stoich_val[24] = {
+	1,
+	-1,
+	1,
+	-1,
+	-2, 1,
+	2, -1,
+	-1, -1, 1,
+	1, 1, -1,
+	-2, 1,
+	2, -1,
+	1,
+	1,
+	1,
+	-1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of Lacgfp5 in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t lacgfp5_react_ptr[R+1] = {
+	0, 0, 1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+};
+static const size_t lacgfp5_react_idx[16] = {
+	0,
+	0,
+	1,
+	1,
+	2,
+	2, 3,
+	4,
+	4,
+	5,
+	3,
+	4,
+	5,
+	6,
+	6,
+	7
+};
+static const int lacgfp5_react_val[16] = {
+	1,
+	1,
+	1,
+	2,
+	1,
+	1, 1,
+	1,
+	2,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Lacgfp5.
  */
 void lacgfp5_mod_setup (stochmod * model)
 {
 	model->propensity = &lacgfp5_propensity_eval;
+	model->propensity_update = &lacgfp5_propensity_update;
+	model->jacobian = &lacgfp5_propensity_jacobian;
+	model->hessian = &lacgfp5_propensity_hessian;
+	model->rate_raw = &lacgfp5_rate_raw;
+	model->rate_jacobian = &lacgfp5_rate_jacobian;
 	model->update = &lacgfp5_state_update;
+	model->propensity_raw = &lacgfp5_propensity_raw;
+	model->propensity_update_raw = &lacgfp5_propensity_update_raw;
+	model->update_raw = &lacgfp5_state_update_raw;
+	model->propensity_lanes = &lacgfp5_propensity_lanes;
+	model->propensity_int = &lacgfp5_propensity_int;
+	model->propensity_update_int = &lacgfp5_propensity_update_int;
+	model->update_int = &lacgfp5_state_update_int;
+	model->initial_int = &lacgfp5_initial_conditions_int;
+	model->output_int = &lacgfp5_output_int;
 	model->initial = &lacgfp5_initial_conditions;
 	model->output = &lacgfp5_output;
 	model->nspecies = N;
@@ -306,4 +1683,11 @@ void lacgfp5_mod_setup (stochmod * model)
 	model->nin = Z;
 	model->nout = P;
 	model->name = "Lac-GFP construct model v5 (LACGFP5)";
+	model->stoich_ptr = lacgfp5_stoich_ptr;
+	model->stoich_idx = lacgfp5_stoich_idx;
+	model->stoich_val = lacgfp5_stoich_val;
+	model->react_ptr = lacgfp5_react_ptr;
+	model->react_idx = lacgfp5_react_idx;
+	model->react_val = lacgfp5_react_val;
+	model->graph = NULL;
 }
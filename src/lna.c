@@ -0,0 +1,404 @@
+/*
+ *  lna.c
+ *  StochMod
+ *
+ *	Linear noise approximation
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_blas.h>
+
+
+/**
+ === LNA SYSTEM ===
+ 	 The state of the system is y = [x, C], with the mean x (N) followed by the
+ 	 covariance C (N x N, row-major). With A = S * da/dx and D = S diag(a) S',
+ 	 	 dx/dt = S * a(x)
+ 	 	 dC/dt = A C + C A' + D
+ 	 where a are the macroscopic rates of the model, as in sm_ode_run.
+  */
+
+static int lna_function (double t, const double y[], double dydt[], void * params)
+{
+	sm_lna_workspace * w = params;
+	const stochmod * model = w->model;
+	size_t N = w->nspecies;
+	double * a = w->prop->data;
+	double * A = w->A;
+	gsl_vector_const_view X = gsl_vector_const_view_array (y, N);
+
+	// Macroscopic rates and their Jacobian in the mean state (the propensities
+	// for models that have no rates)
+	if (model->rate_raw != NULL)
+		model->rate_raw (y, w->par, a);
+	else if (w->fast)
+		model->propensity_raw (y, w->par, a);
+	else if (model->propensity (&X.vector, w->params, w->prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (((model->rate_jacobian != NULL) ? model->rate_jacobian : model->jacobian)
+			(&X.vector, w->params, w->Ja) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	// Drift of the mean and A = S * Ja
+	double * dx = dydt;
+	for (size_t i = 0; i < N; i++)
+		dx[i] = 0.0;
+	for (size_t i = 0; i < N*N; i++)
+		A[i] = 0.0;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		const double * row = w->Ja->data + j * w->Ja->tda;
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+		{
+			size_t i = model->stoich_idx[q];
+			double v = model->stoich_val[q];
+			dx[i] += v * a[j];
+			for (size_t k = 0; k < N; k++)
+				A[i*N + k] += v * row[k];
+		}
+	}
+
+	// Lyapunov equation: A C + (A C)' since C is symmetric
+	gsl_matrix_const_view Am = gsl_matrix_const_view_array (A, N, N);
+	gsl_matrix_const_view C = gsl_matrix_const_view_array (y + N, N, N);
+	gsl_matrix_view AC = gsl_matrix_view_array (w->AC, N, N);
+	gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Am.matrix, &C.matrix, 0.0, &AC.matrix);
+	double * dC = dydt + N;
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+			dC[i*N + k] = w->AC[i*N + k] + w->AC[k*N + i];
+
+	// Diffusion D = sum_j a(j) s(j) s(j)'
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		if (a[j] <= 0.0)
+			continue;
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			for (size_t p = model->stoich_ptr[j]; p < model->stoich_ptr[j+1]; p++)
+				dC[model->stoich_idx[q]*N + model->stoich_idx[p]] +=
+						a[j] * model->stoich_val[q] * model->stoich_val[p];
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Jacobian of the LNA system for the implicit steppers. The blocks of the mean
+ and of the covariance with respect to itself are exact, as is the dependence
+ of D on the mean; the dependence of A on the mean, which would need the
+ second derivatives of the propensities, is left out.
+ */
+static int lna_jacobian (double t, const double y[], double * dfdy, double dfdt[], void * params)
+{
+	sm_lna_workspace * w = params;
+	const stochmod * model = w->model;
+	size_t N = w->nspecies;
+	size_t dim = N + N*N;
+
+	// Refresh A and the propensity Jacobian in the current state
+	if (lna_function (t, y, w->dy, params) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	const double * A = w->A;
+	const double * Ja = w->Ja->data;
+	size_t tda = w->Ja->tda;
+
+	for (size_t i = 0; i < dim; i++)
+		dfdt[i] = 0.0;
+	for (size_t i = 0; i < dim*dim; i++)
+		dfdy[i] = 0.0;
+
+	// Mean block
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+			dfdy[i*dim + k] = A[i*N + k];
+
+	// Covariance block: d(A C + (A C)')(i,k) / dC(m,k) = A(i,m), / dC(m,i) = A(k,m)
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+		{
+			double * row = dfdy + (N + i*N + k) * dim + N;
+			for (size_t m = 0; m < N; m++)
+			{
+				row[m*N + k] += A[i*N + m];
+				row[m*N + i] += A[k*N + m];
+			}
+		}
+
+	// Dependence of the diffusion on the mean
+	for (size_t j = 0; j < w->nrxns; j++)
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			for (size_t p = model->stoich_ptr[j]; p < model->stoich_ptr[j+1]; p++)
+			{
+				double vv = model->stoich_val[q] * model->stoich_val[p];
+				double * row = dfdy + (N + model->stoich_idx[q]*N + model->stoich_idx[p]) * dim;
+				for (size_t m = 0; m < N; m++)
+					row[m] += vv * Ja[j*tda + m];
+			}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Allocate a workspace for the linear noise approximation of the given model.
+ The model must export its stoichiometry and its propensity Jacobian. The
+ system is integrated with the stiff BDF stepper of gsl_odeiv2 by default,
+ see sm_lna_workspace_set to change it.
+ */
+sm_lna_workspace * sm_lna_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->jacobian == NULL))
+	{
+		fprintf (stderr, "error in sm_lna_workspace_alloc: model does not export its stoichiometry and Jacobian\n");
+		return NULL;
+	}
+
+	sm_lna_workspace * w = malloc (sizeof (sm_lna_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_lna_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t dim = N + N*N;
+	w->nspecies = N;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->nout = model->nout;
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->Ja = gsl_matrix_alloc (model->nrxns, N);
+	w->A = malloc ((N*N + 1) * sizeof (double));
+	w->AC = malloc ((N*N + 1) * sizeof (double));
+	w->y = malloc ((dim + 1) * sizeof (double));
+	w->dy = malloc ((dim + 1) * sizeof (double));
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->H = NULL;
+	w->HC = NULL;
+	w->model = model;
+	w->params = NULL;
+	w->fast = 0;
+
+	// Output matrix of the model, when it has one
+	int outerr = 0;
+	if ((model->output != NULL) && (model->nout > 0))
+	{
+		w->H = gsl_matrix_alloc (model->nout, N);
+		w->HC = gsl_matrix_alloc (model->nout, N);
+		outerr = (w->H == NULL) || (w->HC == NULL) || (model->output (w->H) != GSL_SUCCESS);
+	}
+
+	// gsl_odeiv2 system and default driver
+	w->sys.function = lna_function;
+	w->sys.jacobian = lna_jacobian;
+	w->sys.dimension = dim;
+	w->sys.params = w;
+	w->type = gsl_odeiv2_step_msbdf;
+	w->hstart = 1e-6;
+	w->epsabs = 1e-8;
+	w->epsrel = 1e-6;
+	w->driver = gsl_odeiv2_driver_alloc_y_new (&w->sys, w->type, w->hstart, w->epsabs, w->epsrel);
+
+	if ((w->prop == NULL) || (w->Ja == NULL) || (w->A == NULL) || (w->AC == NULL) || (w->y == NULL)
+			|| (w->dy == NULL) || (w->par == NULL) || (w->driver == NULL) || outerr)
+	{
+		fprintf (stderr, "error in sm_lna_workspace_alloc: failed to allocate workspace members\n");
+		sm_lna_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_lna_workspace_alloc.
+ */
+void sm_lna_workspace_free (sm_lna_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->Ja != NULL)
+		gsl_matrix_free (w->Ja);
+	if (w->H != NULL)
+		gsl_matrix_free (w->H);
+	if (w->HC != NULL)
+		gsl_matrix_free (w->HC);
+	if (w->driver != NULL)
+		gsl_odeiv2_driver_free (w->driver);
+	free (w->A);
+	free (w->AC);
+	free (w->y);
+	free (w->dy);
+	free (w->par);
+	free (w);
+}
+
+
+/**
+ Change the stepper and the error tolerances used by sm_lna_run.
+ */
+int sm_lna_workspace_set (sm_lna_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel)
+{
+	gsl_odeiv2_driver * d = gsl_odeiv2_driver_alloc_y_new (&w->sys, T, w->hstart, epsabs, epsrel);
+	if (d == NULL)
+	{
+		fprintf (stderr, "error in sm_lna_workspace_set: failed to allocate driver\n");
+		return GSL_EFAILED;
+	}
+
+	gsl_odeiv2_driver_free (w->driver);
+	w->driver = d;
+	w->type = T;
+	w->epsabs = epsabs;
+	w->epsrel = epsrel;
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Compute the linear noise approximation of the model: the mean follows the
+ reaction rate equations and the covariance the Lyapunov equation above.
+
+ Arguments:
+ 	 model: the model
+ 	 params: vector of parameters and inputs of the model
+ 	 X0: initial mean
+ 	 C0: initial covariance (N x N), or NULL for a deterministic initial state
+ 	 tgrid: time points at which the moments are returned
+ 	 means: on output, row k holds the mean at time tgrid(k)
+ 	 covs: on output, row k holds the covariance at time tgrid(k), row-major
+ 	 	 (tgrid->size x N*N)
+ 	 w: workspace
+ */
+int sm_lna_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0, const gsl_matrix * C0,
+		const gsl_vector * tgrid, gsl_matrix * means, gsl_matrix * covs, sm_lna_workspace * w)
+{
+	size_t N = model->nspecies;
+
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_lna_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != N) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_lna_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((C0 != NULL) && ((C0->size1 != N) || (C0->size2 != N)))
+	{
+		fprintf (stderr, "error in sm_lna_run: initial covariance size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((means->size1 != tgrid->size) || (means->size2 != N) || (covs->size1 != tgrid->size)
+			|| (covs->size2 != N*N))
+	{
+		fprintf (stderr, "error in sm_lna_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+
+	double * y = w->y;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->model = model;
+	w->params = params;
+	w->fast = (model->propensity_raw != NULL);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+	for (size_t i = 0; i < N; i++)
+		y[i] = gsl_vector_get (X0, i);
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+			y[N + i*N + k] = (C0 != NULL) ? gsl_matrix_get (C0, i, k) : 0.0;
+	gsl_odeiv2_driver_reset (w->driver);
+
+	for (size_t k = 0; k < tgrid->size; k++)
+	{
+		double tk = gsl_vector_get (tgrid, k);
+		if (tk > t)
+		{
+			int status = gsl_odeiv2_driver_apply (w->driver, &t, tk, y);
+			if (status != GSL_SUCCESS)
+			{
+				fprintf (stderr, "error in sm_lna_run: integration failed at t = %g (status %d)\n", t, status);
+				return GSL_EFAILED;
+			}
+		}
+		for (size_t i = 0; i < N; i++)
+			gsl_matrix_set (means, k, i, y[i]);
+		for (size_t i = 0; i < N*N; i++)
+			gsl_matrix_set (covs, k, i, y[N + i]);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Map the moments computed by sm_lna_run to the outputs of the model, with the
+ output matrix H: row k of ymeans is H * mean(k), and row k of ycovs is
+ H * C(k) * H' (nout x nout, row-major).
+ */
+int sm_lna_output (const gsl_matrix * means, const gsl_matrix * covs, gsl_matrix * ymeans, gsl_matrix * ycovs,
+		sm_lna_workspace * w)
+{
+	size_t N = w->nspecies;
+	size_t P = w->nout;
+
+	// Check sizes of vectors and matrices
+	if (w->H == NULL)
+	{
+		fprintf (stderr, "error in sm_lna_output: model does not have an output matrix\n");
+		return GSL_EFAILED;
+	}
+	if ((means->size2 != N) || (covs->size2 != N*N) || (covs->size1 != means->size1)
+			|| (ymeans->size1 != means->size1) || (ymeans->size2 != P)
+			|| (ycovs->size1 != means->size1) || (ycovs->size2 != P*P))
+	{
+		fprintf (stderr, "error in sm_lna_output: matrix sizes are not correct\n");
+		return GSL_EFAILED;
+	}
+
+	for (size_t k = 0; k < means->size1; k++)
+	{
+		gsl_vector_const_view m = gsl_matrix_const_row (means, k);
+		gsl_vector_view ym = gsl_matrix_row (ymeans, k);
+		gsl_blas_dgemv (CblasNoTrans, 1.0, w->H, &m.vector, 0.0, &ym.vector);
+
+		gsl_matrix_const_view C = gsl_matrix_const_view_array (covs->data + k * covs->tda, N, N);
+		gsl_matrix_view Y = gsl_matrix_view_array (ycovs->data + k * ycovs->tda, P, P);
+		gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, w->H, &C.matrix, 0.0, w->HC);
+		gsl_blas_dgemm (CblasNoTrans, CblasTrans, 1.0, w->HC, w->H, 0.0, &Y.matrix);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,366 @@
+/*
+ *  lockstep.c
+ *  StochMod
+ *
+ *	Lockstep SSA engine for ensembles of trajectories of small models
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ === LOCKSTEP SIMULATION ===
+ 	 A step of the direct method on a model with a handful of species and
+ 	 reactions is too short to fill the vector units of the processor. This
+ 	 engine runs the direct method on SM_LOCK_LANES trajectories at once, one
+ 	 per lane, with the states and propensities of the lanes stored by species
+ 	 and by reaction: the propensities of all the lanes are evaluated by a
+ 	 single call to the propensity_lanes callback of the model, and the sums of
+ 	 the propensities and the selection of the reactions are loops of fixed
+ 	 length over the lanes, which the compiler vectorizes. The reaction that
+ 	 fires in a lane is the number of cumulative propensities that do not
+ 	 exceed its target, so the selection needs no branch; the stoichiometry of
+ 	 the reaction is then scattered to the column of the lane.
+
+ 	 When a trajectory reaches the end of the time grid its lane is handed the
+ 	 next trajectory right away, so all the lanes stay busy until the last
+ 	 trajectories. Trajectory id uses a generator of type sm_rng_philox keyed
+ 	 by (seed, id), and draws its variates in the same order as
+ 	 sm_ssa_direct_run: its states are the same as those of sm_ssa_direct_run
+ 	 with a generator keyed in the same way.
+  */
+
+
+/**
+ Allocate a workspace for the lockstep SSA that fits the given model.
+ */
+sm_lock_workspace * sm_lock_workspace_alloc (const stochmod * model)
+{
+	if (model->stoich_ptr == NULL)
+	{
+		fprintf (stderr, "error in sm_lock_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_lock_workspace * w = malloc (sizeof (sm_lock_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_lock_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->ntimes = 0;
+	w->done = NULL;
+	w->data = NULL;
+	w->x = malloc (model->nspecies * SM_LOCK_LANES * sizeof (double));
+	w->a = malloc (model->nrxns * SM_LOCK_LANES * sizeof (double));
+	w->xl = malloc ((model->nspecies + 1) * sizeof (double));
+	w->al = malloc ((model->nrxns + 1) * sizeof (double));
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->x0 = gsl_vector_alloc (model->nspecies);
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		w->rngs[l] = gsl_rng_alloc (sm_rng_philox);
+		w->states[l] = NULL;
+	}
+
+	int failed = 0;
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+		failed |= (w->rngs[l] == NULL);
+	if (failed || (w->x == NULL) || (w->a == NULL) || (w->xl == NULL) || (w->al == NULL)
+			|| (w->par == NULL) || (w->x0 == NULL))
+	{
+		fprintf (stderr, "error in sm_lock_workspace_alloc: failed to allocate workspace vectors\n");
+		sm_lock_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_lock_workspace_alloc.
+ */
+void sm_lock_workspace_free (sm_lock_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		if (w->rngs[l] != NULL)
+			gsl_rng_free (w->rngs[l]);
+		if (w->states[l] != NULL)
+			gsl_matrix_free (w->states[l]);
+	}
+	if (w->x0 != NULL)
+		gsl_vector_free (w->x0);
+	free (w->x);
+	free (w->a);
+	free (w->xl);
+	free (w->al);
+	free (w->par);
+	free (w);
+}
+
+
+/**
+ Start trajectory id of the ensemble on lane l: key its generator and write
+ its initial state in the column of the lane.
+ */
+static int lock_start (const stochmod * model, const gsl_vector * X0, const gsl_vector * tgrid,
+		unsigned long seed, size_t id, size_t l, sm_lock_workspace * w)
+{
+	const gsl_rng * r = w->rngs[l];
+
+	sm_rng_key (r, seed, id);
+	if (X0 == NULL)
+	{
+		if (model->initial (w->x0, r) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		X0 = w->x0;
+	}
+	for (size_t i = 0; i < w->nspecies; i++)
+		w->x[i*SM_LOCK_LANES + l] = gsl_vector_get (X0, i);
+	sm_rngbuf_set (&w->rb[l], r);
+
+	w->id[l] = id;
+	w->k[l] = 0;
+	w->t[l] = gsl_vector_get (tgrid, 0);
+	w->tk[l] = w->t[l];
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Record the current state of lane l at all the time points before its next
+ reaction, and return 1 if its trajectory is complete.
+ */
+static int lock_record (const gsl_vector * tgrid, size_t l, sm_lock_workspace * w)
+{
+	gsl_matrix * S = w->states[l];
+	size_t k = w->k[l];
+
+	while ((k < tgrid->size) && (gsl_vector_get (tgrid, k) < w->tnext[l]))
+	{
+		double * row = S->data + k * S->tda;
+		for (size_t i = 0; i < w->nspecies; i++)
+			row[i] = w->x[i*SM_LOCK_LANES + l];
+		k++;
+	}
+
+	w->k[l] = k;
+	if (k == tgrid->size)
+		return 1;
+	w->tk[l] = gsl_vector_get (tgrid, k);
+	return 0;
+}
+
+
+/**
+ Simulate trajectories first, ..., first + ntraj - 1 of the ensemble with the
+ given seed by the direct method, SM_LOCK_LANES at a time.
+
+ Each trajectory starts from X0, or from a state sampled with the initial
+ conditions of the model if X0 is NULL, at time tgrid(0), and its states at
+ the time points of tgrid (which must be non-decreasing) are passed to
+ w->done with its id and w->data as soon as it is complete. The trajectories
+ complete in an order that depends on their lengths, but not on anything
+ else. Models that do not provide propensity_lanes are evaluated one lane at
+ a time with propensity_raw.
+ */
+int sm_lock_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, unsigned long seed, size_t first, size_t ntraj, sm_lock_workspace * w)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_lock_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if (((X0 != NULL) && (X0->size != model->nspecies)) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_lock_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (X0 != NULL) ? (int) X0->size : -1, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((X0 == NULL) && (model->initial == NULL))
+	{
+		fprintf (stderr, "error in sm_lock_run: model has no random initial conditions\n");
+		return GSL_EFAILED;
+	}
+	if (model->stoich_ptr == NULL)
+	{
+		fprintf (stderr, "error in sm_lock_run: model does not export its stoichiometry\n");
+		return GSL_EFAILED;
+	}
+	if ((model->propensity_lanes == NULL) && (model->propensity_raw == NULL))
+	{
+		fprintf (stderr, "error in sm_lock_run: model does not support lockstep simulation\n");
+		return GSL_EFAILED;
+	}
+	if ((tgrid->size == 0) || (ntraj == 0))
+		return GSL_SUCCESS;
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	const size_t * sptr = model->stoich_ptr;
+	const size_t * sidx = model->stoich_idx;
+	const int * sval = model->stoich_val;
+	double * restrict x = w->x;
+	double * restrict a = w->a;
+	double * restrict a0 = w->a0;
+	double * restrict target = w->target;
+	double * restrict cum = w->cum;
+	size_t * restrict sel = w->sel;
+	double * par = w->par;
+
+	// Per-lane trajectory buffers for this time grid
+	if (w->ntimes != ntimes)
+	{
+		w->ntimes = 0;
+		for (size_t l = 0; l < SM_LOCK_LANES; l++)
+		{
+			if (w->states[l] != NULL)
+				gsl_matrix_free (w->states[l]);
+			if ((w->states[l] = gsl_matrix_alloc (ntimes, N)) == NULL)
+			{
+				fprintf (stderr, "error in sm_lock_run: failed to allocate lane buffers\n");
+				return GSL_EFAILED;
+			}
+		}
+		w->ntimes = ntimes;
+	}
+
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+
+	// One trajectory on each lane, as long as there are any
+	size_t next = first;
+	size_t end = first + ntraj;
+	size_t nbusy = 0;
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		w->busy[l] = (next < end);
+		if (w->busy[l])
+		{
+			if (lock_start (model, X0, tgrid, seed, next++, l, w) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			nbusy++;
+		}
+	}
+
+	while (nbusy > 0)
+	{
+		// Propensities of all the lanes
+		if (model->propensity_lanes != NULL)
+			model->propensity_lanes (x, par, a);
+		else
+		{
+			for (size_t l = 0; l < SM_LOCK_LANES; l++)
+			{
+				if (!w->busy[l])
+					continue;
+				for (size_t i = 0; i < N; i++)
+					w->xl[i] = x[i*SM_LOCK_LANES + l];
+				model->propensity_raw (w->xl, par, w->al);
+				for (size_t j = 0; j < R; j++)
+					a[j*SM_LOCK_LANES + l] = w->al[j];
+			}
+		}
+		for (size_t l = 0; l < SM_LOCK_LANES; l++)
+			a0[l] = 0.0;
+		for (size_t j = 0; j < R; j++)
+			for (size_t l = 0; l < SM_LOCK_LANES; l++)
+				a0[l] += a[j*SM_LOCK_LANES + l];
+
+		for (size_t l = 0; l < SM_LOCK_LANES; l++)
+		{
+			w->fire[l] = 0;
+			target[l] = 0.0;
+			if (!w->busy[l])
+				continue;
+
+			// Time of the next reaction (infinite if the process has stopped)
+			w->tnext[l] = (a0[l] > 0.0) ? w->t[l] + sm_rngbuf_exponential (&w->rb[l]) / a0[l] : INFINITY;
+
+			// The trajectory is complete: hand the lane the next one
+			if ((w->tk[l] < w->tnext[l]) && lock_record (tgrid, l, w))
+			{
+				if (w->done != NULL)
+					w->done (w->id[l], w->states[l], w->data);
+				if (next < end)
+				{
+					if (lock_start (model, X0, tgrid, seed, next++, l, w) != GSL_SUCCESS)
+						return GSL_EFAILED;
+				}
+				else
+				{
+					w->busy[l] = 0;
+					nbusy--;
+				}
+				continue;
+			}
+
+			w->fire[l] = 1;
+			target[l] = a0[l] * sm_rngbuf_uniform (&w->rb[l]);
+		}
+
+		// Select the reactions that fire: the first whose cumulative propensity
+		// exceeds the target
+		for (size_t l = 0; l < SM_LOCK_LANES; l++)
+		{
+			cum[l] = 0.0;
+			sel[l] = 0;
+		}
+		for (size_t j = 0; j < R; j++)
+		{
+			for (size_t l = 0; l < SM_LOCK_LANES; l++)
+			{
+				cum[l] += a[j*SM_LOCK_LANES + l];
+				sel[l] += (cum[l] <= target[l]);
+			}
+		}
+
+		// Fire them and advance the times
+		for (size_t l = 0; l < SM_LOCK_LANES; l++)
+		{
+			if (!w->fire[l])
+				continue;
+
+			// Round-off left the target above the total: take the last reaction that can fire
+			size_t rxnid = sel[l];
+			while ((rxnid == R) || (a[rxnid*SM_LOCK_LANES + l] <= 0.0))
+				rxnid--;
+
+			for (size_t q = sptr[rxnid]; q < sptr[rxnid+1]; q++)
+				x[sidx[q]*SM_LOCK_LANES + l] += sval[q];
+			w->t[l] = w->tnext[l];
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
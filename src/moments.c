@@ -0,0 +1,584 @@
+/*
+ *  moments.c
+ *  StochMod
+ *
+ *	Moment closure approximation
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_blas.h>
+
+
+/**
+ === CLOSED MOMENT EQUATIONS ===
+ 	 The state of the system is y = [m, C], with the mean m (N) followed by the
+ 	 covariance C (N x N, row-major). The propensities are expanded to second
+ 	 order around the mean, which is exact for reactions up to bimolecular:
+ 	 	 E[a(j)] = a(j)(m) + 1/2 sum_lk H(j,lk) C(l,k)
+ 	 	 Cov[a(j), X(i)] = sum_l J(j,l) C(l,i) + 1/2 sum_lk H(j,lk) K(l,k,i)
+ 	 	 dm/dt = S E[a]
+ 	 	 dC/dt = S Cov[a,X] + (S Cov[a,X])' + S diag(E[a]) S'
+ 	 where J and H are the propensity Jacobian and Hessian of the model, and the
+ 	 third central moments K are closed in terms of m and C (w->order = 2).
+
+ 	 At third order the state is y = [m, C, K], with K (N x N x N, row-major)
+ 	 integrated as well. Writing x = X - m, v(j) for the column j of S and
+ 	 	 D(j,kl) = E[a(j) x(k) x(l)] - E[a(j)] C(k,l)
+ 	 	 		 = sum_p J(j,p) K(p,k,l) + 1/2 sum_pq H(j,pq) (M(p,q,k,l) - C(p,q) C(k,l))
+ 	 the third moments follow
+ 	 	 dK(i,k,l)/dt = sum_j v(i,j) D(j,kl) + v(k,j) D(j,il) + v(l,j) D(j,ik)
+ 	 	 		 + v(i,j) v(k,j) Cov[a(j), X(l)] + v(i,j) v(l,j) Cov[a(j), X(k)]
+ 	 	 		 + v(k,j) v(l,j) Cov[a(j), X(i)] + v(i,j) v(k,j) v(l,j) E[a(j)]
+ 	 where the fourth central moments M are closed in terms of m, C and K.
+  */
+
+/**
+ Third central moments of a multivariate log-normal distribution with mean m
+ and covariance C. Species with a non-positive mean are treated as normal.
+ */
+static void mc_lognormal (size_t N, const double * m, const double * C, double * K)
+{
+	for (size_t a = 0; a < N; a++)
+		for (size_t b = 0; b < N; b++)
+			for (size_t c = 0; c < N; c++)
+			{
+				double * k = K + (a*N + b)*N + c;
+				if ((m[a] <= 0.0) || (m[b] <= 0.0) || (m[c] <= 0.0))
+				{
+					*k = 0.0;
+					continue;
+				}
+				double Cab = C[a*N + b];
+				double Cac = C[a*N + c];
+				double Cbc = C[b*N + c];
+				*k = Cab * Cac / m[a] + Cab * Cbc / m[b] + Cac * Cbc / m[c]
+						+ Cab * Cac * Cbc / (m[a] * m[b] * m[c]);
+			}
+}
+
+
+/**
+ Fourth central moment M(a,b,c,d) of a normal distribution with mean m and
+ covariance C or, with SM_MC_LOGNORMAL, of a log-normal distribution, whose
+ fourth raw moment follows from the lower ones as
+ 	 E[abcd] = E[abc] E[abd] E[acd] E[bcd] m(a) m(b) m(c) m(d) / prod_pairs E[pq]
+ with the third central moments K. Species with a non-positive mean are
+ treated as normal.
+ */
+static double mc_fourth (sm_mc_closure closure, size_t N, const double * m, const double * C, const double * K,
+		size_t a, size_t b, size_t c, size_t d)
+{
+	double Cab = C[a*N + b];
+	double Cac = C[a*N + c];
+	double Cad = C[a*N + d];
+	double Cbc = C[b*N + c];
+	double Cbd = C[b*N + d];
+	double Ccd = C[c*N + d];
+	if ((closure != SM_MC_LOGNORMAL) || (m[a] <= 0.0) || (m[b] <= 0.0) || (m[c] <= 0.0) || (m[d] <= 0.0))
+		return Cab * Ccd + Cac * Cbd + Cad * Cbc;
+
+	// Raw moments of second and third order
+	double Eab = Cab + m[a] * m[b];
+	double Eac = Cac + m[a] * m[c];
+	double Ead = Cad + m[a] * m[d];
+	double Ebc = Cbc + m[b] * m[c];
+	double Ebd = Cbd + m[b] * m[d];
+	double Ecd = Ccd + m[c] * m[d];
+	if ((Eab <= 0.0) || (Eac <= 0.0) || (Ead <= 0.0) || (Ebc <= 0.0) || (Ebd <= 0.0) || (Ecd <= 0.0))
+		return Cab * Ccd + Cac * Cbd + Cad * Cbc;
+	double Eabc = K[(a*N + b)*N + c] + m[a] * Cbc + m[b] * Cac + m[c] * Cab + m[a] * m[b] * m[c];
+	double Eabd = K[(a*N + b)*N + d] + m[a] * Cbd + m[b] * Cad + m[d] * Cab + m[a] * m[b] * m[d];
+	double Eacd = K[(a*N + c)*N + d] + m[a] * Ccd + m[c] * Cad + m[d] * Cac + m[a] * m[c] * m[d];
+	double Ebcd = K[(b*N + c)*N + d] + m[b] * Ccd + m[c] * Cbd + m[d] * Cbc + m[b] * m[c] * m[d];
+	double mabcd = m[a] * m[b] * m[c] * m[d];
+	double Eabcd = (Eabc / Eab) * (Eabd / Eac) * (Eacd / Ead) * (Ebcd / Ebc) * mabcd / (Ebd * Ecd);
+
+	// Central moment from the raw ones
+	return Eabcd - m[a] * Ebcd - m[b] * Eacd - m[c] * Eabd - m[d] * Eabc
+			+ m[a] * m[b] * Ecd + m[a] * m[c] * Ebd + m[a] * m[d] * Ebc
+			+ m[b] * m[c] * Ead + m[b] * m[d] * Eac + m[c] * m[d] * Eab - 3.0 * mabcd;
+}
+
+
+static int mc_function (double t, const double y[], double dydt[], void * params)
+{
+	sm_mc_workspace * w = params;
+	const stochmod * model = w->model;
+	size_t N = w->nspecies;
+	size_t R = w->nrxns;
+	const double * C = y + N;
+	const double * K = NULL;
+	double * a = w->prop->data;
+	double * Ea = w->Ea;
+	double * Ca = w->Ca;
+	gsl_vector_const_view X = gsl_vector_const_view_array (y, N);
+
+	// Propensities and their derivatives in the mean state
+	if (w->fast)
+		model->propensity_raw (y, w->par, a);
+	else if (model->propensity (&X.vector, w->params, w->prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (model->jacobian (&X.vector, w->params, w->Ja) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (model->hessian (&X.vector, w->params, w->Hs) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (w->order == 3)
+		K = C + N*N;
+	else if (w->closure == SM_MC_LOGNORMAL)
+	{
+		mc_lognormal (N, y, C, w->K);
+		K = w->K;
+	}
+
+	// Expected propensities and covariances Ca(j,i) = Cov[a(j), X(i)]
+	for (size_t j = 0; j < R; j++)
+	{
+		const double * Jj = w->Ja->data + j * w->Ja->tda;
+		const double * Hj = w->Hs->data + j * w->Hs->tda;
+		double * Caj = Ca + j*N;
+
+		Ea[j] = a[j];
+		for (size_t i = 0; i < N; i++)
+		{
+			Caj[i] = 0.0;
+			for (size_t l = 0; l < N; l++)
+				Caj[i] += Jj[l] * C[l*N + i];
+		}
+		for (size_t lk = 0; lk < N*N; lk++)
+		{
+			if (Hj[lk] == 0.0)
+				continue;
+			Ea[j] += 0.5 * Hj[lk] * C[lk];
+			if (K != NULL)
+				for (size_t i = 0; i < N; i++)
+					Caj[i] += 0.5 * Hj[lk] * K[lk*N + i];
+		}
+		Ea[j] = GSL_MAX (Ea[j], 0.0);
+	}
+
+	// Moment equations
+	double * dm = dydt;
+	double * dC = dydt + N;
+	for (size_t i = 0; i < N; i++)
+		dm[i] = 0.0;
+	for (size_t i = 0; i < N*N; i++)
+		w->SC[i] = 0.0;
+	for (size_t j = 0; j < R; j++)
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+		{
+			size_t i = model->stoich_idx[q];
+			double v = model->stoich_val[q];
+			dm[i] += v * Ea[j];
+			for (size_t k = 0; k < N; k++)
+				w->SC[i*N + k] += v * Ca[j*N + k];
+		}
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+			dC[i*N + k] = w->SC[i*N + k] + w->SC[k*N + i];
+	for (size_t j = 0; j < R; j++)
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			for (size_t p = model->stoich_ptr[j]; p < model->stoich_ptr[j+1]; p++)
+				dC[model->stoich_idx[q]*N + model->stoich_idx[p]] +=
+						Ea[j] * model->stoich_val[q] * model->stoich_val[p];
+
+	if (w->order != 3)
+		return GSL_SUCCESS;
+
+	// Third moment equations, with D(j,kl) as in the comment above
+	double * dK = dC + N*N;
+	size_t N2 = N*N;
+	for (size_t i = 0; i < N2*N; i++)
+		dK[i] = 0.0;
+	for (size_t j = 0; j < R; j++)
+	{
+		const double * Jj = w->Ja->data + j * w->Ja->tda;
+		const double * Hj = w->Hs->data + j * w->Hs->tda;
+		const double * Caj = Ca + j*N;
+		double * Dj = w->Da + j*N2;
+		size_t q0 = model->stoich_ptr[j];
+		size_t q1 = model->stoich_ptr[j+1];
+
+		for (size_t kl = 0; kl < N2; kl++)
+		{
+			Dj[kl] = 0.0;
+			for (size_t p = 0; p < N; p++)
+				Dj[kl] += Jj[p] * K[p*N2 + kl];
+		}
+		for (size_t pq = 0; pq < N2; pq++)
+		{
+			if (Hj[pq] == 0.0)
+				continue;
+			for (size_t kl = 0; kl < N2; kl++)
+				Dj[kl] += 0.5 * Hj[pq] * (mc_fourth (w->closure, N, y, C, K, pq / N, pq % N, kl / N, kl % N)
+						- C[pq] * C[kl]);
+		}
+
+		for (size_t q = q0; q < q1; q++)
+		{
+			size_t i = model->stoich_idx[q];
+			double v = model->stoich_val[q];
+			for (size_t k = 0; k < N; k++)
+				for (size_t l = 0; l < N; l++)
+				{
+					double d = v * Dj[k*N + l];
+					dK[i*N2 + k*N + l] += d;
+					dK[k*N2 + i*N + l] += d;
+					dK[k*N2 + l*N + i] += d;
+				}
+			for (size_t p = q0; p < q1; p++)
+			{
+				size_t k = model->stoich_idx[p];
+				double vv = v * model->stoich_val[p];
+				for (size_t l = 0; l < N; l++)
+				{
+					double g = vv * Caj[l];
+					dK[i*N2 + k*N + l] += g;
+					dK[i*N2 + l*N + k] += g;
+					dK[l*N2 + i*N + k] += g;
+				}
+				for (size_t r = q0; r < q1; r++)
+					dK[i*N2 + k*N + model->stoich_idx[r]] += vv * model->stoich_val[r] * Ea[j];
+			}
+		}
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Jacobian of the closed moment equations for the implicit steppers, by
+ forward differences.
+ */
+static int mc_jacobian (double t, const double y[], double * dfdy, double dfdt[], void * params)
+{
+	sm_mc_workspace * w = params;
+	size_t dim = w->sys.dimension;
+
+	if (mc_function (t, y, w->f0, params) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	for (size_t c = 0; c < dim; c++)
+		w->yt[c] = y[c];
+
+	for (size_t c = 0; c < dim; c++)
+	{
+		double h = 1e-7 * GSL_MAX (fabs (y[c]), 1.0);
+		w->yt[c] = y[c] + h;
+		if (mc_function (t, w->yt, w->f1, params) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		w->yt[c] = y[c];
+		for (size_t r = 0; r < dim; r++)
+			dfdy[r*dim + c] = (w->f1[r] - w->f0[r]) / h;
+	}
+	for (size_t r = 0; r < dim; r++)
+		dfdt[r] = 0.0;
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Allocate a workspace for the moment closure of the given model. The model
+ must export its stoichiometry and its propensity Jacobian and Hessian. The
+ closure is normal, of second order, and the system is integrated with the
+ stiff BDF stepper of gsl_odeiv2 by default, see sm_mc_workspace_set to change
+ the stepper. The buffers are sized for the third order system, so that
+ w->order can be changed freely between runs.
+ */
+sm_mc_workspace * sm_mc_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->jacobian == NULL) || (model->hessian == NULL))
+	{
+		fprintf (stderr, "error in sm_mc_workspace_alloc: model does not export its stoichiometry and derivatives\n");
+		return NULL;
+	}
+
+	sm_mc_workspace * w = malloc (sizeof (sm_mc_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_mc_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	size_t dim = N + N*N + N*N*N;
+	w->nspecies = N;
+	w->nrxns = R;
+	w->npar = model->nparams + model->nin;
+	w->nout = model->nout;
+	w->prop = gsl_vector_alloc (R);
+	w->Ja = gsl_matrix_alloc (R, N);
+	w->Hs = gsl_matrix_alloc (R, N*N);
+	w->Ea = malloc ((R + 1) * sizeof (double));
+	w->Ca = malloc ((R*N + 1) * sizeof (double));
+	w->SC = malloc ((N*N + 1) * sizeof (double));
+	w->K = malloc ((N*N*N + 1) * sizeof (double));
+	w->Da = malloc ((R*N*N + 1) * sizeof (double));
+	w->y = malloc ((dim + 1) * sizeof (double));
+	w->yt = malloc ((dim + 1) * sizeof (double));
+	w->f0 = malloc ((dim + 1) * sizeof (double));
+	w->f1 = malloc ((dim + 1) * sizeof (double));
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->H = NULL;
+	w->HC = NULL;
+	w->model = model;
+	w->params = NULL;
+	w->closure = SM_MC_NORMAL;
+	w->order = 2;
+	w->fast = 0;
+
+	// Output matrix of the model, when it has one (output is NULL otherwise, see stochmod)
+	int outerr = 0;
+	if ((model->output != NULL) && (model->nout > 0))
+	{
+		w->H = gsl_matrix_alloc (model->nout, N);
+		w->HC = gsl_matrix_alloc (model->nout, N);
+		outerr = (w->H == NULL) || (w->HC == NULL) || (model->output (w->H) != GSL_SUCCESS);
+	}
+
+	// gsl_odeiv2 system and default driver
+	w->sys.function = mc_function;
+	w->sys.jacobian = mc_jacobian;
+	w->sys.dimension = N + N*N;
+	w->sys.params = w;
+	w->type = gsl_odeiv2_step_msbdf;
+	w->hstart = 1e-6;
+	w->epsabs = 1e-8;
+	w->epsrel = 1e-6;
+	w->driver = gsl_odeiv2_driver_alloc_y_new (&w->sys, w->type, w->hstart, w->epsabs, w->epsrel);
+
+	if ((w->prop == NULL) || (w->Ja == NULL) || (w->Hs == NULL) || (w->Ea == NULL) || (w->Ca == NULL)
+			|| (w->SC == NULL) || (w->K == NULL) || (w->Da == NULL) || (w->y == NULL) || (w->yt == NULL) || (w->f0 == NULL)
+			|| (w->f1 == NULL) || (w->par == NULL) || (w->driver == NULL) || outerr)
+	{
+		fprintf (stderr, "error in sm_mc_workspace_alloc: failed to allocate workspace members\n");
+		sm_mc_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_mc_workspace_alloc.
+ */
+void sm_mc_workspace_free (sm_mc_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->Ja != NULL)
+		gsl_matrix_free (w->Ja);
+	if (w->Hs != NULL)
+		gsl_matrix_free (w->Hs);
+	if (w->H != NULL)
+		gsl_matrix_free (w->H);
+	if (w->HC != NULL)
+		gsl_matrix_free (w->HC);
+	if (w->driver != NULL)
+		gsl_odeiv2_driver_free (w->driver);
+	free (w->Ea);
+	free (w->Ca);
+	free (w->SC);
+	free (w->K);
+	free (w->Da);
+	free (w->y);
+	free (w->yt);
+	free (w->f0);
+	free (w->f1);
+	free (w->par);
+	free (w);
+}
+
+
+/**
+ Change the stepper and the error tolerances used by sm_mc_run.
+ */
+int sm_mc_workspace_set (sm_mc_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel)
+{
+	gsl_odeiv2_driver * d = gsl_odeiv2_driver_alloc_y_new (&w->sys, T, w->hstart, epsabs, epsrel);
+	if (d == NULL)
+	{
+		fprintf (stderr, "error in sm_mc_workspace_set: failed to allocate driver\n");
+		return GSL_EFAILED;
+	}
+
+	gsl_odeiv2_driver_free (w->driver);
+	w->driver = d;
+	w->type = T;
+	w->epsabs = epsabs;
+	w->epsrel = epsrel;
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Integrate the closed equations for the means and covariances of the model,
+ with the closure selected in w->closure: SM_MC_NORMAL sets the third central
+ moments to zero, SM_MC_LOGNORMAL takes them from a log-normal distribution
+ with the same mean and covariance, which works better for the skewed
+ distributions of species with low copy numbers.
+
+ With w->order = 3 the third central moments are integrated as well, starting
+ from zero, and the closure is applied to the fourth moments instead, with
+ the log-normal one matched to the third moments as well. On
+ return w->y holds the last state, with the third moments K(i,k,l) at
+ w->y + N + N*N. The system then has N + N^2 + N^3 equations, which makes the
+ finite difference Jacobian of the implicit steppers costly beyond some ten
+ species.
+
+ Arguments and output are the same as in sm_lna_run.
+ */
+int sm_mc_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0, const gsl_matrix * C0,
+		const gsl_vector * tgrid, gsl_matrix * means, gsl_matrix * covs, sm_mc_workspace * w)
+{
+	size_t N = model->nspecies;
+
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_mc_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != N) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_mc_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((C0 != NULL) && ((C0->size1 != N) || (C0->size2 != N)))
+	{
+		fprintf (stderr, "error in sm_mc_run: initial covariance size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((means->size1 != tgrid->size) || (means->size2 != N) || (covs->size1 != tgrid->size)
+			|| (covs->size2 != N*N))
+	{
+		fprintf (stderr, "error in sm_mc_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((w->order != 2) && (w->order != 3))
+	{
+		fprintf (stderr, "error in sm_mc_run: order must be 2 or 3\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+
+	// Resize the driver to the system of the requested order
+	size_t dim = (w->order == 3) ? N + N*N + N*N*N : N + N*N;
+	if (w->sys.dimension != dim)
+	{
+		w->sys.dimension = dim;
+		gsl_odeiv2_driver * d = gsl_odeiv2_driver_alloc_y_new (&w->sys, w->type, w->hstart, w->epsabs, w->epsrel);
+		if (d == NULL)
+		{
+			fprintf (stderr, "error in sm_mc_run: failed to allocate driver\n");
+			return GSL_EFAILED;
+		}
+		gsl_odeiv2_driver_free (w->driver);
+		w->driver = d;
+	}
+
+	double * y = w->y;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->model = model;
+	w->params = params;
+	w->fast = (model->propensity_raw != NULL);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+	for (size_t i = 0; i < N; i++)
+		y[i] = gsl_vector_get (X0, i);
+	for (size_t i = 0; i < N; i++)
+		for (size_t k = 0; k < N; k++)
+			y[N + i*N + k] = (C0 != NULL) ? gsl_matrix_get (C0, i, k) : 0.0;
+	for (size_t i = N + N*N; i < dim; i++)
+		y[i] = 0.0;
+	gsl_odeiv2_driver_reset (w->driver);
+
+	for (size_t k = 0; k < tgrid->size; k++)
+	{
+		double tk = gsl_vector_get (tgrid, k);
+		if (tk > t)
+		{
+			int status = gsl_odeiv2_driver_apply (w->driver, &t, tk, y);
+			if (status != GSL_SUCCESS)
+			{
+				fprintf (stderr, "error in sm_mc_run: integration failed at t = %g (status %d)\n", t, status);
+				return GSL_EFAILED;
+			}
+		}
+		for (size_t i = 0; i < N; i++)
+			gsl_matrix_set (means, k, i, y[i]);
+		for (size_t i = 0; i < N*N; i++)
+			gsl_matrix_set (covs, k, i, y[N + i]);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Map the moments computed by sm_mc_run to the outputs of the model, as in
+ sm_lna_output.
+ */
+int sm_mc_output (const gsl_matrix * means, const gsl_matrix * covs, gsl_matrix * ymeans, gsl_matrix * ycovs,
+		sm_mc_workspace * w)
+{
+	size_t N = w->nspecies;
+	size_t P = w->nout;
+
+	// Check sizes of vectors and matrices
+	if (w->H == NULL)
+	{
+		fprintf (stderr, "error in sm_mc_output: model does not have an output matrix\n");
+		return GSL_EFAILED;
+	}
+	if ((means->size2 != N) || (covs->size2 != N*N) || (covs->size1 != means->size1)
+			|| (ymeans->size1 != means->size1) || (ymeans->size2 != P)
+			|| (ycovs->size1 != means->size1) || (ycovs->size2 != P*P))
+	{
+		fprintf (stderr, "error in sm_mc_output: matrix sizes are not correct\n");
+		return GSL_EFAILED;
+	}
+
+	for (size_t k = 0; k < means->size1; k++)
+	{
+		gsl_vector_const_view m = gsl_matrix_const_row (means, k);
+		gsl_vector_view ym = gsl_matrix_row (ymeans, k);
+		gsl_blas_dgemv (CblasNoTrans, 1.0, w->H, &m.vector, 0.0, &ym.vector);
+
+		gsl_matrix_const_view C = gsl_matrix_const_view_array (covs->data + k * covs->tda, N, N);
+		gsl_matrix_view Y = gsl_matrix_view_array (ycovs->data + k * ycovs->tda, P, P);
+		gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, w->H, &C.matrix, 0.0, w->HC);
+		gsl_blas_dgemm (CblasNoTrans, CblasTrans, 1.0, w->HC, w->H, 0.0, &Y.matrix);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,269 @@
+/*
+ *  nrm.c
+ *  StochMod
+ *
+ *	Gibson-Bruck Next Reaction Method simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ === INDEXED PRIORITY QUEUE ===
+ 	 Binary min-heap of the putative firing times tau. heap(k) is the reaction
+ 	 stored at node k and pos(j) is the node where reaction j is stored, so that
+ 	 the time of any reaction can be changed in O(log R).
+  */
+
+static void ipq_swap (sm_nrm_workspace * w, size_t a, size_t b)
+{
+	size_t ja = w->heap[a];
+	size_t jb = w->heap[b];
+	w->heap[a] = jb;
+	w->heap[b] = ja;
+	w->pos[jb] = a;
+	w->pos[ja] = b;
+}
+
+
+static void ipq_update (sm_nrm_workspace * w, size_t j)
+{
+	size_t k = w->pos[j];
+
+	// Move the node up while it is earlier than its parent
+	while ((k > 0) && (w->tau[w->heap[k]] < w->tau[w->heap[(k-1)/2]]))
+	{
+		ipq_swap (w, k, (k-1)/2);
+		k = (k-1)/2;
+	}
+
+	// Move the node down while one of its children is earlier
+	for (;;)
+	{
+		size_t l = 2*k + 1;
+		size_t r = 2*k + 2;
+		size_t min = k;
+		if ((l < w->nrxns) && (w->tau[w->heap[l]] < w->tau[w->heap[min]]))
+			min = l;
+		if ((r < w->nrxns) && (w->tau[w->heap[r]] < w->tau[w->heap[min]]))
+			min = r;
+		if (min == k)
+			break;
+		ipq_swap (w, k, min);
+		k = min;
+	}
+}
+
+
+static void ipq_build (sm_nrm_workspace * w)
+{
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		w->heap[j] = j;
+		w->pos[j] = j;
+	}
+	for (size_t k = w->nrxns / 2; k-- > 0; )
+		ipq_update (w, w->heap[k]);
+}
+
+
+/**
+ Allocate a workspace for the Next Reaction Method that fits the given model.
+ The dependency graph attached to the model is used when present, otherwise
+ it is built here, once.
+ */
+sm_nrm_workspace * sm_nrm_workspace_alloc (const stochmod * model)
+{
+	sm_nrm_workspace * w = malloc (sizeof (sm_nrm_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_nrm_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->X = gsl_vector_alloc (model->nspecies);
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->oldprop = gsl_vector_alloc (model->nrxns);
+	w->par = malloc ((model->nparams + model->nin + 1) * sizeof (double));
+	w->npar = model->nparams + model->nin;
+	w->tau = malloc ((model->nrxns + 1) * sizeof (double));
+	w->heap = malloc ((model->nrxns + 1) * sizeof (size_t));
+	w->pos = malloc ((model->nrxns + 1) * sizeof (size_t));
+	w->owngraph = NULL;
+	w->graph = model->graph;
+	if (w->graph == NULL)
+		w->graph = w->owngraph = sm_depgraph_alloc (model);
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->oldprop == NULL) || (w->par == NULL)
+			|| (w->tau == NULL)
+			|| (w->heap == NULL) || (w->pos == NULL) || (w->graph == NULL))
+	{
+		fprintf (stderr, "error in sm_nrm_workspace_alloc: failed to allocate workspace members\n");
+		sm_nrm_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_nrm_workspace_alloc.
+ */
+void sm_nrm_workspace_free (sm_nrm_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->oldprop != NULL)
+		gsl_vector_free (w->oldprop);
+	free (w->par);
+	free (w->tau);
+	free (w->heap);
+	free (w->pos);
+	sm_depgraph_free (w->owngraph);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the model with the Next Reaction Method of
+ Gibson and Bruck.
+
+ Arguments and output are the same as in sm_ssa_direct_run. After each firing
+ only the reactions listed in the dependency graph are rescheduled, so the
+ cost of selecting the next reaction is O(log R).
+ */
+int sm_nrm_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_nrm_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_nrm_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_nrm_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_nrm_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((tgrid->size == 0) || (model->nrxns == 0))
+	{
+		for (size_t k = 0; k < tgrid->size; k++)
+			gsl_matrix_set_row (states, k, X0);
+		return GSL_SUCCESS;
+	}
+	sm_rngbuf_set (&w->rb, r);
+
+	gsl_vector * X = w->X;
+	gsl_vector * prop = w->prop;
+	double * x = X->data;
+	double * a = prop->data;
+	double * aold = w->oldprop->data;
+	double * par = w->par;
+	const sm_depgraph * g = w->graph;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+	int fast = (model->propensity_raw != NULL) && (model->propensity_update_raw != NULL)
+			&& (model->update_raw != NULL);
+
+	// Initial propensities and putative firing times
+	gsl_vector_memcpy (X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+	if (fast)
+		model->propensity_raw (x, par, a);
+	else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	for (size_t j = 0; j < model->nrxns; j++)
+		w->tau[j] = (a[j] > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a[j] : INFINITY;
+	ipq_build (w);
+
+	while (k < ntimes)
+	{
+		// The earliest putative time is at the top of the queue
+		size_t mu = w->heap[0];
+		double tnext = w->tau[mu];
+
+		// Record the current state at all the time points it covers
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_set_row (states, k, X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		// Keep the propensities that are about to change
+		for (size_t d = g->ptr[mu]; d < g->ptr[mu+1]; d++)
+			aold[g->idx[d]] = a[g->idx[d]];
+
+		// Fire the reaction, advance the time and refresh the propensities
+		t = tnext;
+		if (fast)
+		{
+			model->update_raw (x, mu);
+			model->propensity_update_raw (x, par, a, mu);
+		}
+		else
+		{
+			if (sm_stoich_update (model, X, mu) != GSL_SUCCESS)
+				return GSL_EFAILED;
+			if (model->propensity_update != NULL)
+			{
+				if (model->propensity_update (X, params, prop, mu) != GSL_SUCCESS)
+					return GSL_EFAILED;
+			}
+			else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+
+		// Reschedule only the reactions that depend on the one that fired
+		for (size_t d = g->ptr[mu]; d < g->ptr[mu+1]; d++)
+		{
+			size_t alpha = g->idx[d];
+
+			if (a[alpha] <= 0.0)
+				w->tau[alpha] = INFINITY;
+			else if ((alpha != mu) && (aold[alpha] > 0.0))
+				w->tau[alpha] = t + (aold[alpha] / a[alpha]) * (w->tau[alpha] - t);
+			else
+				w->tau[alpha] = t + sm_rngbuf_exponential (&w->rb) / a[alpha];
+
+			ipq_update (w, alpha);
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
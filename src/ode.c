@@ -0,0 +1,321 @@
+/*
+ *  ode.c
+ *  StochMod
+ *
+ *	Deterministic reaction rate equations
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Drift f = S * a(y) of the reaction rate equations, with the macroscopic
+ rates of the model (its propensities if it has none) and its stoichiometry
+ table.
+ */
+static int ode_drift (const stochmod * model, const gsl_vector * params, sm_ode_workspace * w,
+		const double * y, double * f)
+{
+	gsl_vector_const_view Y = gsl_vector_const_view_array (y, w->nspecies);
+	double * a = w->prop->data;
+
+	if (model->rate_raw != NULL)
+		model->rate_raw (y, w->par, a);
+	else if (w->fast)
+		model->propensity_raw (y, w->par, a);
+	else if (model->propensity (&Y.vector, params, w->prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	for (size_t i = 0; i < w->nspecies; i++)
+		f[i] = 0.0;
+	for (size_t j = 0; j < w->nrxns; j++)
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			f[model->stoich_idx[q]] += model->stoich_val[q] * a[j];
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Jacobian J = S * da/dy of the drift, row-major in the array J, from the
+ analytic rate Jacobian of the model (its propensity Jacobian if it has
+ none).
+ */
+static int ode_jac (const stochmod * model, const gsl_vector * params, sm_ode_workspace * w,
+		const double * y, double * J)
+{
+	size_t N = w->nspecies;
+	gsl_vector_const_view Y = gsl_vector_const_view_array (y, N);
+
+	int (* jac) (const gsl_vector *, const gsl_vector *, gsl_matrix *) =
+			(model->rate_jacobian != NULL) ? model->rate_jacobian : model->jacobian;
+	if (jac (&Y.vector, params, w->Ja) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	for (size_t i = 0; i < N*N; i++)
+		J[i] = 0.0;
+	for (size_t j = 0; j < w->nrxns; j++)
+	{
+		const double * row = w->Ja->data + j * w->Ja->tda;
+		for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+		{
+			double * Ji = J + model->stoich_idx[q] * N;
+			double v = model->stoich_val[q];
+			for (size_t k = 0; k < N; k++)
+				Ji[k] += v * row[k];
+		}
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Callbacks for gsl_odeiv2: the workspace is passed as the parameters of the
+ system, and holds the model and parameters of the current run.
+ */
+static int ode_function (double t, const double y[], double dydt[], void * params)
+{
+	sm_ode_workspace * w = params;
+	return ode_drift (w->model, w->params, w, y, dydt);
+}
+
+
+static int ode_jacobian (double t, const double y[], double * dfdy, double dfdt[], void * params)
+{
+	sm_ode_workspace * w = params;
+	for (size_t i = 0; i < w->nspecies; i++)
+		dfdt[i] = 0.0;
+	return ode_jac (w->model, w->params, w, y, dfdy);
+}
+
+
+/**
+ Allocate a workspace for the reaction rate equations of the given model. The
+ model must export its stoichiometry and its propensity Jacobian. The
+ equations are integrated with the stiff BDF stepper of gsl_odeiv2 by
+ default, see sm_ode_workspace_set to change it.
+ */
+sm_ode_workspace * sm_ode_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->jacobian == NULL))
+	{
+		fprintf (stderr, "error in sm_ode_workspace_alloc: model does not export its stoichiometry and Jacobian\n");
+		return NULL;
+	}
+
+	sm_ode_workspace * w = malloc (sizeof (sm_ode_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_ode_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	w->nspecies = N;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->Ja = gsl_matrix_alloc (model->nrxns, N);
+	w->y = malloc ((N + 1) * sizeof (double));
+	w->dy = malloc ((N + 1) * sizeof (double));
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->model = model;
+	w->params = NULL;
+	w->fast = 0;
+
+	// gsl_odeiv2 system and default driver
+	w->sys.function = ode_function;
+	w->sys.jacobian = ode_jacobian;
+	w->sys.dimension = N;
+	w->sys.params = w;
+	w->type = gsl_odeiv2_step_msbdf;
+	w->hstart = 1e-6;
+	w->epsabs = 1e-8;
+	w->epsrel = 1e-6;
+	w->driver = gsl_odeiv2_driver_alloc_y_new (&w->sys, w->type, w->hstart, w->epsabs, w->epsrel);
+
+	if ((w->prop == NULL) || (w->Ja == NULL) || (w->y == NULL) || (w->dy == NULL) || (w->par == NULL)
+			|| (w->driver == NULL))
+	{
+		fprintf (stderr, "error in sm_ode_workspace_alloc: failed to allocate workspace members\n");
+		sm_ode_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_ode_workspace_alloc.
+ */
+void sm_ode_workspace_free (sm_ode_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->Ja != NULL)
+		gsl_matrix_free (w->Ja);
+	if (w->driver != NULL)
+		gsl_odeiv2_driver_free (w->driver);
+	free (w->y);
+	free (w->dy);
+	free (w->par);
+	free (w);
+}
+
+
+/**
+ Change the stepper and the error tolerances used by sm_ode_run. Any
+ gsl_odeiv2 stepper can be used; the implicit ones (msbdf, bsimp, rk4imp...)
+ use the analytic Jacobian.
+ */
+int sm_ode_workspace_set (sm_ode_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel)
+{
+	gsl_odeiv2_driver * d = gsl_odeiv2_driver_alloc_y_new (&w->sys, T, w->hstart, epsabs, epsrel);
+	if (d == NULL)
+	{
+		fprintf (stderr, "error in sm_ode_workspace_set: failed to allocate driver\n");
+		return GSL_EFAILED;
+	}
+
+	gsl_odeiv2_driver_free (w->driver);
+	w->driver = d;
+	w->type = T;
+	w->epsabs = epsabs;
+	w->epsrel = epsrel;
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Evaluate the right hand side f = S * a(X) of the reaction rate equations of
+ the model in the state X and, if J is not NULL, its Jacobian J = S * da/dX.
+ */
+int sm_ode_eval (const stochmod * model, const gsl_vector * params, const gsl_vector * X, gsl_vector * f,
+		gsl_matrix * J, sm_ode_workspace * w)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ode_eval: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X->size != model->nspecies) || (f->size != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_ode_eval: vector sizes are not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((J != NULL) && ((J->size1 != model->nspecies) || (J->size2 != model->nspecies) || (J->tda != J->size2)))
+	{
+		fprintf (stderr, "error in sm_ode_eval: Jacobian matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	size_t N = model->nspecies;
+	for (size_t i = 0; i < N; i++)
+		w->y[i] = gsl_vector_get (X, i);
+
+	w->fast = 0;
+	if (ode_drift (model, params, w, w->y, w->dy) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	for (size_t i = 0; i < N; i++)
+		gsl_vector_set (f, i, w->dy[i]);
+
+	if ((J != NULL) && (ode_jac (model, params, w, w->y, J->data) != GSL_SUCCESS))
+		return GSL_EFAILED;
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Integrate the reaction rate equations dX/dt = S * a(X) of the model, with
+ the macroscopic (mass action) rates a given by model->rate_raw. These are
+ the propensities, except in the homodimerizations, where the rate k*X^2
+ replaces the propensity k*X*(X-1): the propensity would be negative for X
+ in (0,1), and biased for small X. Models without rate_raw and
+ rate_jacobian are integrated with their propensities.
+
+ Arguments and output are the same as in sm_ssa_direct_run, without the
+ random number generator. The states at the points of tgrid are found with
+ the gsl_odeiv2 driver of the workspace, which by default uses the stiff BDF
+ stepper with the analytic Jacobian of the model.
+ */
+int sm_ode_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ode_workspace * w)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ode_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_ode_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_ode_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+
+	size_t N = model->nspecies;
+	double * y = w->y;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->model = model;
+	w->params = params;
+	w->fast = (model->propensity_raw != NULL);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+	for (size_t i = 0; i < N; i++)
+		y[i] = gsl_vector_get (X0, i);
+	gsl_odeiv2_driver_reset (w->driver);
+
+	for (size_t k = 0; k < tgrid->size; k++)
+	{
+		double tk = gsl_vector_get (tgrid, k);
+		if (tk > t)
+		{
+			int status = gsl_odeiv2_driver_apply (w->driver, &t, tk, y);
+			if (status != GSL_SUCCESS)
+			{
+				fprintf (stderr, "error in sm_ode_run: integration failed at t = %g (status %d)\n", t, status);
+				return GSL_EFAILED;
+			}
+		}
+		for (size_t i = 0; i < N; i++)
+			gsl_matrix_set (states, k, i, y[i]);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,278 @@
+/*
+ *  philox.c
+ *  StochMod
+ *
+ *	Counter-based random number generator for reproducible parallel simulation
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <stdint.h>
+
+
+/**
+ === PHILOX4x32-10 ===
+ 	 The generator of Salmon, Moraes, Dror and Shaw (SC'11): the 128-bit
+ 	 counter (step / 4, trajectory id) is encrypted with the 64-bit key (seed)
+ 	 by 10 rounds of multiplications and xors, giving 4 random 32-bit words.
+ 	 Draw number step of a trajectory is then a pure function of (seed,
+ 	 trajectory id, step), so any trajectory can be regenerated alone and
+ 	 parallel simulations do not depend on how the work was scheduled. The
+ 	 generator passes the BigCrush battery of TestU01.
+
+ 	 It is exported as a gsl_rng type, so it can be passed to all the
+ 	 simulation engines and initial conditions of the models.
+  */
+
+// State of the generator
+typedef struct
+{
+	uint32_t key[2];
+	uint32_t ctr[4];
+	uint32_t out[4];
+	unsigned int pos;
+} philox_state;
+
+
+static void philox_block (philox_state * s)
+{
+	uint32_t c0 = s->ctr[0];
+	uint32_t c1 = s->ctr[1];
+	uint32_t c2 = s->ctr[2];
+	uint32_t c3 = s->ctr[3];
+	uint32_t k0 = s->key[0];
+	uint32_t k1 = s->key[1];
+
+	for (int round = 0; round < 10; round++)
+	{
+		uint64_t p0 = (uint64_t) 0xD2511F53U * c0;
+		uint64_t p1 = (uint64_t) 0xCD9E8D57U * c2;
+		uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1 ^ k0;
+		uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3 ^ k1;
+		c1 = (uint32_t) p1;
+		c3 = (uint32_t) p0;
+		c0 = n0;
+		c2 = n2;
+		k0 += 0x9E3779B9U;
+		k1 += 0xBB67AE85U;
+	}
+
+	s->out[0] = c0;
+	s->out[1] = c1;
+	s->out[2] = c2;
+	s->out[3] = c3;
+}
+
+
+// Number of blocks encrypted together by sm_rng_fill
+#define PHILOX_LANES 16
+
+/**
+ Encrypt the PHILOX_LANES consecutive counters that start at (base, ctr[2],
+ ctr[3]) with the key of s, and write their blocks one after the other in out.
+ The rounds run on all the lanes at once, so that the compiler vectorizes them.
+ */
+static void philox_lanes (const philox_state * s, uint64_t base, uint32_t * out)
+{
+	uint32_t c0[PHILOX_LANES], c1[PHILOX_LANES], c2[PHILOX_LANES], c3[PHILOX_LANES];
+	uint32_t k0 = s->key[0];
+	uint32_t k1 = s->key[1];
+
+	for (int l = 0; l < PHILOX_LANES; l++)
+	{
+		uint64_t n = base + (uint64_t) l;
+		c0[l] = (uint32_t) n;
+		c1[l] = (uint32_t) (n >> 32);
+		c2[l] = s->ctr[2];
+		c3[l] = s->ctr[3];
+	}
+
+	for (int round = 0; round < 10; round++)
+	{
+		for (int l = 0; l < PHILOX_LANES; l++)
+		{
+			uint64_t p0 = (uint64_t) 0xD2511F53U * c0[l];
+			uint64_t p1 = (uint64_t) 0xCD9E8D57U * c2[l];
+			uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1[l] ^ k0;
+			uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3[l] ^ k1;
+			c1[l] = (uint32_t) p1;
+			c3[l] = (uint32_t) p0;
+			c0[l] = n0;
+			c2[l] = n2;
+		}
+		k0 += 0x9E3779B9U;
+		k1 += 0xBB67AE85U;
+	}
+
+	for (int l = 0; l < PHILOX_LANES; l++)
+	{
+		out[4*l] = c0[l];
+		out[4*l+1] = c1[l];
+		out[4*l+2] = c2[l];
+		out[4*l+3] = c3[l];
+	}
+}
+
+
+static void philox_set (void * state, unsigned long seed)
+{
+	philox_state * s = state;
+	s->key[0] = (uint32_t) seed;
+	s->key[1] = (uint32_t) ((unsigned long long) seed >> 32);
+	for (int i = 0; i < 4; i++)
+		s->ctr[i] = 0;
+	s->pos = 0;
+	philox_block (s);
+}
+
+
+static unsigned long philox_get (void * state)
+{
+	philox_state * s = state;
+	if (s->pos == 4)
+	{
+		// Next block of the same trajectory
+		if (++s->ctr[0] == 0)
+			s->ctr[1]++;
+		s->pos = 0;
+		philox_block (s);
+	}
+	return s->out[s->pos++];
+}
+
+
+static double philox_get_double (void * state)
+{
+	return philox_get (state) / 4294967296.0;
+}
+
+
+static const gsl_rng_type philox_type = {
+	"philox4x32-10",
+	0xffffffffUL,
+	0,
+	sizeof (philox_state),
+	&philox_set,
+	&philox_get,
+	&philox_get_double
+};
+
+const gsl_rng_type * sm_rng_philox = &philox_type;
+
+
+/**
+ Position a generator of type sm_rng_philox at the first draw of trajectory
+ id in the ensemble with the given seed.
+ */
+int sm_rng_key (const gsl_rng * r, unsigned long seed, unsigned long long id)
+{
+	if (r->type != sm_rng_philox)
+	{
+		fprintf (stderr, "error in sm_rng_key: generator is not of type sm_rng_philox\n");
+		return GSL_EFAILED;
+	}
+
+	philox_state * s = r->state;
+	philox_set (s, seed);
+	s->ctr[2] = (uint32_t) id;
+	s->ctr[3] = (uint32_t) (id >> 32);
+	philox_block (s);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Move a generator of type sm_rng_philox to draw number step of its current
+ trajectory, without generating the draws in between.
+ */
+int sm_rng_seek (const gsl_rng * r, unsigned long long step)
+{
+	if (r->type != sm_rng_philox)
+	{
+		fprintf (stderr, "error in sm_rng_seek: generator is not of type sm_rng_philox\n");
+		return GSL_EFAILED;
+	}
+
+	philox_state * s = r->state;
+	s->ctr[0] = (uint32_t) (step >> 2);
+	s->ctr[1] = (uint32_t) (step >> 34);
+	s->pos = (unsigned int) (step & 3);
+	philox_block (s);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Number of draws taken from a generator of type sm_rng_philox since the
+ start of its current trajectory.
+ */
+unsigned long long sm_rng_step (const gsl_rng * r)
+{
+	const philox_state * s = r->state;
+	return ((((unsigned long long) s->ctr[1] << 32) | s->ctr[0]) << 2) + s->pos;
+}
+
+
+/**
+ Fill words with the next n 32-bit draws of r. The draws of a generator of
+ type sm_rng_philox are the same as those of n calls to gsl_rng_get, but are
+ computed PHILOX_LANES blocks at a time; other generators are called once per
+ word (twice if their range is narrower than 32 bits).
+ */
+void sm_rng_fill (const gsl_rng * r, uint32_t * words, size_t n)
+{
+	size_t i = 0;
+
+	if (r->type != sm_rng_philox)
+	{
+		unsigned long min = r->type->min;
+		if (r->type->max - min >= 0xffffffffUL)
+			for (i = 0; i < n; i++)
+				words[i] = (uint32_t) (gsl_rng_get (r) - min);
+		else
+			for (i = 0; i < n; i++)
+				words[i] = ((uint32_t) gsl_rng_uniform_int (r, 65536) << 16)
+						| (uint32_t) gsl_rng_uniform_int (r, 65536);
+		return;
+	}
+
+	philox_state * s = r->state;
+
+	// Rest of the current block
+	while ((i < n) && (s->pos < 4))
+		words[i++] = s->out[s->pos++];
+
+	// Whole groups of blocks, written straight to the output
+	uint64_t ctr = ((uint64_t) s->ctr[1] << 32) | s->ctr[0];
+	while (n - i >= 4 * PHILOX_LANES)
+	{
+		philox_lanes (s, ctr + 1, words + i);
+		ctr += PHILOX_LANES;
+		i += 4 * PHILOX_LANES;
+	}
+	s->ctr[0] = (uint32_t) ctr;
+	s->ctr[1] = (uint32_t) (ctr >> 32);
+
+	// The last words one block at a time
+	while (i < n)
+		words[i++] = (uint32_t) philox_get (s);
+}
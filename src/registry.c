@@ -0,0 +1,164 @@
+/*
+ *  registry.c
+ *  StochMod
+ *
+ *	Setup of the models listed in STOCHASTIC_MODEL
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Clear all the members of a model: the callbacks and tables are set to NULL
+ and the sizes to zero. Models filled by hand must start from here, so that
+ the optional members they do not provide are NULL.
+ */
+void stochmod_init (stochmod * model)
+{
+	model->propensity = NULL;
+	model->update = NULL;
+	model->initial = NULL;
+	model->output = NULL;
+	model->nspecies = 0;
+	model->nrxns = 0;
+	model->nparams = 0;
+	model->nin = 0;
+	model->nout = 0;
+	model->name = NULL;
+	model->propensity_update = NULL;
+	model->jacobian = NULL;
+	model->hessian = NULL;
+	model->propensity_raw = NULL;
+	model->propensity_update_raw = NULL;
+	model->update_raw = NULL;
+	model->propensity_lanes = NULL;
+	model->propensity_int = NULL;
+	model->propensity_update_int = NULL;
+	model->update_int = NULL;
+	model->initial_int = NULL;
+	model->output_int = NULL;
+	model->stoich_ptr = NULL;
+	model->stoich_idx = NULL;
+	model->stoich_val = NULL;
+	model->react_ptr = NULL;
+	model->react_idx = NULL;
+	model->react_val = NULL;
+	model->graph = NULL;
+	model->rate_raw = NULL;
+	model->rate_jacobian = NULL;
+}
+
+
+/**
+ Set up the model identified by id and attach its reaction dependency graph.
+ Models set up this way must be released with stochmod_free.
+ */
+int stochmod_setup (stochmod * model, STOCHASTIC_MODEL id)
+{
+	stochmod_init (model);
+
+	switch (id)
+	{
+	case MODEL_SYNCIRC:
+		syncirc_mod_setup (model);
+		break;
+
+	case MODEL_STOCHREP:
+		stochrep_mod_setup (model);
+		break;
+
+	case MODEL_AUTOREG:
+		autoreg_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP:
+		lacgfp_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP2:
+		lacgfp2_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP3:
+		lacgfp3_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP4:
+		lacgfp4_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP5:
+		lacgfp5_mod_setup (model);
+		break;
+
+	case MODEL_BIRTHDEATH:
+		birthdeath_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP6:
+		lacgfp6_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP7:
+		lacgfp7_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP8:
+		lacgfp8_mod_setup (model);
+		break;
+
+	case MODEL_IFF:
+		iff_mod_setup (model);
+		break;
+
+	case MODEL_FBK:
+		fbk_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP9:
+		lacgfp9_mod_setup (model);
+		break;
+
+	case MODEL_LACGFP10:
+		lacgfp10_mod_setup (model);
+		break;
+
+	case MODEL_SYNPI1:
+		synpi1_mod_setup (model);
+		break;
+
+	default:
+		fprintf (stderr, "error in stochmod_setup: model id %d is not correct\n", (int) id);
+		return GSL_EFAILED;
+	}
+
+	return sm_depgraph_attach (model);
+}
+
+
+/**
+ Release the memory attached to a model by stochmod_setup.
+ */
+void stochmod_free (stochmod * model)
+{
+	sm_depgraph_free (model->graph);
+	model->graph = NULL;
+	model->rate_raw = NULL;
+	model->rate_jacobian = NULL;
+}
@@ -0,0 +1,315 @@
+/*
+ *  rngbuf.c
+ *  StochMod
+ *
+ *	Buffered generation of random variates for the simulation engines
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <string.h>
+#include <pthread.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_randist.h>
+
+
+/**
+ === RANDOM VARIATE BUFFERS ===
+ 	 Every step of the SSA engines takes an exponential and a uniform variate,
+ 	 and for small models the indirect calls of gsl_rng_uniform and the log of
+ 	 the exponential are a good part of the cost of a step. The engines take
+ 	 their variates from a sm_rngbuf instead, whose buffers are refilled
+ 	 SM_RNGBUF_SIZE at a time: the raw 32-bit words come from one call to
+ 	 sm_rng_fill (whole Philox blocks for sm_rng_philox), and are turned into
+ 	 variates by loops over the block that the compiler vectorizes.
+
+ 	 Exponential and gaussian variates use the ziggurat method of Marsaglia and
+ 	 Tsang (2000), with 256 and 128 layers. The low bits of a word pick a layer
+ 	 (and the sign for the gaussian) and its top 24 bits a point in the layer,
+ 	 which is accepted with no transcendental function about 99% of the time:
+ 	 all the lanes of a block are computed that way, and the few rejected ones
+ 	 are drawn again in a second pass. Poisson and binomial variates with small
+ 	 means are inverted on the buffered uniforms.
+
+ 	 The buffers are emptied by sm_rngbuf_set at the start of every run, so the
+ 	 draws of a run only depend on the state of the generator when it starts.
+ */
+
+// Scale of the 24-bit abscissae of the ziggurats
+#define ZIG_M 16777216.0
+
+// Right end of the base layers of the ziggurats
+#define ZIG_RE 7.697117470131487
+#define ZIG_RN 3.442619855899
+
+// Means below which the Poisson and binomial variates are found by inversion
+#define RNGBUF_INVMAX 10.0
+
+// Tables of the ziggurats: thresholds of acceptance, widths and heights of the layers
+static uint32_t zig_ke[256];
+static double zig_we[256];
+static double zig_fe[256];
+static uint32_t zig_kn[128];
+static double zig_wn[128];
+static double zig_fn[128];
+static pthread_once_t zig_once = PTHREAD_ONCE_INIT;
+
+
+static void zig_tables (void)
+{
+	// Exponential, layers of area ve
+	double de = ZIG_RE, te = ZIG_RE, ve = 3.949659822581572e-3;
+	double q = ve / exp (-de);
+	zig_ke[0] = (uint32_t) ((de / q) * ZIG_M);
+	zig_ke[1] = 0;
+	zig_we[0] = q / ZIG_M;
+	zig_we[255] = de / ZIG_M;
+	zig_fe[0] = 1.0;
+	zig_fe[255] = exp (-de);
+	for (int i = 254; i >= 1; i--)
+	{
+		de = -log (ve / de + exp (-de));
+		zig_ke[i+1] = (uint32_t) ((de / te) * ZIG_M);
+		te = de;
+		zig_fe[i] = exp (-de);
+		zig_we[i] = de / ZIG_M;
+	}
+
+	// Gaussian, layers of area vn
+	double dn = ZIG_RN, tn = ZIG_RN, vn = 9.91256303526217e-3;
+	q = vn / exp (-0.5 * dn * dn);
+	zig_kn[0] = (uint32_t) ((dn / q) * ZIG_M);
+	zig_kn[1] = 0;
+	zig_wn[0] = q / ZIG_M;
+	zig_wn[127] = dn / ZIG_M;
+	zig_fn[0] = 1.0;
+	zig_fn[127] = exp (-0.5 * dn * dn);
+	for (int i = 126; i >= 1; i--)
+	{
+		dn = sqrt (-2.0 * log (vn / dn + exp (-0.5 * dn * dn)));
+		zig_kn[i+1] = (uint32_t) ((dn / tn) * ZIG_M);
+		tn = dn;
+		zig_fn[i] = exp (-0.5 * dn * dn);
+		zig_wn[i] = dn / ZIG_M;
+	}
+}
+
+
+/**
+ Exponential variate for a word that fell outside of its layer.
+ */
+static double zig_exponential (const gsl_rng * r, uint32_t word)
+{
+	for (;;)
+	{
+		uint32_t i = word & 255;
+		uint32_t j = word >> 8;
+		if (j < zig_ke[i])
+			return j * zig_we[i];
+
+		// Tail beyond the base layer
+		if (i == 0)
+			return ZIG_RE - log (gsl_rng_uniform_pos (r));
+
+		// Wedge of the layer
+		double x = j * zig_we[i];
+		if (zig_fe[i] + gsl_rng_uniform (r) * (zig_fe[i-1] - zig_fe[i]) < exp (-x))
+			return x;
+
+		sm_rng_fill (r, &word, 1);
+	}
+}
+
+
+/**
+ Gaussian variate for a word that fell outside of its layer.
+ */
+static double zig_gaussian (const gsl_rng * r, uint32_t word)
+{
+	for (;;)
+	{
+		uint32_t i = word & 127;
+		uint32_t j = word >> 8;
+		double sign = (word & 128) ? -1.0 : 1.0;
+		if (j < zig_kn[i])
+			return sign * j * zig_wn[i];
+
+		// Tail beyond the base layer, by Marsaglia's method
+		if (i == 0)
+		{
+			double x, y;
+			do
+			{
+				x = -log (gsl_rng_uniform_pos (r)) / ZIG_RN;
+				y = -log (gsl_rng_uniform_pos (r));
+			} while (y + y < x * x);
+			return sign * (ZIG_RN + x);
+		}
+
+		// Wedge of the layer
+		double x = j * zig_wn[i];
+		if (zig_fn[i] + gsl_rng_uniform (r) * (zig_fn[i-1] - zig_fn[i]) < exp (-0.5 * x * x))
+			return sign * x;
+
+		sm_rng_fill (r, &word, 1);
+	}
+}
+
+
+/**
+ Take the variates of b from the generator r, discarding those left in the
+ buffers.
+ */
+void sm_rngbuf_set (sm_rngbuf * b, const gsl_rng * r)
+{
+	b->r = r;
+	b->nu = 0;
+	b->ne = 0;
+	b->ng = 0;
+}
+
+
+/**
+ Refill the buffer of uniform variates in (0,1).
+ */
+void sm_rngbuf_refill_uniform (sm_rngbuf * b)
+{
+	uint32_t w[SM_RNGBUF_SIZE];
+	sm_rng_fill (b->r, w, SM_RNGBUF_SIZE);
+
+	for (size_t i = 0; i < SM_RNGBUF_SIZE; i++)
+		b->u[i] = (w[i] + 0.5) * 2.3283064365386963e-10;
+	b->nu = SM_RNGBUF_SIZE;
+}
+
+
+/**
+ Refill the buffer of exponential variates of unit mean.
+ */
+void sm_rngbuf_refill_exponential (sm_rngbuf * b)
+{
+	uint32_t w[SM_RNGBUF_SIZE];
+	pthread_once (&zig_once, zig_tables);
+	sm_rng_fill (b->r, w, SM_RNGBUF_SIZE);
+
+	// All the lanes as if the points fell inside their layers
+	for (size_t i = 0; i < SM_RNGBUF_SIZE; i++)
+		b->e[i] = (w[i] >> 8) * zig_we[w[i] & 255];
+
+	// Then the few that did not
+	for (size_t i = 0; i < SM_RNGBUF_SIZE; i++)
+		if ((w[i] >> 8) >= zig_ke[w[i] & 255])
+			b->e[i] = zig_exponential (b->r, w[i]);
+	b->ne = SM_RNGBUF_SIZE;
+}
+
+
+/**
+ Refill the buffer of standard gaussian variates.
+ */
+void sm_rngbuf_refill_gaussian (sm_rngbuf * b)
+{
+	uint32_t w[SM_RNGBUF_SIZE];
+	pthread_once (&zig_once, zig_tables);
+	sm_rng_fill (b->r, w, SM_RNGBUF_SIZE);
+
+	// All the lanes as if the points fell inside their layers, bit 7 is the sign
+	for (size_t i = 0; i < SM_RNGBUF_SIZE; i++)
+		b->g[i] = (1.0 - (double) ((w[i] >> 6) & 2)) * (w[i] >> 8) * zig_wn[w[i] & 127];
+
+	// Then the few that did not
+	for (size_t i = 0; i < SM_RNGBUF_SIZE; i++)
+		if ((w[i] >> 8) >= zig_kn[w[i] & 127])
+			b->g[i] = zig_gaussian (b->r, w[i]);
+	b->ng = SM_RNGBUF_SIZE;
+}
+
+
+/**
+ Copy the next n standard gaussian variates of b in x.
+ */
+void sm_rngbuf_gaussians (sm_rngbuf * b, double * x, size_t n)
+{
+	while (n > 0)
+	{
+		if (b->ng == 0)
+			sm_rngbuf_refill_gaussian (b);
+		size_t m = GSL_MIN (n, b->ng);
+		b->ng -= m;
+		memcpy (x, b->g + b->ng, m * sizeof (double));
+		x += m;
+		n -= m;
+	}
+}
+
+
+/**
+ Poisson variate of mean mu. Small means are inverted on one buffered
+ uniform, the others are drawn by gsl_ran_poisson.
+ */
+unsigned int sm_rngbuf_poisson (sm_rngbuf * b, double mu)
+{
+	if (mu <= 0.0)
+		return 0;
+	if (mu >= RNGBUF_INVMAX)
+		return gsl_ran_poisson (b->r, mu);
+
+	double u = sm_rngbuf_uniform (b);
+	double p = exp (-mu);
+	double F = p;
+	unsigned int k = 0;
+	while ((u > F) && (p > 0.0))
+	{
+		k++;
+		p *= mu / k;
+		F += p;
+	}
+	return k;
+}
+
+
+/**
+ Binomial variate of n trials with success probability p. Small means are
+ inverted on one buffered uniform, the others are drawn by gsl_ran_binomial.
+ */
+unsigned int sm_rngbuf_binomial (sm_rngbuf * b, double p, unsigned int n)
+{
+	if ((p <= 0.0) || (n == 0))
+		return 0;
+	if (p >= 1.0)
+		return n;
+
+	// Count the failures when they are the rarer outcome
+	if (p > 0.5)
+		return n - sm_rngbuf_binomial (b, 1.0 - p, n);
+	if (n * p >= RNGBUF_INVMAX)
+		return gsl_ran_binomial (b->r, p, n);
+
+	double u = sm_rngbuf_uniform (b);
+	double s = p / (1.0 - p);
+	double f = pow (1.0 - p, n);
+	double F = f;
+	unsigned int k = 0;
+	while ((u > F) && (k < n))
+	{
+		f *= s * (n - k) / (k + 1);
+		k++;
+		F += f;
+	}
+	return k;
+}
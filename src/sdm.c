@@ -0,0 +1,242 @@
+/*
+ *  sdm.c
+ *  StochMod
+ *
+ *	Sorting direct method simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Allocate a workspace for the sorting direct method that fits the given model.
+ The search order starts as the declaration order of the reactions.
+ */
+sm_sdm_workspace * sm_sdm_workspace_alloc (const stochmod * model)
+{
+	sm_sdm_workspace * w = malloc (sizeof (sm_sdm_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_sdm_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (model->nspecies);
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->order = malloc ((model->nrxns + 1) * sizeof (size_t));
+	w->nfired = calloc (model->nrxns + 1, sizeof (unsigned long));
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->par == NULL) || (w->order == NULL) || (w->nfired == NULL))
+	{
+		fprintf (stderr, "error in sm_sdm_workspace_alloc: failed to allocate workspace members\n");
+		sm_sdm_workspace_free (w);
+		return NULL;
+	}
+
+	for (size_t j = 0; j < model->nrxns; j++)
+		w->order[j] = j;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_sdm_workspace_alloc.
+ */
+void sm_sdm_workspace_free (sm_sdm_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	free (w->par);
+	free (w->order);
+	free (w->nfired);
+	free (w);
+}
+
+
+/**
+ Copy the search order learned so far into p: p(0) is the reaction that is
+ checked first. The order can be saved (e.g. with gsl_permutation_fwrite) and
+ given back to sm_sdm_set_order to start later runs of the same model from it.
+ */
+int sm_sdm_get_order (const sm_sdm_workspace * w, gsl_permutation * p)
+{
+	if (p->size != w->nrxns)
+	{
+		fprintf (stderr, "error in sm_sdm_get_order: permutation size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	for (size_t i = 0; i < w->nrxns; i++)
+		p->data[i] = w->order[i];
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Set the search order of the workspace, e.g. to one saved from a previous
+ session. The firing counters are reset.
+ */
+int sm_sdm_set_order (sm_sdm_workspace * w, const gsl_permutation * p)
+{
+	if ((p->size != w->nrxns) || (gsl_permutation_valid (p) != GSL_SUCCESS))
+	{
+		fprintf (stderr, "error in sm_sdm_set_order: not a valid order for this workspace\n");
+		return GSL_EFAILED;
+	}
+
+	for (size_t i = 0; i < w->nrxns; i++)
+	{
+		w->order[i] = gsl_permutation_get (p, i);
+		w->nfired[i] = 0;
+	}
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Simulate one trajectory of the model with the sorting direct method of
+ McCollum et al.
+
+ Arguments and output are the same as in sm_ssa_direct_run. The reaction that
+ fires is searched following the order stored in the workspace, and each time
+ a reaction fires it is swapped with the one before it. Reactions that fire
+ often thus move to the front and are found after few comparisons. The order
+ is kept in the workspace across runs, together with the number of times each
+ reaction fired, so that the learning carries over to the next trajectories.
+ */
+int sm_sdm_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_sdm_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_sdm_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_sdm_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_sdm_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	gsl_vector * X = w->X;
+	gsl_vector * prop = w->prop;
+	double * x = X->data;
+	double * a = prop->data;
+	double * par = w->par;
+	size_t * order = w->order;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+	int fast = (model->propensity_raw != NULL) && (model->propensity_update_raw != NULL)
+			&& (model->update_raw != NULL);
+
+	gsl_vector_memcpy (X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+	if (fast)
+		model->propensity_raw (x, par, a);
+	else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	while (k < ntimes)
+	{
+		double a0 = 0.0;
+		for (size_t j = 0; j < R; j++)
+			a0 += a[j];
+
+		// Time of the next reaction (infinite if the process has stopped)
+		double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+
+		// Record the current state at all the time points it covers
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_set_row (states, k, X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		// Select the reaction that fires by linear search in the current order
+		double target = a0 * sm_rngbuf_uniform (&w->rb);
+		double cumsum = 0.0;
+		size_t pos = R;
+		for (size_t i = 0; i < R; i++)
+		{
+			if (a[order[i]] <= 0.0)
+				continue;
+			pos = i;
+			cumsum += a[order[i]];
+			if (target < cumsum)
+				break;
+		}
+		size_t rxnid = order[pos];
+
+		// Move the reaction one step towards the front of the order
+		w->nfired[rxnid]++;
+		if (pos > 0)
+		{
+			order[pos] = order[pos-1];
+			order[pos-1] = rxnid;
+		}
+
+		// Fire the reaction, advance the time and refresh the propensities
+		t = tnext;
+		if (fast)
+		{
+			model->update_raw (x, rxnid);
+			model->propensity_update_raw (x, par, a, rxnid);
+			continue;
+		}
+		if (sm_stoich_update (model, X, rxnid) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		if (model->propensity_update != NULL)
+		{
+			if (model->propensity_update (X, params, prop, rxnid) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+		else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+			return GSL_EFAILED;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/*
+ *  ssa.c
+ *  StochMod
+ *
+ *	Gillespie direct-method simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Allocate a workspace for the SSA engines that fits the given model.
+ */
+sm_ssa_workspace * sm_ssa_workspace_alloc (const stochmod * model)
+{
+	sm_ssa_workspace * w = malloc (sizeof (sm_ssa_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_ssa_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	w->X = gsl_vector_alloc (model->nspecies);
+	w->prop = gsl_vector_alloc (model->nrxns);
+	w->Xint = gsl_vector_int_alloc (model->nspecies);
+	w->par = malloc ((model->nparams + model->nin + 1) * sizeof (double));
+	w->nspecies = model->nspecies;
+	w->nrxns = model->nrxns;
+	w->npar = model->nparams + model->nin;
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->Xint == NULL) || (w->par == NULL))
+	{
+		fprintf (stderr, "error in sm_ssa_workspace_alloc: failed to allocate workspace vectors\n");
+		sm_ssa_workspace_free (w);
+		return NULL;
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_ssa_workspace_alloc.
+ */
+void sm_ssa_workspace_free (sm_ssa_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	if (w->Xint != NULL)
+		gsl_vector_int_free (w->Xint);
+	free (w->par);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the model with Gillespie's direct method.
+
+ The simulation starts from X0 at time tgrid(0) and the state of the process
+ at each time point of tgrid (which must be non-decreasing) is written in the
+ corresponding row of states. All the memory needed by the simulation is
+ taken from the workspace, so no allocation takes place inside the loop.
+ Models that provide the _raw callbacks are simulated on the contiguous
+ workspace arrays, without any per-step check. The random variates come in
+ blocks from the buffers of the workspace, refilled from r (see rngbuf.c).
+ */
+int sm_ssa_direct_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ssa_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	gsl_vector * X = w->X;
+	gsl_vector * prop = w->prop;
+	double * x = X->data;
+	double * a = prop->data;
+	double * par = w->par;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+	int fast = (model->propensity_raw != NULL) && (model->propensity_update_raw != NULL)
+			&& (model->update_raw != NULL);
+
+	// The workspace vectors are contiguous, the parameters are copied so that they are too
+	gsl_vector_memcpy (X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+	if (fast)
+		model->propensity_raw (x, par, a);
+	else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+		return GSL_EFAILED;
+
+	while (k < ntimes)
+	{
+		double a0 = 0.0;
+		for (size_t j = 0; j < R; j++)
+			a0 += a[j];
+
+		// Time of the next reaction (infinite if the process has stopped)
+		double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+
+		// Record the current state at all the time points it covers
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_set_row (states, k, X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		// Select the reaction that fires by linear search
+		double target = a0 * sm_rngbuf_uniform (&w->rb);
+		double cumsum = 0.0;
+		size_t rxnid = R;
+		for (size_t j = 0; j < R; j++)
+		{
+			if (a[j] <= 0.0)
+				continue;
+			rxnid = j;
+			cumsum += a[j];
+			if (target < cumsum)
+				break;
+		}
+
+		// Fire the reaction, advance the time and refresh the propensities
+		t = tnext;
+		if (fast)
+		{
+			model->update_raw (x, rxnid);
+			model->propensity_update_raw (x, par, a, rxnid);
+			continue;
+		}
+		if (sm_stoich_update (model, X, rxnid) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		if (model->propensity_update != NULL)
+		{
+			if (model->propensity_update (X, params, prop, rxnid) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+		else if (model->propensity (X, params, prop) != GSL_SUCCESS)
+			return GSL_EFAILED;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Simulate one trajectory of the model with Gillespie's direct method, keeping
+ the populations as integers.
+
+ Same as sm_ssa_direct_run, with the initial state and the recorded states
+ stored as integers. The model must provide the _int callbacks.
+ */
+int sm_ssa_direct_run_int (const stochmod * model, const gsl_vector * params, const gsl_vector_int * X0,
+		const gsl_vector * tgrid, gsl_matrix_int * states, sm_ssa_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run_int: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run_int: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if ((model->propensity_int == NULL) || (model->propensity_update_int == NULL) || (model->update_int == NULL))
+	{
+		fprintf (stderr, "error in sm_ssa_direct_run_int: model does not support integer states\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	gsl_vector_int * X = w->Xint;
+	int * x = X->data;
+	double * a = w->prop->data;
+	double * par = w->par;
+	size_t R = model->nrxns;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	gsl_vector_int_memcpy (X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		par[i] = gsl_vector_get (params, i);
+	model->propensity_int (x, par, a);
+
+	while (k < ntimes)
+	{
+		double a0 = 0.0;
+		for (size_t j = 0; j < R; j++)
+			a0 += a[j];
+
+		// Time of the next reaction (infinite if the process has stopped)
+		double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+
+		// Record the current state at all the time points it covers
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_int_set_row (states, k, X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		// Select the reaction that fires by linear search
+		double target = a0 * sm_rngbuf_uniform (&w->rb);
+		double cumsum = 0.0;
+		size_t rxnid = R;
+		for (size_t j = 0; j < R; j++)
+		{
+			if (a[j] <= 0.0)
+				continue;
+			rxnid = j;
+			cumsum += a[j];
+			if (target < cumsum)
+				break;
+		}
+
+		// Fire the reaction, advance the time and refresh the propensities
+		t = tnext;
+		model->update_int (x, rxnid);
+		model->propensity_update_int (x, par, a, rxnid);
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
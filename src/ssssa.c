@@ -0,0 +1,470 @@
+/*
+ *  ssssa.c
+ *  StochMod
+ *
+ *	Slow-scale SSA simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <limits.h>
+#include <gsl/gsl_math.h>
+
+
+/**
+ Evaluate all the propensities in the state x into a.
+ */
+static int ss_propensity (const stochmod * model, const gsl_vector * params, sm_ss_workspace * w,
+		double * x, double * a)
+{
+	if (w->fast)
+	{
+		model->propensity_raw (x, w->par, a);
+		return GSL_SUCCESS;
+	}
+
+	gsl_vector_view X = gsl_vector_view_array (x, w->nspecies);
+	gsl_vector_view A = gsl_vector_view_array (a, w->nrxns);
+	return model->propensity (&X.vector, params, &A.vector);
+}
+
+
+/**
+ Move the state x0 along the forward reaction of pair p by n firings (n can be
+ negative, which means firings of the reverse reaction), writing into x.
+ */
+static void ss_shift (const stochmod * model, const sm_ss_workspace * w, size_t p, const double * x0,
+		double * x, long n)
+{
+	size_t j = w->pair_fwd[p];
+	for (size_t i = 0; i < w->nspecies; i++)
+		x[i] = x0[i];
+	for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+		x[model->stoich_idx[q]] += (double) n * model->stoich_val[q];
+}
+
+
+/**
+ Check whether the stationary distribution of the extent of pair p increases
+ from n to n+1, that is a_fwd(x(n)) >= a_rev(x(n+1)). It never does at the
+ upper end hi of the feasible range.
+ */
+static int ss_goes_up (const stochmod * model, const gsl_vector * params, sm_ss_workspace * w,
+		size_t p, long hi, long n, int * up)
+{
+	*up = 0;
+	if (n >= hi)
+		return GSL_SUCCESS;
+
+	ss_shift (model, w, p, w->X->data, w->Xt, n);
+	if (ss_propensity (model, params, w, w->Xt, w->at) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	double afwd = w->at[w->pair_fwd[p]];
+	ss_shift (model, w, p, w->X->data, w->Xt, n + 1);
+	if (ss_propensity (model, params, w, w->Xt, w->at) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	*up = (afwd > 0.0) && (afwd >= w->at[w->pair_rev[p]]);
+
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stationary distribution of the extent of fast pair p, given the rest of the
+ state. The extent n is the number of net firings of the forward reaction from
+ the current state; it is a birth-death chain with detailed balance
+ 	 pi(n+1) / pi(n) = a_fwd(x(n)) / a_rev(x(n+1)).
+ The distribution is computed on a window of at most w->maxrange + 1 values
+ around its mode and stored in w->weight, normalized, for n = nlo ... nlo+len-1.
+ */
+static int ss_equilibrium (const stochmod * model, const gsl_vector * params, sm_ss_workspace * w,
+		size_t p, long * nlo, size_t * len)
+{
+	size_t j = w->pair_fwd[p];
+	size_t k = w->pair_rev[p];
+	double * x = w->X->data;
+	double * xt = w->Xt;
+	double * at = w->at;
+
+	// Feasible range of the extent
+	long lo = LONG_MIN / 4;
+	long hi = LONG_MAX / 4;
+	for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+	{
+		int v = model->stoich_val[q];
+		long xi = (long) x[model->stoich_idx[q]];
+		if (v < 0)
+			hi = GSL_MIN (hi, xi / (-v));
+		else if (v > 0)
+			lo = GSL_MAX (lo, -(xi / v));
+	}
+
+	// Mode: first n where the chain stops going up, by exponential and binary search
+	int up;
+	long a = 0;
+	long b = 0;
+	if (ss_goes_up (model, params, w, p, hi, 0, &up) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (up)
+	{
+		for (long step = 1; up; step *= 2)
+		{
+			a = b;
+			b = GSL_MIN (a + step, hi);
+			if (ss_goes_up (model, params, w, p, hi, b, &up) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+	}
+	else
+	{
+		for (long step = 1; !up && (a > lo); step *= 2)
+		{
+			b = a;
+			a = GSL_MAX (b - step, lo);
+			if (ss_goes_up (model, params, w, p, hi, a, &up) != GSL_SUCCESS)
+				return GSL_EFAILED;
+		}
+		if (!up)
+			b = a;
+	}
+	while (b - a > 1)
+	{
+		long n = a + (b - a) / 2;
+		if (ss_goes_up (model, params, w, p, hi, n, &up) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		if (up)
+			a = n;
+		else
+			b = n;
+	}
+	long mode = b;
+
+	// Window around the mode
+	long wlo = GSL_MAX (lo, mode - (long) w->maxrange / 2);
+	long whi = GSL_MIN (hi, wlo + (long) w->maxrange);
+	wlo = GSL_MAX (lo, whi - (long) w->maxrange);
+	size_t m = (size_t) (whi - wlo + 1);
+
+	// Log weights relative to the mode, walking outwards
+	double * lw = w->weight;
+	lw[mode - wlo] = 0.0;
+	for (long n = mode; n < whi; n++)
+	{
+		ss_shift (model, w, p, x, xt, n);
+		if (ss_propensity (model, params, w, xt, at) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		double afwd = at[j];
+		ss_shift (model, w, p, x, xt, n + 1);
+		if (ss_propensity (model, params, w, xt, at) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		lw[n + 1 - wlo] = ((afwd > 0.0) && (at[k] > 0.0)) ? lw[n - wlo] + log (afwd) - log (at[k]) : -INFINITY;
+	}
+	for (long n = mode; n > wlo; n--)
+	{
+		ss_shift (model, w, p, x, xt, n - 1);
+		if (ss_propensity (model, params, w, xt, at) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		double afwd = at[j];
+		ss_shift (model, w, p, x, xt, n);
+		if (ss_propensity (model, params, w, xt, at) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		lw[n - 1 - wlo] = ((afwd > 0.0) && (at[k] > 0.0)) ? lw[n - wlo] - log (afwd) + log (at[k]) : -INFINITY;
+	}
+
+	double sum = 0.0;
+	for (size_t i = 0; i < m; i++)
+	{
+		lw[i] = exp (lw[i]);
+		sum += lw[i];
+	}
+	for (size_t i = 0; i < m; i++)
+		lw[i] /= sum;
+
+	*nlo = wlo;
+	*len = m;
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Allocate a workspace for the slow-scale SSA that fits the given model. The
+ reversible pairs of the model (two reactions with opposite stoichiometry) are
+ found here from the stoichiometry table; which of them are fast is decided
+ during the simulation.
+ */
+sm_ss_workspace * sm_ss_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->react_ptr == NULL))
+	{
+		fprintf (stderr, "error in sm_ss_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_ss_workspace * w = malloc (sizeof (sm_ss_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_ss_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	w->nspecies = N;
+	w->nrxns = R;
+	w->npar = model->nparams + model->nin;
+	w->maxrange = 1000;
+	w->ratio = 100.0;
+	w->fast = 0;
+	w->npairs = 0;
+	w->X = gsl_vector_alloc (N);
+	w->prop = gsl_vector_alloc (R);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->Xt = malloc ((N + 1) * sizeof (double));
+	w->at = malloc ((R + 1) * sizeof (double));
+	w->ahat = malloc ((R + 1) * sizeof (double));
+	w->weight = malloc ((w->maxrange + 1) * sizeof (double));
+	w->pair_fwd = malloc ((R / 2 + 1) * sizeof (size_t));
+	w->pair_rev = malloc ((R / 2 + 1) * sizeof (size_t));
+	w->pair_reads = calloc ((R / 2 + 1) * R, 1);
+	w->isfast = malloc (R + 1);
+	w->touched = malloc (N + 1);
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->par == NULL) || (w->Xt == NULL) || (w->at == NULL)
+			|| (w->ahat == NULL) || (w->weight == NULL) || (w->pair_fwd == NULL) || (w->pair_rev == NULL)
+			|| (w->pair_reads == NULL) || (w->isfast == NULL) || (w->touched == NULL))
+	{
+		fprintf (stderr, "error in sm_ss_workspace_alloc: failed to allocate workspace members\n");
+		sm_ss_workspace_free (w);
+		return NULL;
+	}
+
+	// Find the reversible pairs, each reaction being part of at most one pair
+	for (size_t j = 0; j < R; j++)
+		w->isfast[j] = 0;
+	for (size_t j = 0; j < R; j++)
+	{
+		size_t lj = model->stoich_ptr[j+1] - model->stoich_ptr[j];
+		if (w->isfast[j] || (lj == 0))
+			continue;
+		for (size_t k = j + 1; k < R; k++)
+		{
+			if (w->isfast[k] || (model->stoich_ptr[k+1] - model->stoich_ptr[k] != lj))
+				continue;
+			int opposite = 1;
+			for (size_t q = 0; (q < lj) && opposite; q++)
+				opposite = (model->stoich_idx[model->stoich_ptr[j] + q] == model->stoich_idx[model->stoich_ptr[k] + q])
+						&& (model->stoich_val[model->stoich_ptr[j] + q] == -model->stoich_val[model->stoich_ptr[k] + q]);
+			if (!opposite)
+				continue;
+
+			// Reactions whose propensity reads a species changed by the pair
+			size_t p = w->npairs++;
+			w->pair_fwd[p] = j;
+			w->pair_rev[p] = k;
+			for (size_t m = 0; m < R; m++)
+				for (size_t q = model->react_ptr[m]; q < model->react_ptr[m+1]; q++)
+					for (size_t s = model->stoich_ptr[j]; s < model->stoich_ptr[j+1]; s++)
+						if (model->react_idx[q] == model->stoich_idx[s])
+							w->pair_reads[p*R + m] = 1;
+			w->isfast[j] = w->isfast[k] = 1;
+			break;
+		}
+	}
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_ss_workspace_alloc.
+ */
+void sm_ss_workspace_free (sm_ss_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	free (w->par);
+	free (w->Xt);
+	free (w->at);
+	free (w->ahat);
+	free (w->weight);
+	free (w->pair_fwd);
+	free (w->pair_rev);
+	free (w->pair_reads);
+	free (w->isfast);
+	free (w->touched);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the model with the slow-scale SSA of Cao,
+ Gillespie and Petzold (J. Chem. Phys. 122, 2005).
+
+ Arguments and output are the same as in sm_ssa_direct_run. Before each step
+ the reversible pairs are split in fast and slow: a pair is fast when both of
+ its propensities are at least w->ratio times larger than every propensity
+ outside the reversible pairs, and it does not change a species already
+ changed by another fast pair. For each fast pair the stationary distribution
+ of its extent is computed, the fast species are sampled from it, and the
+ propensities of the slow reactions that read them are replaced by their
+ expectation under it (given the sampled state of the other fast pairs).
+ Only the slow reactions are then simulated, with the direct method.
+ */
+int sm_ss_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ss_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_ss_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_ss_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_ss_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	double * x = w->X->data;
+	double * a = w->prop->data;
+	double * ahat = w->ahat;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->fast = (model->propensity_raw != NULL);
+	gsl_vector_memcpy (w->X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+
+	while (k < ntimes)
+	{
+		if (ss_propensity (model, params, w, x, a) != GSL_SUCCESS)
+			return GSL_EFAILED;
+
+		// Largest propensity outside the reversible pairs
+		double aslow = 0.0;
+		for (size_t j = 0; j < R; j++)
+		{
+			w->isfast[j] = 0;
+			ahat[j] = a[j];
+		}
+		for (size_t p = 0; p < w->npairs; p++)
+			w->isfast[w->pair_fwd[p]] = w->isfast[w->pair_rev[p]] = 1;
+		for (size_t j = 0; j < R; j++)
+			if (!w->isfast[j])
+				aslow = GSL_MAX (aslow, a[j]);
+
+		// Partition the pairs and bring the fast ones to their stationary distribution
+		for (size_t i = 0; i < N; i++)
+			w->touched[i] = 0;
+		for (size_t p = 0; p < w->npairs; p++)
+		{
+			size_t jf = w->pair_fwd[p];
+			size_t jr = w->pair_rev[p];
+			int isfast = (aslow > 0.0) && (GSL_MIN (a[jf], a[jr]) >= w->ratio * aslow);
+			for (size_t q = model->stoich_ptr[jf]; (q < model->stoich_ptr[jf+1]) && isfast; q++)
+				isfast = !w->touched[model->stoich_idx[q]];
+			w->isfast[jf] = w->isfast[jr] = isfast;
+			if (!isfast)
+				continue;
+			for (size_t q = model->stoich_ptr[jf]; q < model->stoich_ptr[jf+1]; q++)
+				w->touched[model->stoich_idx[q]] = 1;
+
+			long nlo;
+			size_t len;
+			if (ss_equilibrium (model, params, w, p, &nlo, &len) != GSL_SUCCESS)
+				return GSL_EFAILED;
+
+			// Virtual propensities of the slow reactions that read the fast species
+			for (size_t j = 0; j < R; j++)
+				if (w->pair_reads[p*R + j])
+					ahat[j] = 0.0;
+			for (size_t i = 0; i < len; i++)
+			{
+				if (w->weight[i] <= 0.0)
+					continue;
+				ss_shift (model, w, p, x, w->Xt, nlo + (long) i);
+				if (ss_propensity (model, params, w, w->Xt, w->at) != GSL_SUCCESS)
+					return GSL_EFAILED;
+				for (size_t j = 0; j < R; j++)
+					if (w->pair_reads[p*R + j])
+						ahat[j] += w->weight[i] * w->at[j];
+			}
+
+			// Sample the fast species
+			double u = sm_rngbuf_uniform (&w->rb);
+			size_t i = 0;
+			while ((i + 1 < len) && (u >= w->weight[i]))
+				u -= w->weight[i++];
+			ss_shift (model, w, p, x, w->Xt, nlo + (long) i);
+			for (size_t s = 0; s < N; s++)
+				x[s] = w->Xt[s];
+		}
+
+		// Direct method step on the slow reactions
+		double a0 = 0.0;
+		for (size_t j = 0; j < R; j++)
+			if (!w->isfast[j])
+				a0 += ahat[j];
+		double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+		{
+			gsl_matrix_set_row (states, k, w->X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		double target = a0 * sm_rngbuf_uniform (&w->rb);
+		double cumsum = 0.0;
+		size_t rxnid = R;
+		for (size_t j = 0; j < R; j++)
+		{
+			if (w->isfast[j] || (ahat[j] <= 0.0))
+				continue;
+			rxnid = j;
+			cumsum += ahat[j];
+			if (target < cumsum)
+				break;
+		}
+		for (size_t q = model->stoich_ptr[rxnid]; q < model->stoich_ptr[rxnid+1]; q++)
+			x[model->stoich_idx[q]] += model->stoich_val[q];
+		t = tnext;
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
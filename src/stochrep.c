@@ -169,280 +169,4561 @@ int stochrep_propensity_eval (const gsl_vector * X, const gsl_vector * params, g
 
 
 /**
- State update function for Stochrep.
+ Incremental propensity update function for Stochrep.
  */
-int stochrep_state_update (gsl_vector * X, size_t rxnid)
+int stochrep_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
 {
-	// Check sizes of state vector
-	if (X->size != 21)
+	// Check sizes of vectors
+	if ((X->size != 21) || (params->size != 48) || (prop->size != 48))
 	{
-		printf("\n\n>> error in stochrep_state_update: state vector size is not correct...\n");
+		printf("\n\n>> error in stochrep_propensity_update: vector sizes are not correct...\n");
 		return GSL_EFAILED;
 	}
-	
+
 	// Check that reaction id is correct
 	if (rxnid>=48)
 	{
-		printf("\n\n>> error in stochrep_state_update: reaction id is not correct...\n");
+		printf("\n\n>> error in stochrep_propensity_update: reaction id is not correct...\n");
 		return GSL_EFAILED;
 	}
-	
-	// Update the state vector according to which reaction fired
+
+	// Recompute the propensities that depend on the species changed by the reaction
 	switch (rxnid) {
 		case 0:
-			gsl_vector_set (X, 0, gsl_vector_get (X, 0) + (-1));
-			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k8 = gsl_vector_get (params, 7);
+			double k9 = gsl_vector_get (params, 8);
+			double k10 = gsl_vector_get (params, 9);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 7, k8*X2);
+			gsl_vector_set (prop, 8, k9*X1);
+			gsl_vector_set (prop, 9, k10*X2);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 1:
-			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (-1));
-			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			double k10 = gsl_vector_get (params, 9);
+			double k11 = gsl_vector_get (params, 10);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 6, k7*X3);
+			gsl_vector_set (prop, 7, k8*X2);
+			gsl_vector_set (prop, 9, k10*X2);
+			gsl_vector_set (prop, 10, k11*X3);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 2:
-			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (-1));
-			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k6 = gsl_vector_get (params, 5);
+			double k7 = gsl_vector_get (params, 6);
+			double k11 = gsl_vector_get (params, 10);
+			double k12 = gsl_vector_get (params, 11);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 5, k6*X4);
+			gsl_vector_set (prop, 6, k7*X3);
+			gsl_vector_set (prop, 10, k11*X3);
+			gsl_vector_set (prop, 11, k12*X4);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 3:
-			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (-1));
-			gsl_vector_set (X, 4, gsl_vector_get (X, 4) + (1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X5 = gsl_vector_get (X, 4);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k5 = gsl_vector_get (params, 4);
+			double k6 = gsl_vector_get (params, 5);
+			double k12 = gsl_vector_get (params, 11);
+			double k13 = gsl_vector_get (params, 12);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 4, k5*X5);
+			gsl_vector_set (prop, 5, k6*X4);
+			gsl_vector_set (prop, 11, k12*X4);
+			gsl_vector_set (prop, 12, k13*X5);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 4:
-			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (1));
-			gsl_vector_set (X, 4, gsl_vector_get (X, 4) + (-1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X5 = gsl_vector_get (X, 4);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k5 = gsl_vector_get (params, 4);
+			double k6 = gsl_vector_get (params, 5);
+			double k12 = gsl_vector_get (params, 11);
+			double k13 = gsl_vector_get (params, 12);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 4, k5*X5);
+			gsl_vector_set (prop, 5, k6*X4);
+			gsl_vector_set (prop, 11, k12*X4);
+			gsl_vector_set (prop, 12, k13*X5);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 5:
-			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (1));
-			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (-1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k6 = gsl_vector_get (params, 5);
+			double k7 = gsl_vector_get (params, 6);
+			double k11 = gsl_vector_get (params, 10);
+			double k12 = gsl_vector_get (params, 11);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 5, k6*X4);
+			gsl_vector_set (prop, 6, k7*X3);
+			gsl_vector_set (prop, 10, k11*X3);
+			gsl_vector_set (prop, 11, k12*X4);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 6:
-			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (1));
-			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (-1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k7 = gsl_vector_get (params, 6);
+			double k8 = gsl_vector_get (params, 7);
+			double k10 = gsl_vector_get (params, 9);
+			double k11 = gsl_vector_get (params, 10);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 6, k7*X3);
+			gsl_vector_set (prop, 7, k8*X2);
+			gsl_vector_set (prop, 9, k10*X2);
+			gsl_vector_set (prop, 10, k11*X3);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 7:
-			gsl_vector_set (X, 0, gsl_vector_get (X, 0) + (1));
-			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (-1));
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k8 = gsl_vector_get (params, 7);
+			double k9 = gsl_vector_get (params, 8);
+			double k10 = gsl_vector_get (params, 9);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 7, k8*X2);
+			gsl_vector_set (prop, 8, k9*X1);
+			gsl_vector_set (prop, 9, k10*X2);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 8:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 9:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 10:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 11:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 12:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 13:
-			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (-1));
+		{
+			double X6 = gsl_vector_get (X, 5);
+			double k14 = gsl_vector_get (params, 13);
+			double k15 = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, k14*X6);
+			gsl_vector_set (prop, 14, k15*X6);
 			break;
-			
+		}
+
 		case 14:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
 			break;
-			
+		}
+
 		case 15:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
 			break;
-			
+		}
+
 		case 16:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
-			gsl_vector_set (X, 7, gsl_vector_get (X, 7) + (-1));
-			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k24 = gsl_vector_get (params, 23);
+			double k25 = gsl_vector_get (params, 24);
+			double k26 = gsl_vector_get (params, 25);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 23, k24*X9);
+			gsl_vector_set (prop, 24, k25*X8);
+			gsl_vector_set (prop, 25, k26*X9);
 			break;
-			
+		}
+
 		case 17:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
-			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (-1));
-			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k23 = gsl_vector_get (params, 22);
+			double k24 = gsl_vector_get (params, 23);
+			double k26 = gsl_vector_get (params, 25);
+			double k27 = gsl_vector_get (params, 26);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 22, k23*X10);
+			gsl_vector_set (prop, 23, k24*X9);
+			gsl_vector_set (prop, 25, k26*X9);
+			gsl_vector_set (prop, 26, k27*X10);
 			break;
-			
+		}
+
 		case 18:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
-			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (-1));
-			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k22 = gsl_vector_get (params, 21);
+			double k23 = gsl_vector_get (params, 22);
+			double k27 = gsl_vector_get (params, 26);
+			double k28 = gsl_vector_get (params, 27);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 21, k22*X11);
+			gsl_vector_set (prop, 22, k23*X10);
+			gsl_vector_set (prop, 26, k27*X10);
+			gsl_vector_set (prop, 27, k28*X11);
 			break;
-			
+		}
+
 		case 19:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
-			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (-1));
-			gsl_vector_set (X, 11, gsl_vector_get (X, 11) + (1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double X12 = gsl_vector_get (X, 11);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k21 = gsl_vector_get (params, 20);
+			double k22 = gsl_vector_get (params, 21);
+			double k28 = gsl_vector_get (params, 27);
+			double k29 = gsl_vector_get (params, 28);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 20, k21*X12);
+			gsl_vector_set (prop, 21, k22*X11);
+			gsl_vector_set (prop, 27, k28*X11);
+			gsl_vector_set (prop, 28, k29*X12);
 			break;
-			
+		}
+
 		case 20:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
-			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (1));
-			gsl_vector_set (X, 11, gsl_vector_get (X, 11) + (-1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double X12 = gsl_vector_get (X, 11);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k21 = gsl_vector_get (params, 20);
+			double k22 = gsl_vector_get (params, 21);
+			double k28 = gsl_vector_get (params, 27);
+			double k29 = gsl_vector_get (params, 28);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 20, k21*X12);
+			gsl_vector_set (prop, 21, k22*X11);
+			gsl_vector_set (prop, 27, k28*X11);
+			gsl_vector_set (prop, 28, k29*X12);
 			break;
-			
+		}
+
 		case 21:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
-			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (1));
-			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (-1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k22 = gsl_vector_get (params, 21);
+			double k23 = gsl_vector_get (params, 22);
+			double k27 = gsl_vector_get (params, 26);
+			double k28 = gsl_vector_get (params, 27);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 21, k22*X11);
+			gsl_vector_set (prop, 22, k23*X10);
+			gsl_vector_set (prop, 26, k27*X10);
+			gsl_vector_set (prop, 27, k28*X11);
 			break;
-			
+		}
+
 		case 22:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
-			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (1));
-			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (-1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k23 = gsl_vector_get (params, 22);
+			double k24 = gsl_vector_get (params, 23);
+			double k26 = gsl_vector_get (params, 25);
+			double k27 = gsl_vector_get (params, 26);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 22, k23*X10);
+			gsl_vector_set (prop, 23, k24*X9);
+			gsl_vector_set (prop, 25, k26*X9);
+			gsl_vector_set (prop, 26, k27*X10);
 			break;
-			
+		}
+
 		case 23:
-			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
-			gsl_vector_set (X, 7, gsl_vector_get (X, 7) + (1));
-			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (-1));
+		{
+			double X7 = gsl_vector_get (X, 6);
+			double X8 = gsl_vector_get (X, 7);
+			double X9 = gsl_vector_get (X, 8);
+			double X10 = gsl_vector_get (X, 9);
+			double X11 = gsl_vector_get (X, 10);
+			double k16 = gsl_vector_get (params, 15);
+			double k17 = gsl_vector_get (params, 16);
+			double k18 = gsl_vector_get (params, 17);
+			double k19 = gsl_vector_get (params, 18);
+			double k20 = gsl_vector_get (params, 19);
+			double k24 = gsl_vector_get (params, 23);
+			double k25 = gsl_vector_get (params, 24);
+			double k26 = gsl_vector_get (params, 25);
+			gsl_vector_set (prop, 15, k16*X7);
+			gsl_vector_set (prop, 16, k17*X8*X7);
+			gsl_vector_set (prop, 17, k18*X9*X7);
+			gsl_vector_set (prop, 18, k19*X10*X7);
+			gsl_vector_set (prop, 19, k20*X11*X7);
+			gsl_vector_set (prop, 23, k24*X9);
+			gsl_vector_set (prop, 24, k25*X8);
+			gsl_vector_set (prop, 25, k26*X9);
 			break;
-			
+		}
+
 		case 24:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 25:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 26:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 27:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 28:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 29:
-			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (-1));
+		{
+			double X13 = gsl_vector_get (X, 12);
+			double k30 = gsl_vector_get (params, 29);
+			double k31 = gsl_vector_get (params, 30);
+			gsl_vector_set (prop, 29, k30*X13);
+			gsl_vector_set (prop, 30, k31*X13);
 			break;
-			
+		}
+
 		case 30:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
 			break;
-			
+		}
+
 		case 31:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
 			break;
-			
+		}
+
 		case 32:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
-			gsl_vector_set (X, 14, gsl_vector_get (X, 14) + (-1));
-			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k40 = gsl_vector_get (params, 39);
+			double k41 = gsl_vector_get (params, 40);
+			double k42 = gsl_vector_get (params, 41);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 39, k40*X16);
+			gsl_vector_set (prop, 40, k41*X15);
+			gsl_vector_set (prop, 41, k42*X16);
 			break;
-			
+		}
+
 		case 33:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
-			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (-1));
-			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k39 = gsl_vector_get (params, 38);
+			double k40 = gsl_vector_get (params, 39);
+			double k42 = gsl_vector_get (params, 41);
+			double k43 = gsl_vector_get (params, 42);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 38, k39*X17);
+			gsl_vector_set (prop, 39, k40*X16);
+			gsl_vector_set (prop, 41, k42*X16);
+			gsl_vector_set (prop, 42, k43*X17);
 			break;
-			
+		}
+
 		case 34:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
-			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (-1));
-			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k38 = gsl_vector_get (params, 37);
+			double k39 = gsl_vector_get (params, 38);
+			double k43 = gsl_vector_get (params, 42);
+			double k44 = gsl_vector_get (params, 43);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 37, k38*X18);
+			gsl_vector_set (prop, 38, k39*X17);
+			gsl_vector_set (prop, 42, k43*X17);
+			gsl_vector_set (prop, 43, k44*X18);
 			break;
-			
+		}
+
 		case 35:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
-			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (-1));
-			gsl_vector_set (X, 18, gsl_vector_get (X, 18) + (1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double X19 = gsl_vector_get (X, 18);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k37 = gsl_vector_get (params, 36);
+			double k38 = gsl_vector_get (params, 37);
+			double k44 = gsl_vector_get (params, 43);
+			double k45 = gsl_vector_get (params, 44);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 36, k37*X19);
+			gsl_vector_set (prop, 37, k38*X18);
+			gsl_vector_set (prop, 43, k44*X18);
+			gsl_vector_set (prop, 44, k45*X19);
 			break;
-			
+		}
+
 		case 36:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
-			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (1));
-			gsl_vector_set (X, 18, gsl_vector_get (X, 18) + (-1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double X19 = gsl_vector_get (X, 18);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k37 = gsl_vector_get (params, 36);
+			double k38 = gsl_vector_get (params, 37);
+			double k44 = gsl_vector_get (params, 43);
+			double k45 = gsl_vector_get (params, 44);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 36, k37*X19);
+			gsl_vector_set (prop, 37, k38*X18);
+			gsl_vector_set (prop, 43, k44*X18);
+			gsl_vector_set (prop, 44, k45*X19);
 			break;
-			
+		}
+
 		case 37:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
-			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (1));
-			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (-1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k38 = gsl_vector_get (params, 37);
+			double k39 = gsl_vector_get (params, 38);
+			double k43 = gsl_vector_get (params, 42);
+			double k44 = gsl_vector_get (params, 43);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 37, k38*X18);
+			gsl_vector_set (prop, 38, k39*X17);
+			gsl_vector_set (prop, 42, k43*X17);
+			gsl_vector_set (prop, 43, k44*X18);
 			break;
-			
+		}
+
 		case 38:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
-			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (1));
-			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (-1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k39 = gsl_vector_get (params, 38);
+			double k40 = gsl_vector_get (params, 39);
+			double k42 = gsl_vector_get (params, 41);
+			double k43 = gsl_vector_get (params, 42);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 38, k39*X17);
+			gsl_vector_set (prop, 39, k40*X16);
+			gsl_vector_set (prop, 41, k42*X16);
+			gsl_vector_set (prop, 42, k43*X17);
 			break;
-			
+		}
+
 		case 39:
-			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
-			gsl_vector_set (X, 14, gsl_vector_get (X, 14) + (1));
-			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (-1));
+		{
+			double X14 = gsl_vector_get (X, 13);
+			double X15 = gsl_vector_get (X, 14);
+			double X16 = gsl_vector_get (X, 15);
+			double X17 = gsl_vector_get (X, 16);
+			double X18 = gsl_vector_get (X, 17);
+			double k32 = gsl_vector_get (params, 31);
+			double k33 = gsl_vector_get (params, 32);
+			double k34 = gsl_vector_get (params, 33);
+			double k35 = gsl_vector_get (params, 34);
+			double k36 = gsl_vector_get (params, 35);
+			double k40 = gsl_vector_get (params, 39);
+			double k41 = gsl_vector_get (params, 40);
+			double k42 = gsl_vector_get (params, 41);
+			gsl_vector_set (prop, 31, k32*X14);
+			gsl_vector_set (prop, 32, k33*X15*X14);
+			gsl_vector_set (prop, 33, k34*X16*X14);
+			gsl_vector_set (prop, 34, k35*X17*X14);
+			gsl_vector_set (prop, 35, k36*X18*X14);
+			gsl_vector_set (prop, 39, k40*X16);
+			gsl_vector_set (prop, 40, k41*X15);
+			gsl_vector_set (prop, 41, k42*X16);
 			break;
-			
+		}
+
 		case 40:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 41:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 42:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 43:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 44:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 45:
-			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (-1));
+		{
+			double X20 = gsl_vector_get (X, 19);
+			double k46 = gsl_vector_get (params, 45);
+			double k47 = gsl_vector_get (params, 46);
+			gsl_vector_set (prop, 45, k46*X20);
+			gsl_vector_set (prop, 46, k47*X20);
 			break;
-			
+		}
+
 		case 46:
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
+
 		case 47:
-			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+		{
+			double X1 = gsl_vector_get (X, 0);
+			double X2 = gsl_vector_get (X, 1);
+			double X3 = gsl_vector_get (X, 2);
+			double X4 = gsl_vector_get (X, 3);
+			double X21 = gsl_vector_get (X, 20);
+			double k1 = gsl_vector_get (params, 0);
+			double k2 = gsl_vector_get (params, 1);
+			double k3 = gsl_vector_get (params, 2);
+			double k4 = gsl_vector_get (params, 3);
+			double k48 = gsl_vector_get (params, 47);
+			gsl_vector_set (prop, 0, k1*X1*X21);
+			gsl_vector_set (prop, 1, k2*X2*X21);
+			gsl_vector_set (prop, 2, k3*X3*X21);
+			gsl_vector_set (prop, 3, k4*X4*X21);
+			gsl_vector_set (prop, 47, k48*X21);
 			break;
-			
+		}
 	}
-	
-	// Signal that computation was completed correctly
+
+	// Signal that computation was completed successfully
 	return GSL_SUCCESS;
 }
 
 
+/**
+ Propensity Jacobian function for Stochrep: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int stochrep_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 21) || (params->size != 48) || (J->size1 != 48) || (J->size2 != 21))
+	{
+		printf("\n\n>> error in stochrep_propensity_jacobian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X1 = gsl_vector_get (X, 0);
+	double X2 = gsl_vector_get (X, 1);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X7 = gsl_vector_get (X, 6);
+	double X8 = gsl_vector_get (X, 7);
+	double X9 = gsl_vector_get (X, 8);
+	double X10 = gsl_vector_get (X, 9);
+	double X11 = gsl_vector_get (X, 10);
+	double X14 = gsl_vector_get (X, 13);
+	double X15 = gsl_vector_get (X, 14);
+	double X16 = gsl_vector_get (X, 15);
+	double X17 = gsl_vector_get (X, 16);
+	double X18 = gsl_vector_get (X, 17);
+	double X21 = gsl_vector_get (X, 20);
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double k14 = gsl_vector_get (params, 13);
+	double k15 = gsl_vector_get (params, 14);
+	double k16 = gsl_vector_get (params, 15);
+	double k17 = gsl_vector_get (params, 16);
+	double k18 = gsl_vector_get (params, 17);
+	double k19 = gsl_vector_get (params, 18);
+	double k20 = gsl_vector_get (params, 19);
+	double k21 = gsl_vector_get (params, 20);
+	double k22 = gsl_vector_get (params, 21);
+	double k23 = gsl_vector_get (params, 22);
+	double k24 = gsl_vector_get (params, 23);
+	double k25 = gsl_vector_get (params, 24);
+	double k26 = gsl_vector_get (params, 25);
+	double k27 = gsl_vector_get (params, 26);
+	double k28 = gsl_vector_get (params, 27);
+	double k29 = gsl_vector_get (params, 28);
+	double k30 = gsl_vector_get (params, 29);
+	double k31 = gsl_vector_get (params, 30);
+	double k32 = gsl_vector_get (params, 31);
+	double k33 = gsl_vector_get (params, 32);
+	double k34 = gsl_vector_get (params, 33);
+	double k35 = gsl_vector_get (params, 34);
+	double k36 = gsl_vector_get (params, 35);
+	double k37 = gsl_vector_get (params, 36);
+	double k38 = gsl_vector_get (params, 37);
+	double k39 = gsl_vector_get (params, 38);
+	double k40 = gsl_vector_get (params, 39);
+	double k41 = gsl_vector_get (params, 40);
+	double k42 = gsl_vector_get (params, 41);
+	double k43 = gsl_vector_get (params, 42);
+	double k44 = gsl_vector_get (params, 43);
+	double k45 = gsl_vector_get (params, 44);
+	double k46 = gsl_vector_get (params, 45);
+	double k47 = gsl_vector_get (params, 46);
+	double k48 = gsl_vector_get (params, 47);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 0, 0, k1*X21);
+	gsl_matrix_set (J, 0, 20, k1*X1);
+	gsl_matrix_set (J, 1, 1, k2*X21);
+	gsl_matrix_set (J, 1, 20, k2*X2);
+	gsl_matrix_set (J, 2, 2, k3*X21);
+	gsl_matrix_set (J, 2, 20, k3*X3);
+	gsl_matrix_set (J, 3, 3, k4*X21);
+	gsl_matrix_set (J, 3, 20, k4*X4);
+	gsl_matrix_set (J, 4, 4, k5);
+	gsl_matrix_set (J, 5, 3, k6);
+	gsl_matrix_set (J, 6, 2, k7);
+	gsl_matrix_set (J, 7, 1, k8);
+	gsl_matrix_set (J, 8, 0, k9);
+	gsl_matrix_set (J, 9, 1, k10);
+	gsl_matrix_set (J, 10, 2, k11);
+	gsl_matrix_set (J, 11, 3, k12);
+	gsl_matrix_set (J, 12, 4, k13);
+	gsl_matrix_set (J, 13, 5, k14);
+	gsl_matrix_set (J, 14, 5, k15);
+	gsl_matrix_set (J, 15, 6, k16);
+	gsl_matrix_set (J, 16, 6, k17*X8);
+	gsl_matrix_set (J, 16, 7, k17*X7);
+	gsl_matrix_set (J, 17, 6, k18*X9);
+	gsl_matrix_set (J, 17, 8, k18*X7);
+	gsl_matrix_set (J, 18, 6, k19*X10);
+	gsl_matrix_set (J, 18, 9, k19*X7);
+	gsl_matrix_set (J, 19, 6, k20*X11);
+	gsl_matrix_set (J, 19, 10, k20*X7);
+	gsl_matrix_set (J, 20, 11, k21);
+	gsl_matrix_set (J, 21, 10, k22);
+	gsl_matrix_set (J, 22, 9, k23);
+	gsl_matrix_set (J, 23, 8, k24);
+	gsl_matrix_set (J, 24, 7, k25);
+	gsl_matrix_set (J, 25, 8, k26);
+	gsl_matrix_set (J, 26, 9, k27);
+	gsl_matrix_set (J, 27, 10, k28);
+	gsl_matrix_set (J, 28, 11, k29);
+	gsl_matrix_set (J, 29, 12, k30);
+	gsl_matrix_set (J, 30, 12, k31);
+	gsl_matrix_set (J, 31, 13, k32);
+	gsl_matrix_set (J, 32, 13, k33*X15);
+	gsl_matrix_set (J, 32, 14, k33*X14);
+	gsl_matrix_set (J, 33, 13, k34*X16);
+	gsl_matrix_set (J, 33, 15, k34*X14);
+	gsl_matrix_set (J, 34, 13, k35*X17);
+	gsl_matrix_set (J, 34, 16, k35*X14);
+	gsl_matrix_set (J, 35, 13, k36*X18);
+	gsl_matrix_set (J, 35, 17, k36*X14);
+	gsl_matrix_set (J, 36, 18, k37);
+	gsl_matrix_set (J, 37, 17, k38);
+	gsl_matrix_set (J, 38, 16, k39);
+	gsl_matrix_set (J, 39, 15, k40);
+	gsl_matrix_set (J, 40, 14, k41);
+	gsl_matrix_set (J, 41, 15, k42);
+	gsl_matrix_set (J, 42, 16, k43);
+	gsl_matrix_set (J, 43, 17, k44);
+	gsl_matrix_set (J, 44, 18, k45);
+	gsl_matrix_set (J, 45, 19, k46);
+	gsl_matrix_set (J, 46, 19, k47);
+	gsl_matrix_set (J, 47, 20, k48);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Stochrep: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int stochrep_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 21) || (params->size != 48) || (H->size1 != 48) || (H->size2 != 441))
+	{
+		printf("\n\n>> error in stochrep_propensity_hessian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k17 = gsl_vector_get (params, 16);
+	double k18 = gsl_vector_get (params, 17);
+	double k19 = gsl_vector_get (params, 18);
+	double k20 = gsl_vector_get (params, 19);
+	double k33 = gsl_vector_get (params, 32);
+	double k34 = gsl_vector_get (params, 33);
+	double k35 = gsl_vector_get (params, 34);
+	double k36 = gsl_vector_get (params, 35);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 0, 20, k1);
+	gsl_matrix_set (H, 0, 420, k1);
+	gsl_matrix_set (H, 1, 41, k2);
+	gsl_matrix_set (H, 1, 421, k2);
+	gsl_matrix_set (H, 2, 62, k3);
+	gsl_matrix_set (H, 2, 422, k3);
+	gsl_matrix_set (H, 3, 83, k4);
+	gsl_matrix_set (H, 3, 423, k4);
+	gsl_matrix_set (H, 16, 133, k17);
+	gsl_matrix_set (H, 16, 153, k17);
+	gsl_matrix_set (H, 17, 134, k18);
+	gsl_matrix_set (H, 17, 174, k18);
+	gsl_matrix_set (H, 18, 135, k19);
+	gsl_matrix_set (H, 18, 195, k19);
+	gsl_matrix_set (H, 19, 136, k20);
+	gsl_matrix_set (H, 19, 216, k20);
+	gsl_matrix_set (H, 32, 287, k33);
+	gsl_matrix_set (H, 32, 307, k33);
+	gsl_matrix_set (H, 33, 288, k34);
+	gsl_matrix_set (H, 33, 328, k34);
+	gsl_matrix_set (H, 34, 289, k35);
+	gsl_matrix_set (H, 34, 349, k35);
+	gsl_matrix_set (H, 35, 290, k36);
+	gsl_matrix_set (H, 35, 370, k36);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Stochrep, on contiguous arrays.
+ */
+void stochrep_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double X9 = X[8];
+	double X10 = X[9];
+	double X11 = X[10];
+	double X12 = X[11];
+	double X13 = X[12];
+	double X14 = X[13];
+	double X15 = X[14];
+	double X16 = X[15];
+	double X17 = X[16];
+	double X18 = X[17];
+	double X19 = X[18];
+	double X20 = X[19];
+	double X21 = X[20];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double k18 = params[17];
+	double k19 = params[18];
+	double k20 = params[19];
+	double k21 = params[20];
+	double k22 = params[21];
+	double k23 = params[22];
+	double k24 = params[23];
+	double k25 = params[24];
+	double k26 = params[25];
+	double k27 = params[26];
+	double k28 = params[27];
+	double k29 = params[28];
+	double k30 = params[29];
+	double k31 = params[30];
+	double k32 = params[31];
+	double k33 = params[32];
+	double k34 = params[33];
+	double k35 = params[34];
+	double k36 = params[35];
+	double k37 = params[36];
+	double k38 = params[37];
+	double k39 = params[38];
+	double k40 = params[39];
+	double k41 = params[40];
+	double k42 = params[41];
+	double k43 = params[42];
+	double k44 = params[43];
+	double k45 = params[44];
+	double k46 = params[45];
+	double k47 = params[46];
+	double k48 = params[47];
+
+	// Compute the propensities
+	prop[0] = k1*X1*X21;
+	prop[1] = k2*X2*X21;
+	prop[2] = k3*X3*X21;
+	prop[3] = k4*X4*X21;
+	prop[4] = k5*X5;
+	prop[5] = k6*X4;
+	prop[6] = k7*X3;
+	prop[7] = k8*X2;
+	prop[8] = k9*X1;
+	prop[9] = k10*X2;
+	prop[10] = k11*X3;
+	prop[11] = k12*X4;
+	prop[12] = k13*X5;
+	prop[13] = k14*X6;
+	prop[14] = k15*X6;
+	prop[15] = k16*X7;
+	prop[16] = k17*X8*X7;
+	prop[17] = k18*X9*X7;
+	prop[18] = k19*X10*X7;
+	prop[19] = k20*X11*X7;
+	prop[20] = k21*X12;
+	prop[21] = k22*X11;
+	prop[22] = k23*X10;
+	prop[23] = k24*X9;
+	prop[24] = k25*X8;
+	prop[25] = k26*X9;
+	prop[26] = k27*X10;
+	prop[27] = k28*X11;
+	prop[28] = k29*X12;
+	prop[29] = k30*X13;
+	prop[30] = k31*X13;
+	prop[31] = k32*X14;
+	prop[32] = k33*X15*X14;
+	prop[33] = k34*X16*X14;
+	prop[34] = k35*X17*X14;
+	prop[35] = k36*X18*X14;
+	prop[36] = k37*X19;
+	prop[37] = k38*X18;
+	prop[38] = k39*X17;
+	prop[39] = k40*X16;
+	prop[40] = k41*X15;
+	prop[41] = k42*X16;
+	prop[42] = k43*X17;
+	prop[43] = k44*X18;
+	prop[44] = k45*X19;
+	prop[45] = k46*X20;
+	prop[46] = k47*X20;
+	prop[47] = k48*X21;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Stochrep, on contiguous arrays.
+ */
+void stochrep_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k8 = params[7];
+			double k9 = params[8];
+			double k10 = params[9];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[7] = k8*X2;
+			prop[8] = k9*X1;
+			prop[9] = k10*X2;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k10 = params[9];
+			double k11 = params[10];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[6] = k7*X3;
+			prop[7] = k8*X2;
+			prop[9] = k10*X2;
+			prop[10] = k11*X3;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 2:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k6 = params[5];
+			double k7 = params[6];
+			double k11 = params[10];
+			double k12 = params[11];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[5] = k6*X4;
+			prop[6] = k7*X3;
+			prop[10] = k11*X3;
+			prop[11] = k12*X4;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 3:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X5 = X[4];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k5 = params[4];
+			double k6 = params[5];
+			double k12 = params[11];
+			double k13 = params[12];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[4] = k5*X5;
+			prop[5] = k6*X4;
+			prop[11] = k12*X4;
+			prop[12] = k13*X5;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 4:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X5 = X[4];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k5 = params[4];
+			double k6 = params[5];
+			double k12 = params[11];
+			double k13 = params[12];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[4] = k5*X5;
+			prop[5] = k6*X4;
+			prop[11] = k12*X4;
+			prop[12] = k13*X5;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 5:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k6 = params[5];
+			double k7 = params[6];
+			double k11 = params[10];
+			double k12 = params[11];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[5] = k6*X4;
+			prop[6] = k7*X3;
+			prop[10] = k11*X3;
+			prop[11] = k12*X4;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 6:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k10 = params[9];
+			double k11 = params[10];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[6] = k7*X3;
+			prop[7] = k8*X2;
+			prop[9] = k10*X2;
+			prop[10] = k11*X3;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 7:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k8 = params[7];
+			double k9 = params[8];
+			double k10 = params[9];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[7] = k8*X2;
+			prop[8] = k9*X1;
+			prop[9] = k10*X2;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 8:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 9:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 10:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 11:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 12:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 13:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 14:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			break;
+		}
+
+		case 15:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			break;
+		}
+
+		case 16:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k24 = params[23];
+			double k25 = params[24];
+			double k26 = params[25];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[23] = k24*X9;
+			prop[24] = k25*X8;
+			prop[25] = k26*X9;
+			break;
+		}
+
+		case 17:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k23 = params[22];
+			double k24 = params[23];
+			double k26 = params[25];
+			double k27 = params[26];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[22] = k23*X10;
+			prop[23] = k24*X9;
+			prop[25] = k26*X9;
+			prop[26] = k27*X10;
+			break;
+		}
+
+		case 18:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k22 = params[21];
+			double k23 = params[22];
+			double k27 = params[26];
+			double k28 = params[27];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[21] = k22*X11;
+			prop[22] = k23*X10;
+			prop[26] = k27*X10;
+			prop[27] = k28*X11;
+			break;
+		}
+
+		case 19:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double X12 = X[11];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k21 = params[20];
+			double k22 = params[21];
+			double k28 = params[27];
+			double k29 = params[28];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[20] = k21*X12;
+			prop[21] = k22*X11;
+			prop[27] = k28*X11;
+			prop[28] = k29*X12;
+			break;
+		}
+
+		case 20:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double X12 = X[11];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k21 = params[20];
+			double k22 = params[21];
+			double k28 = params[27];
+			double k29 = params[28];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[20] = k21*X12;
+			prop[21] = k22*X11;
+			prop[27] = k28*X11;
+			prop[28] = k29*X12;
+			break;
+		}
+
+		case 21:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k22 = params[21];
+			double k23 = params[22];
+			double k27 = params[26];
+			double k28 = params[27];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[21] = k22*X11;
+			prop[22] = k23*X10;
+			prop[26] = k27*X10;
+			prop[27] = k28*X11;
+			break;
+		}
+
+		case 22:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k23 = params[22];
+			double k24 = params[23];
+			double k26 = params[25];
+			double k27 = params[26];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[22] = k23*X10;
+			prop[23] = k24*X9;
+			prop[25] = k26*X9;
+			prop[26] = k27*X10;
+			break;
+		}
+
+		case 23:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k24 = params[23];
+			double k25 = params[24];
+			double k26 = params[25];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[23] = k24*X9;
+			prop[24] = k25*X8;
+			prop[25] = k26*X9;
+			break;
+		}
+
+		case 24:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 25:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 26:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 27:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 28:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 29:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 30:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			break;
+		}
+
+		case 31:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			break;
+		}
+
+		case 32:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k40 = params[39];
+			double k41 = params[40];
+			double k42 = params[41];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[39] = k40*X16;
+			prop[40] = k41*X15;
+			prop[41] = k42*X16;
+			break;
+		}
+
+		case 33:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k39 = params[38];
+			double k40 = params[39];
+			double k42 = params[41];
+			double k43 = params[42];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[38] = k39*X17;
+			prop[39] = k40*X16;
+			prop[41] = k42*X16;
+			prop[42] = k43*X17;
+			break;
+		}
+
+		case 34:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k38 = params[37];
+			double k39 = params[38];
+			double k43 = params[42];
+			double k44 = params[43];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[37] = k38*X18;
+			prop[38] = k39*X17;
+			prop[42] = k43*X17;
+			prop[43] = k44*X18;
+			break;
+		}
+
+		case 35:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double X19 = X[18];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k37 = params[36];
+			double k38 = params[37];
+			double k44 = params[43];
+			double k45 = params[44];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[36] = k37*X19;
+			prop[37] = k38*X18;
+			prop[43] = k44*X18;
+			prop[44] = k45*X19;
+			break;
+		}
+
+		case 36:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double X19 = X[18];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k37 = params[36];
+			double k38 = params[37];
+			double k44 = params[43];
+			double k45 = params[44];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[36] = k37*X19;
+			prop[37] = k38*X18;
+			prop[43] = k44*X18;
+			prop[44] = k45*X19;
+			break;
+		}
+
+		case 37:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k38 = params[37];
+			double k39 = params[38];
+			double k43 = params[42];
+			double k44 = params[43];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[37] = k38*X18;
+			prop[38] = k39*X17;
+			prop[42] = k43*X17;
+			prop[43] = k44*X18;
+			break;
+		}
+
+		case 38:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k39 = params[38];
+			double k40 = params[39];
+			double k42 = params[41];
+			double k43 = params[42];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[38] = k39*X17;
+			prop[39] = k40*X16;
+			prop[41] = k42*X16;
+			prop[42] = k43*X17;
+			break;
+		}
+
+		case 39:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k40 = params[39];
+			double k41 = params[40];
+			double k42 = params[41];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[39] = k40*X16;
+			prop[40] = k41*X15;
+			prop[41] = k42*X16;
+			break;
+		}
+
+		case 40:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 41:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 42:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 43:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 44:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 45:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 46:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 47:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[47] = k48*X21;
+			break;
+		}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Stochrep, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void stochrep_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double k18 = params[17];
+	double k19 = params[18];
+	double k20 = params[19];
+	double k21 = params[20];
+	double k22 = params[21];
+	double k23 = params[22];
+	double k24 = params[23];
+	double k25 = params[24];
+	double k26 = params[25];
+	double k27 = params[26];
+	double k28 = params[27];
+	double k29 = params[28];
+	double k30 = params[29];
+	double k31 = params[30];
+	double k32 = params[31];
+	double k33 = params[32];
+	double k34 = params[33];
+	double k35 = params[34];
+	double k36 = params[35];
+	double k37 = params[36];
+	double k38 = params[37];
+	double k39 = params[38];
+	double k40 = params[39];
+	double k41 = params[40];
+	double k42 = params[41];
+	double k43 = params[42];
+	double k44 = params[43];
+	double k45 = params[44];
+	double k46 = params[45];
+	double k47 = params[46];
+	double k48 = params[47];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+		double X5 = X[4*SM_LOCK_LANES+l];
+		double X6 = X[5*SM_LOCK_LANES+l];
+		double X7 = X[6*SM_LOCK_LANES+l];
+		double X8 = X[7*SM_LOCK_LANES+l];
+		double X9 = X[8*SM_LOCK_LANES+l];
+		double X10 = X[9*SM_LOCK_LANES+l];
+		double X11 = X[10*SM_LOCK_LANES+l];
+		double X12 = X[11*SM_LOCK_LANES+l];
+		double X13 = X[12*SM_LOCK_LANES+l];
+		double X14 = X[13*SM_LOCK_LANES+l];
+		double X15 = X[14*SM_LOCK_LANES+l];
+		double X16 = X[15*SM_LOCK_LANES+l];
+		double X17 = X[16*SM_LOCK_LANES+l];
+		double X18 = X[17*SM_LOCK_LANES+l];
+		double X19 = X[18*SM_LOCK_LANES+l];
+		double X20 = X[19*SM_LOCK_LANES+l];
+		double X21 = X[20*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = k1*X1*X21;
+		prop[SM_LOCK_LANES+l] = k2*X2*X21;
+		prop[2*SM_LOCK_LANES+l] = k3*X3*X21;
+		prop[3*SM_LOCK_LANES+l] = k4*X4*X21;
+		prop[4*SM_LOCK_LANES+l] = k5*X5;
+		prop[5*SM_LOCK_LANES+l] = k6*X4;
+		prop[6*SM_LOCK_LANES+l] = k7*X3;
+		prop[7*SM_LOCK_LANES+l] = k8*X2;
+		prop[8*SM_LOCK_LANES+l] = k9*X1;
+		prop[9*SM_LOCK_LANES+l] = k10*X2;
+		prop[10*SM_LOCK_LANES+l] = k11*X3;
+		prop[11*SM_LOCK_LANES+l] = k12*X4;
+		prop[12*SM_LOCK_LANES+l] = k13*X5;
+		prop[13*SM_LOCK_LANES+l] = k14*X6;
+		prop[14*SM_LOCK_LANES+l] = k15*X6;
+		prop[15*SM_LOCK_LANES+l] = k16*X7;
+		prop[16*SM_LOCK_LANES+l] = k17*X8*X7;
+		prop[17*SM_LOCK_LANES+l] = k18*X9*X7;
+		prop[18*SM_LOCK_LANES+l] = k19*X10*X7;
+		prop[19*SM_LOCK_LANES+l] = k20*X11*X7;
+		prop[20*SM_LOCK_LANES+l] = k21*X12;
+		prop[21*SM_LOCK_LANES+l] = k22*X11;
+		prop[22*SM_LOCK_LANES+l] = k23*X10;
+		prop[23*SM_LOCK_LANES+l] = k24*X9;
+		prop[24*SM_LOCK_LANES+l] = k25*X8;
+		prop[25*SM_LOCK_LANES+l] = k26*X9;
+		prop[26*SM_LOCK_LANES+l] = k27*X10;
+		prop[27*SM_LOCK_LANES+l] = k28*X11;
+		prop[28*SM_LOCK_LANES+l] = k29*X12;
+		prop[29*SM_LOCK_LANES+l] = k30*X13;
+		prop[30*SM_LOCK_LANES+l] = k31*X13;
+		prop[31*SM_LOCK_LANES+l] = k32*X14;
+		prop[32*SM_LOCK_LANES+l] = k33*X15*X14;
+		prop[33*SM_LOCK_LANES+l] = k34*X16*X14;
+		prop[34*SM_LOCK_LANES+l] = k35*X17*X14;
+		prop[35*SM_LOCK_LANES+l] = k36*X18*X14;
+		prop[36*SM_LOCK_LANES+l] = k37*X19;
+		prop[37*SM_LOCK_LANES+l] = k38*X18;
+		prop[38*SM_LOCK_LANES+l] = k39*X17;
+		prop[39*SM_LOCK_LANES+l] = k40*X16;
+		prop[40*SM_LOCK_LANES+l] = k41*X15;
+		prop[41*SM_LOCK_LANES+l] = k42*X16;
+		prop[42*SM_LOCK_LANES+l] = k43*X17;
+		prop[43*SM_LOCK_LANES+l] = k44*X18;
+		prop[44*SM_LOCK_LANES+l] = k45*X19;
+		prop[45*SM_LOCK_LANES+l] = k46*X20;
+		prop[46*SM_LOCK_LANES+l] = k47*X20;
+		prop[47*SM_LOCK_LANES+l] = k48*X21;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Stochrep, on an integer state array.
+ */
+void stochrep_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double X9 = X[8];
+	double X10 = X[9];
+	double X11 = X[10];
+	double X12 = X[11];
+	double X13 = X[12];
+	double X14 = X[13];
+	double X15 = X[14];
+	double X16 = X[15];
+	double X17 = X[16];
+	double X18 = X[17];
+	double X19 = X[18];
+	double X20 = X[19];
+	double X21 = X[20];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double k14 = params[13];
+	double k15 = params[14];
+	double k16 = params[15];
+	double k17 = params[16];
+	double k18 = params[17];
+	double k19 = params[18];
+	double k20 = params[19];
+	double k21 = params[20];
+	double k22 = params[21];
+	double k23 = params[22];
+	double k24 = params[23];
+	double k25 = params[24];
+	double k26 = params[25];
+	double k27 = params[26];
+	double k28 = params[27];
+	double k29 = params[28];
+	double k30 = params[29];
+	double k31 = params[30];
+	double k32 = params[31];
+	double k33 = params[32];
+	double k34 = params[33];
+	double k35 = params[34];
+	double k36 = params[35];
+	double k37 = params[36];
+	double k38 = params[37];
+	double k39 = params[38];
+	double k40 = params[39];
+	double k41 = params[40];
+	double k42 = params[41];
+	double k43 = params[42];
+	double k44 = params[43];
+	double k45 = params[44];
+	double k46 = params[45];
+	double k47 = params[46];
+	double k48 = params[47];
+
+	// Compute the propensities
+	prop[0] = k1*X1*X21;
+	prop[1] = k2*X2*X21;
+	prop[2] = k3*X3*X21;
+	prop[3] = k4*X4*X21;
+	prop[4] = k5*X5;
+	prop[5] = k6*X4;
+	prop[6] = k7*X3;
+	prop[7] = k8*X2;
+	prop[8] = k9*X1;
+	prop[9] = k10*X2;
+	prop[10] = k11*X3;
+	prop[11] = k12*X4;
+	prop[12] = k13*X5;
+	prop[13] = k14*X6;
+	prop[14] = k15*X6;
+	prop[15] = k16*X7;
+	prop[16] = k17*X8*X7;
+	prop[17] = k18*X9*X7;
+	prop[18] = k19*X10*X7;
+	prop[19] = k20*X11*X7;
+	prop[20] = k21*X12;
+	prop[21] = k22*X11;
+	prop[22] = k23*X10;
+	prop[23] = k24*X9;
+	prop[24] = k25*X8;
+	prop[25] = k26*X9;
+	prop[26] = k27*X10;
+	prop[27] = k28*X11;
+	prop[28] = k29*X12;
+	prop[29] = k30*X13;
+	prop[30] = k31*X13;
+	prop[31] = k32*X14;
+	prop[32] = k33*X15*X14;
+	prop[33] = k34*X16*X14;
+	prop[34] = k35*X17*X14;
+	prop[35] = k36*X18*X14;
+	prop[36] = k37*X19;
+	prop[37] = k38*X18;
+	prop[38] = k39*X17;
+	prop[39] = k40*X16;
+	prop[40] = k41*X15;
+	prop[41] = k42*X16;
+	prop[42] = k43*X17;
+	prop[43] = k44*X18;
+	prop[44] = k45*X19;
+	prop[45] = k46*X20;
+	prop[46] = k47*X20;
+	prop[47] = k48*X21;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Stochrep, on an integer state array.
+ */
+void stochrep_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k8 = params[7];
+			double k9 = params[8];
+			double k10 = params[9];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[7] = k8*X2;
+			prop[8] = k9*X1;
+			prop[9] = k10*X2;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 1:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k10 = params[9];
+			double k11 = params[10];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[6] = k7*X3;
+			prop[7] = k8*X2;
+			prop[9] = k10*X2;
+			prop[10] = k11*X3;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 2:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k6 = params[5];
+			double k7 = params[6];
+			double k11 = params[10];
+			double k12 = params[11];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[5] = k6*X4;
+			prop[6] = k7*X3;
+			prop[10] = k11*X3;
+			prop[11] = k12*X4;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 3:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X5 = X[4];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k5 = params[4];
+			double k6 = params[5];
+			double k12 = params[11];
+			double k13 = params[12];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[4] = k5*X5;
+			prop[5] = k6*X4;
+			prop[11] = k12*X4;
+			prop[12] = k13*X5;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 4:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X5 = X[4];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k5 = params[4];
+			double k6 = params[5];
+			double k12 = params[11];
+			double k13 = params[12];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[4] = k5*X5;
+			prop[5] = k6*X4;
+			prop[11] = k12*X4;
+			prop[12] = k13*X5;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 5:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k6 = params[5];
+			double k7 = params[6];
+			double k11 = params[10];
+			double k12 = params[11];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[5] = k6*X4;
+			prop[6] = k7*X3;
+			prop[10] = k11*X3;
+			prop[11] = k12*X4;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 6:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k7 = params[6];
+			double k8 = params[7];
+			double k10 = params[9];
+			double k11 = params[10];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[6] = k7*X3;
+			prop[7] = k8*X2;
+			prop[9] = k10*X2;
+			prop[10] = k11*X3;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 7:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k8 = params[7];
+			double k9 = params[8];
+			double k10 = params[9];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[7] = k8*X2;
+			prop[8] = k9*X1;
+			prop[9] = k10*X2;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 8:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 9:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 10:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 11:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 12:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 13:
+		{
+			double X6 = X[5];
+			double k14 = params[13];
+			double k15 = params[14];
+			prop[13] = k14*X6;
+			prop[14] = k15*X6;
+			break;
+		}
+
+		case 14:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			break;
+		}
+
+		case 15:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			break;
+		}
+
+		case 16:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k24 = params[23];
+			double k25 = params[24];
+			double k26 = params[25];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[23] = k24*X9;
+			prop[24] = k25*X8;
+			prop[25] = k26*X9;
+			break;
+		}
+
+		case 17:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k23 = params[22];
+			double k24 = params[23];
+			double k26 = params[25];
+			double k27 = params[26];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[22] = k23*X10;
+			prop[23] = k24*X9;
+			prop[25] = k26*X9;
+			prop[26] = k27*X10;
+			break;
+		}
+
+		case 18:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k22 = params[21];
+			double k23 = params[22];
+			double k27 = params[26];
+			double k28 = params[27];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[21] = k22*X11;
+			prop[22] = k23*X10;
+			prop[26] = k27*X10;
+			prop[27] = k28*X11;
+			break;
+		}
+
+		case 19:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double X12 = X[11];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k21 = params[20];
+			double k22 = params[21];
+			double k28 = params[27];
+			double k29 = params[28];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[20] = k21*X12;
+			prop[21] = k22*X11;
+			prop[27] = k28*X11;
+			prop[28] = k29*X12;
+			break;
+		}
+
+		case 20:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double X12 = X[11];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k21 = params[20];
+			double k22 = params[21];
+			double k28 = params[27];
+			double k29 = params[28];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[20] = k21*X12;
+			prop[21] = k22*X11;
+			prop[27] = k28*X11;
+			prop[28] = k29*X12;
+			break;
+		}
+
+		case 21:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k22 = params[21];
+			double k23 = params[22];
+			double k27 = params[26];
+			double k28 = params[27];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[21] = k22*X11;
+			prop[22] = k23*X10;
+			prop[26] = k27*X10;
+			prop[27] = k28*X11;
+			break;
+		}
+
+		case 22:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k23 = params[22];
+			double k24 = params[23];
+			double k26 = params[25];
+			double k27 = params[26];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[22] = k23*X10;
+			prop[23] = k24*X9;
+			prop[25] = k26*X9;
+			prop[26] = k27*X10;
+			break;
+		}
+
+		case 23:
+		{
+			double X7 = X[6];
+			double X8 = X[7];
+			double X9 = X[8];
+			double X10 = X[9];
+			double X11 = X[10];
+			double k16 = params[15];
+			double k17 = params[16];
+			double k18 = params[17];
+			double k19 = params[18];
+			double k20 = params[19];
+			double k24 = params[23];
+			double k25 = params[24];
+			double k26 = params[25];
+			prop[15] = k16*X7;
+			prop[16] = k17*X8*X7;
+			prop[17] = k18*X9*X7;
+			prop[18] = k19*X10*X7;
+			prop[19] = k20*X11*X7;
+			prop[23] = k24*X9;
+			prop[24] = k25*X8;
+			prop[25] = k26*X9;
+			break;
+		}
+
+		case 24:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 25:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 26:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 27:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 28:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 29:
+		{
+			double X13 = X[12];
+			double k30 = params[29];
+			double k31 = params[30];
+			prop[29] = k30*X13;
+			prop[30] = k31*X13;
+			break;
+		}
+
+		case 30:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			break;
+		}
+
+		case 31:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			break;
+		}
+
+		case 32:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k40 = params[39];
+			double k41 = params[40];
+			double k42 = params[41];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[39] = k40*X16;
+			prop[40] = k41*X15;
+			prop[41] = k42*X16;
+			break;
+		}
+
+		case 33:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k39 = params[38];
+			double k40 = params[39];
+			double k42 = params[41];
+			double k43 = params[42];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[38] = k39*X17;
+			prop[39] = k40*X16;
+			prop[41] = k42*X16;
+			prop[42] = k43*X17;
+			break;
+		}
+
+		case 34:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k38 = params[37];
+			double k39 = params[38];
+			double k43 = params[42];
+			double k44 = params[43];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[37] = k38*X18;
+			prop[38] = k39*X17;
+			prop[42] = k43*X17;
+			prop[43] = k44*X18;
+			break;
+		}
+
+		case 35:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double X19 = X[18];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k37 = params[36];
+			double k38 = params[37];
+			double k44 = params[43];
+			double k45 = params[44];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[36] = k37*X19;
+			prop[37] = k38*X18;
+			prop[43] = k44*X18;
+			prop[44] = k45*X19;
+			break;
+		}
+
+		case 36:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double X19 = X[18];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k37 = params[36];
+			double k38 = params[37];
+			double k44 = params[43];
+			double k45 = params[44];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[36] = k37*X19;
+			prop[37] = k38*X18;
+			prop[43] = k44*X18;
+			prop[44] = k45*X19;
+			break;
+		}
+
+		case 37:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k38 = params[37];
+			double k39 = params[38];
+			double k43 = params[42];
+			double k44 = params[43];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[37] = k38*X18;
+			prop[38] = k39*X17;
+			prop[42] = k43*X17;
+			prop[43] = k44*X18;
+			break;
+		}
+
+		case 38:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k39 = params[38];
+			double k40 = params[39];
+			double k42 = params[41];
+			double k43 = params[42];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[38] = k39*X17;
+			prop[39] = k40*X16;
+			prop[41] = k42*X16;
+			prop[42] = k43*X17;
+			break;
+		}
+
+		case 39:
+		{
+			double X14 = X[13];
+			double X15 = X[14];
+			double X16 = X[15];
+			double X17 = X[16];
+			double X18 = X[17];
+			double k32 = params[31];
+			double k33 = params[32];
+			double k34 = params[33];
+			double k35 = params[34];
+			double k36 = params[35];
+			double k40 = params[39];
+			double k41 = params[40];
+			double k42 = params[41];
+			prop[31] = k32*X14;
+			prop[32] = k33*X15*X14;
+			prop[33] = k34*X16*X14;
+			prop[34] = k35*X17*X14;
+			prop[35] = k36*X18*X14;
+			prop[39] = k40*X16;
+			prop[40] = k41*X15;
+			prop[41] = k42*X16;
+			break;
+		}
+
+		case 40:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 41:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 42:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 43:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 44:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 45:
+		{
+			double X20 = X[19];
+			double k46 = params[45];
+			double k47 = params[46];
+			prop[45] = k46*X20;
+			prop[46] = k47*X20;
+			break;
+		}
+
+		case 46:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[47] = k48*X21;
+			break;
+		}
+
+		case 47:
+		{
+			double X1 = X[0];
+			double X2 = X[1];
+			double X3 = X[2];
+			double X4 = X[3];
+			double X21 = X[20];
+			double k1 = params[0];
+			double k2 = params[1];
+			double k3 = params[2];
+			double k4 = params[3];
+			double k48 = params[47];
+			prop[0] = k1*X1*X21;
+			prop[1] = k2*X2*X21;
+			prop[2] = k3*X3*X21;
+			prop[3] = k4*X4*X21;
+			prop[47] = k48*X21;
+			break;
+		}
+	}
+}
+
+
+/**
+ State update function for Stochrep.
+ */
+int stochrep_state_update (gsl_vector * X, size_t rxnid)
+{
+	// Check sizes of state vector
+	if (X->size != 21)
+	{
+		printf("\n\n>> error in stochrep_state_update: state vector size is not correct...\n");
+		return GSL_EFAILED;
+	}
+	
+	// Check that reaction id is correct
+	if (rxnid>=48)
+	{
+		printf("\n\n>> error in stochrep_state_update: reaction id is not correct...\n");
+		return GSL_EFAILED;
+	}
+	
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			gsl_vector_set (X, 0, gsl_vector_get (X, 0) + (-1));
+			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+			break;
+			
+		case 1:
+			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (-1));
+			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+			break;
+			
+		case 2:
+			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (-1));
+			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+			break;
+			
+		case 3:
+			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (-1));
+			gsl_vector_set (X, 4, gsl_vector_get (X, 4) + (1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+			break;
+			
+		case 4:
+			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (1));
+			gsl_vector_set (X, 4, gsl_vector_get (X, 4) + (-1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+			break;
+			
+		case 5:
+			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (1));
+			gsl_vector_set (X, 3, gsl_vector_get (X, 3) + (-1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+			break;
+			
+		case 6:
+			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (1));
+			gsl_vector_set (X, 2, gsl_vector_get (X, 2) + (-1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+			break;
+			
+		case 7:
+			gsl_vector_set (X, 0, gsl_vector_get (X, 0) + (1));
+			gsl_vector_set (X, 1, gsl_vector_get (X, 1) + (-1));
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+			break;
+			
+		case 8:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+			break;
+			
+		case 9:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+			break;
+			
+		case 10:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+			break;
+			
+		case 11:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+			break;
+			
+		case 12:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (1));
+			break;
+			
+		case 13:
+			gsl_vector_set (X, 5, gsl_vector_get (X, 5) + (-1));
+			break;
+			
+		case 14:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+			break;
+			
+		case 15:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+			break;
+			
+		case 16:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+			gsl_vector_set (X, 7, gsl_vector_get (X, 7) + (-1));
+			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (1));
+			break;
+			
+		case 17:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (-1));
+			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (1));
+			break;
+			
+		case 18:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (-1));
+			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (1));
+			break;
+			
+		case 19:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (-1));
+			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (-1));
+			gsl_vector_set (X, 11, gsl_vector_get (X, 11) + (1));
+			break;
+			
+		case 20:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (1));
+			gsl_vector_set (X, 11, gsl_vector_get (X, 11) + (-1));
+			break;
+			
+		case 21:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (1));
+			gsl_vector_set (X, 10, gsl_vector_get (X, 10) + (-1));
+			break;
+			
+		case 22:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (1));
+			gsl_vector_set (X, 9, gsl_vector_get (X, 9) + (-1));
+			break;
+			
+		case 23:
+			gsl_vector_set (X, 6, gsl_vector_get (X, 6) + (1));
+			gsl_vector_set (X, 7, gsl_vector_get (X, 7) + (1));
+			gsl_vector_set (X, 8, gsl_vector_get (X, 8) + (-1));
+			break;
+			
+		case 24:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+			break;
+			
+		case 25:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+			break;
+			
+		case 26:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+			break;
+			
+		case 27:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+			break;
+			
+		case 28:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (1));
+			break;
+			
+		case 29:
+			gsl_vector_set (X, 12, gsl_vector_get (X, 12) + (-1));
+			break;
+			
+		case 30:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+			break;
+			
+		case 31:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+			break;
+			
+		case 32:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+			gsl_vector_set (X, 14, gsl_vector_get (X, 14) + (-1));
+			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (1));
+			break;
+			
+		case 33:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (-1));
+			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (1));
+			break;
+			
+		case 34:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (-1));
+			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (1));
+			break;
+			
+		case 35:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (-1));
+			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (-1));
+			gsl_vector_set (X, 18, gsl_vector_get (X, 18) + (1));
+			break;
+			
+		case 36:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (1));
+			gsl_vector_set (X, 18, gsl_vector_get (X, 18) + (-1));
+			break;
+			
+		case 37:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (1));
+			gsl_vector_set (X, 17, gsl_vector_get (X, 17) + (-1));
+			break;
+			
+		case 38:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (1));
+			gsl_vector_set (X, 16, gsl_vector_get (X, 16) + (-1));
+			break;
+			
+		case 39:
+			gsl_vector_set (X, 13, gsl_vector_get (X, 13) + (1));
+			gsl_vector_set (X, 14, gsl_vector_get (X, 14) + (1));
+			gsl_vector_set (X, 15, gsl_vector_get (X, 15) + (-1));
+			break;
+			
+		case 40:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+			break;
+			
+		case 41:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+			break;
+			
+		case 42:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+			break;
+			
+		case 43:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+			break;
+			
+		case 44:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (1));
+			break;
+			
+		case 45:
+			gsl_vector_set (X, 19, gsl_vector_get (X, 19) + (-1));
+			break;
+			
+		case 46:
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (1));
+			break;
+			
+		case 47:
+			gsl_vector_set (X, 20, gsl_vector_get (X, 20) + (-1));
+			break;
+			
+	}
+	
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked state update function for Stochrep, on a contiguous array.
+ */
+void stochrep_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] -= 1;
+			X[1] += 1;
+			X[20] -= 1;
+			break;
+
+		case 1:
+			X[1] -= 1;
+			X[2] += 1;
+			X[20] -= 1;
+			break;
+
+		case 2:
+			X[2] -= 1;
+			X[3] += 1;
+			X[20] -= 1;
+			break;
+
+		case 3:
+			X[3] -= 1;
+			X[4] += 1;
+			X[20] -= 1;
+			break;
+
+		case 4:
+			X[3] += 1;
+			X[4] -= 1;
+			X[20] += 1;
+			break;
+
+		case 5:
+			X[2] += 1;
+			X[3] -= 1;
+			X[20] += 1;
+			break;
+
+		case 6:
+			X[1] += 1;
+			X[2] -= 1;
+			X[20] += 1;
+			break;
+
+		case 7:
+			X[0] += 1;
+			X[1] -= 1;
+			X[20] += 1;
+			break;
+
+		case 8:
+			X[5] += 1;
+			break;
+
+		case 9:
+			X[5] += 1;
+			break;
+
+		case 10:
+			X[5] += 1;
+			break;
+
+		case 11:
+			X[5] += 1;
+			break;
+
+		case 12:
+			X[5] += 1;
+			break;
+
+		case 13:
+			X[5] -= 1;
+			break;
+
+		case 14:
+			X[6] += 1;
+			break;
+
+		case 15:
+			X[6] -= 1;
+			break;
+
+		case 16:
+			X[6] -= 1;
+			X[7] -= 1;
+			X[8] += 1;
+			break;
+
+		case 17:
+			X[6] -= 1;
+			X[8] -= 1;
+			X[9] += 1;
+			break;
+
+		case 18:
+			X[6] -= 1;
+			X[9] -= 1;
+			X[10] += 1;
+			break;
+
+		case 19:
+			X[6] -= 1;
+			X[10] -= 1;
+			X[11] += 1;
+			break;
+
+		case 20:
+			X[6] += 1;
+			X[10] += 1;
+			X[11] -= 1;
+			break;
+
+		case 21:
+			X[6] += 1;
+			X[9] += 1;
+			X[10] -= 1;
+			break;
+
+		case 22:
+			X[6] += 1;
+			X[8] += 1;
+			X[9] -= 1;
+			break;
+
+		case 23:
+			X[6] += 1;
+			X[7] += 1;
+			X[8] -= 1;
+			break;
+
+		case 24:
+			X[12] += 1;
+			break;
+
+		case 25:
+			X[12] += 1;
+			break;
+
+		case 26:
+			X[12] += 1;
+			break;
+
+		case 27:
+			X[12] += 1;
+			break;
+
+		case 28:
+			X[12] += 1;
+			break;
+
+		case 29:
+			X[12] -= 1;
+			break;
+
+		case 30:
+			X[13] += 1;
+			break;
+
+		case 31:
+			X[13] -= 1;
+			break;
+
+		case 32:
+			X[13] -= 1;
+			X[14] -= 1;
+			X[15] += 1;
+			break;
+
+		case 33:
+			X[13] -= 1;
+			X[15] -= 1;
+			X[16] += 1;
+			break;
+
+		case 34:
+			X[13] -= 1;
+			X[16] -= 1;
+			X[17] += 1;
+			break;
+
+		case 35:
+			X[13] -= 1;
+			X[17] -= 1;
+			X[18] += 1;
+			break;
+
+		case 36:
+			X[13] += 1;
+			X[17] += 1;
+			X[18] -= 1;
+			break;
+
+		case 37:
+			X[13] += 1;
+			X[16] += 1;
+			X[17] -= 1;
+			break;
+
+		case 38:
+			X[13] += 1;
+			X[15] += 1;
+			X[16] -= 1;
+			break;
+
+		case 39:
+			X[13] += 1;
+			X[14] += 1;
+			X[15] -= 1;
+			break;
+
+		case 40:
+			X[19] += 1;
+			break;
+
+		case 41:
+			X[19] += 1;
+			break;
+
+		case 42:
+			X[19] += 1;
+			break;
+
+		case 43:
+			X[19] += 1;
+			break;
+
+		case 44:
+			X[19] += 1;
+			break;
+
+		case 45:
+			X[19] -= 1;
+			break;
+
+		case 46:
+			X[20] += 1;
+			break;
+
+		case 47:
+			X[20] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Stochrep, on an integer state array.
+ */
+void stochrep_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] -= 1;
+			X[1] += 1;
+			X[20] -= 1;
+			break;
+
+		case 1:
+			X[1] -= 1;
+			X[2] += 1;
+			X[20] -= 1;
+			break;
+
+		case 2:
+			X[2] -= 1;
+			X[3] += 1;
+			X[20] -= 1;
+			break;
+
+		case 3:
+			X[3] -= 1;
+			X[4] += 1;
+			X[20] -= 1;
+			break;
+
+		case 4:
+			X[3] += 1;
+			X[4] -= 1;
+			X[20] += 1;
+			break;
+
+		case 5:
+			X[2] += 1;
+			X[3] -= 1;
+			X[20] += 1;
+			break;
+
+		case 6:
+			X[1] += 1;
+			X[2] -= 1;
+			X[20] += 1;
+			break;
+
+		case 7:
+			X[0] += 1;
+			X[1] -= 1;
+			X[20] += 1;
+			break;
+
+		case 8:
+			X[5] += 1;
+			break;
+
+		case 9:
+			X[5] += 1;
+			break;
+
+		case 10:
+			X[5] += 1;
+			break;
+
+		case 11:
+			X[5] += 1;
+			break;
+
+		case 12:
+			X[5] += 1;
+			break;
+
+		case 13:
+			X[5] -= 1;
+			break;
+
+		case 14:
+			X[6] += 1;
+			break;
+
+		case 15:
+			X[6] -= 1;
+			break;
+
+		case 16:
+			X[6] -= 1;
+			X[7] -= 1;
+			X[8] += 1;
+			break;
+
+		case 17:
+			X[6] -= 1;
+			X[8] -= 1;
+			X[9] += 1;
+			break;
+
+		case 18:
+			X[6] -= 1;
+			X[9] -= 1;
+			X[10] += 1;
+			break;
+
+		case 19:
+			X[6] -= 1;
+			X[10] -= 1;
+			X[11] += 1;
+			break;
+
+		case 20:
+			X[6] += 1;
+			X[10] += 1;
+			X[11] -= 1;
+			break;
+
+		case 21:
+			X[6] += 1;
+			X[9] += 1;
+			X[10] -= 1;
+			break;
+
+		case 22:
+			X[6] += 1;
+			X[8] += 1;
+			X[9] -= 1;
+			break;
+
+		case 23:
+			X[6] += 1;
+			X[7] += 1;
+			X[8] -= 1;
+			break;
+
+		case 24:
+			X[12] += 1;
+			break;
+
+		case 25:
+			X[12] += 1;
+			break;
+
+		case 26:
+			X[12] += 1;
+			break;
+
+		case 27:
+			X[12] += 1;
+			break;
+
+		case 28:
+			X[12] += 1;
+			break;
+
+		case 29:
+			X[12] -= 1;
+			break;
+
+		case 30:
+			X[13] += 1;
+			break;
+
+		case 31:
+			X[13] -= 1;
+			break;
+
+		case 32:
+			X[13] -= 1;
+			X[14] -= 1;
+			X[15] += 1;
+			break;
+
+		case 33:
+			X[13] -= 1;
+			X[15] -= 1;
+			X[16] += 1;
+			break;
+
+		case 34:
+			X[13] -= 1;
+			X[16] -= 1;
+			X[17] += 1;
+			break;
+
+		case 35:
+			X[13] -= 1;
+			X[17] -= 1;
+			X[18] += 1;
+			break;
+
+		case 36:
+			X[13] += 1;
+			X[17] += 1;
+			X[18] -= 1;
+			break;
+
+		case 37:
+			X[13] += 1;
+			X[16] += 1;
+			X[17] -= 1;
+			break;
+
+		case 38:
+			X[13] += 1;
+			X[15] += 1;
+			X[16] -= 1;
+			break;
+
+		case 39:
+			X[13] += 1;
+			X[14] += 1;
+			X[15] -= 1;
+			break;
+
+		case 40:
+			X[19] += 1;
+			break;
+
+		case 41:
+			X[19] += 1;
+			break;
+
+		case 42:
+			X[19] += 1;
+			break;
+
+		case 43:
+			X[19] += 1;
+			break;
+
+		case 44:
+			X[19] += 1;
+			break;
+
+		case 45:
+			X[19] -= 1;
+			break;
+
+		case 46:
+			X[20] += 1;
+			break;
+
+		case 47:
+			X[20] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Stoichiometry of Stochrep in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t stochrep_stoich_ptr[49] = {
+	0, 3, 6, 9, 12, 15, 18, 21, 24, 25, 26, 27, 28, 29, 30, 31, 32, 35, 38, 41, 44, 47,
+	50, 53, 56, 57, 58, 59, 60, 61, 62, 63, 64, 67, 70, 73, 76, 79, 82, 85, 88, 89, 90,
+	91, 92, 93, 94, 95, 96
+};
+static const size_t stochrep_stoich_idx[96] = {
+	0, 1, 20,
+	1, 2, 20,
+	2, 3, 20,
+	3, 4, 20,
+	3, 4, 20,
+	2, 3, 20,
+	1, 2, 20,
+	0, 1, 20,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	6,
+	6, 7, 8,
+	6, 8, 9,
+	6, 9, 10,
+	6, 10, 11,
+	6, 10, 11,
+	6, 9, 10,
+	6, 8, 9,
+	6, 7, 8,
+	12,
+	12,
+	12,
+	12,
+	12,
+	12,
+	13,
+	13,
+	13, 14, 15,
+	13, 15, 16,
+	13, 16, 17,
+	13, 17, 18,
+	13, 17, 18,
+	13, 16, 17,
+	13, 15, 16,
+	13, 14, 15,
+	19,
+	19,
+	19,
+	19,
+	19,
+	19,
+	20,
+	20
+};
+static const int stochrep_stoich_val[96] = {
+	-1, 1, -1,
+	-1, 1, -1,
+	-1, 1, -1,
+	-1, 1, -1,
+	1, -1, 1,
+	1, -1, 1,
+	1, -1, 1,
+	1, -1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	-1,
+	1,
+	-1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	-1,
+	1,
+	-1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	-1, -1, 1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1, 1, -1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	-1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of Stochrep in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t stochrep_react_ptr[49] = {
+	0, 2, 4, 6, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 22, 24, 26, 28, 29, 30,
+	31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 42, 44, 46, 48, 49, 50, 51, 52, 53, 54, 55,
+	56, 57, 58, 59, 60
+};
+static const size_t stochrep_react_idx[60] = {
+	0, 20,
+	1, 20,
+	2, 20,
+	3, 20,
+	4,
+	3,
+	2,
+	1,
+	0,
+	1,
+	2,
+	3,
+	4,
+	5,
+	5,
+	6,
+	6, 7,
+	6, 8,
+	6, 9,
+	6, 10,
+	11,
+	10,
+	9,
+	8,
+	7,
+	8,
+	9,
+	10,
+	11,
+	12,
+	12,
+	13,
+	13, 14,
+	13, 15,
+	13, 16,
+	13, 17,
+	18,
+	17,
+	16,
+	15,
+	14,
+	15,
+	16,
+	17,
+	18,
+	19,
+	19,
+	20
+};
+static const int stochrep_react_val[60] = {
+	1, 1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Stochrep.
  */
 void stochrep_mod_setup (stochmod * model)
 {
 	model->propensity = &stochrep_propensity_eval;
+	model->propensity_update = &stochrep_propensity_update;
+	model->jacobian = &stochrep_propensity_jacobian;
+	model->hessian = &stochrep_propensity_hessian;
+	model->rate_raw = &stochrep_propensity_raw;
+	model->rate_jacobian = &stochrep_propensity_jacobian;
 	model->update = &stochrep_state_update;
+	model->propensity_raw = &stochrep_propensity_raw;
+	model->propensity_update_raw = &stochrep_propensity_update_raw;
+	model->update_raw = &stochrep_state_update_raw;
+	model->propensity_lanes = &stochrep_propensity_lanes;
+	model->propensity_int = &stochrep_propensity_int;
+	model->propensity_update_int = &stochrep_propensity_update_int;
+	model->update_int = &stochrep_state_update_int;
+	model->initial_int = NULL;
+	model->output = NULL;
+	model->output_int = NULL;
 	model->initial = NULL;
 	model->nspecies = 21;
 	model->nrxns = 48;
@@ -450,5 +4731,12 @@ void stochrep_mod_setup (stochmod * model)
 	model->nin = 0;
 	model->nout = 3;
 	model->name = "Stochastic Repressilator (STOCHREP)";
+	model->stoich_ptr = stochrep_stoich_ptr;
+	model->stoich_idx = stochrep_stoich_idx;
+	model->stoich_val = stochrep_stoich_val;
+	model->react_ptr = stochrep_react_ptr;
+	model->react_idx = stochrep_react_idx;
+	model->react_val = stochrep_react_val;
+	model->graph = NULL;
 }
 
@@ -0,0 +1,127 @@
+/*
+ *  stoich.c
+ *  StochMod
+ *
+ *	Table-driven state updates from the model stoichiometry
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+
+
+/**
+ Update the state vector after reaction rxnid fired, using the stoichiometry
+ table exported by the model. Models that do not export a table fall back to
+ their own update function.
+ */
+int sm_stoich_update (const stochmod * model, gsl_vector * X, size_t rxnid)
+{
+	if (model->stoich_ptr == NULL)
+		return model->update (X, rxnid);
+
+	// Check sizes of state vector
+	if (X->size != model->nspecies)
+	{
+		fprintf (stderr, "error in sm_stoich_update: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= model->nrxns)
+	{
+		fprintf (stderr, "error in sm_stoich_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Apply the non-zero entries of the stoichiometry row
+	double * x = X->data;
+	size_t stride = X->stride;
+	for (size_t k = model->stoich_ptr[rxnid]; k < model->stoich_ptr[rxnid+1]; k++)
+		x[model->stoich_idx[k] * stride] += model->stoich_val[k];
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Same as sm_stoich_update, on an integer state vector. Models that do not export
+ a table fall back to their integer update function.
+ */
+int sm_stoich_update_int (const stochmod * model, gsl_vector_int * X, size_t rxnid)
+{
+	// Check sizes of state vector
+	if (X->size != model->nspecies)
+	{
+		fprintf (stderr, "error in sm_stoich_update_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= model->nrxns)
+	{
+		fprintf (stderr, "error in sm_stoich_update_int: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	int * x = X->data;
+	size_t stride = X->stride;
+	if (model->stoich_ptr == NULL)
+	{
+		if ((model->update_int == NULL) || (stride != 1))
+		{
+			fprintf (stderr, "error in sm_stoich_update_int: model does not support integer states\n");
+			return GSL_EFAILED;
+		}
+		model->update_int (x, rxnid);
+		return GSL_SUCCESS;
+	}
+
+	// Apply the non-zero entries of the stoichiometry row
+	for (size_t k = model->stoich_ptr[rxnid]; k < model->stoich_ptr[rxnid+1]; k++)
+		x[model->stoich_idx[k] * stride] += model->stoich_val[k];
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Copy the stoichiometry of the model into a dense nspecies x nrxns matrix.
+ */
+int sm_stoich_matrix (const stochmod * model, gsl_matrix * S)
+{
+	if ((S->size1 != model->nspecies) || (S->size2 != model->nrxns))
+	{
+		fprintf (stderr, "error in sm_stoich_matrix: matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (model->stoich_ptr == NULL)
+	{
+		fprintf (stderr, "error in sm_stoich_matrix: model does not export its stoichiometry\n");
+		return GSL_EFAILED;
+	}
+
+	gsl_matrix_set_zero (S);
+	for (size_t j = 0; j < model->nrxns; j++)
+		for (size_t k = model->stoich_ptr[j]; k < model->stoich_ptr[j+1]; k++)
+			gsl_matrix_set (S, model->stoich_idx[k], j, model->stoich_val[k]);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
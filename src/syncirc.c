@@ -119,6 +119,861 @@ int syncirc_propensity_eval (const gsl_vector * X, const gsl_vector * params, gs
 }
 
 
+/**
+ Incremental propensity update function for Syncirc.
+ */
+int syncirc_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != 10) || (params->size != 16) || (prop->size != 16))
+	{
+		printf("\n\n>> error in syncirc_propensity_update: vector sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid>=16)
+	{
+		printf("\n\n>> error in syncirc_propensity_update: reaction id is not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double a = gsl_vector_get (X, 0);
+			double gamma_a = gsl_vector_get (params, 1);
+			double alpha_A = gsl_vector_get (params, 2);
+			gsl_vector_set (prop, 1, gamma_a*a);
+			gsl_vector_set (prop, 2, alpha_A*a);
+			break;
+		}
+
+		case 1:
+		{
+			double a = gsl_vector_get (X, 0);
+			double gamma_a = gsl_vector_get (params, 1);
+			double alpha_A = gsl_vector_get (params, 2);
+			gsl_vector_set (prop, 1, gamma_a*a);
+			gsl_vector_set (prop, 2, alpha_A*a);
+			break;
+		}
+
+		case 2:
+		{
+			double A = gsl_vector_get (X, 3);
+			double Pb = gsl_vector_get (X, 6);
+			double mu_A = gsl_vector_get (params, 3);
+			double kd_A = gsl_vector_get (params, 4);
+			gsl_vector_set (prop, 3, mu_A*A);
+			gsl_vector_set (prop, 4, kd_A*A*Pb);
+			break;
+		}
+
+		case 3:
+		{
+			double A = gsl_vector_get (X, 3);
+			double Pb = gsl_vector_get (X, 6);
+			double mu_A = gsl_vector_get (params, 3);
+			double kd_A = gsl_vector_get (params, 4);
+			gsl_vector_set (prop, 3, mu_A*A);
+			gsl_vector_set (prop, 4, kd_A*A*Pb);
+			break;
+		}
+
+		case 4:
+		{
+			double A = gsl_vector_get (X, 3);
+			double Pb = gsl_vector_get (X, 6);
+			double PbA = gsl_vector_get (X, 8);
+			double mu_A = gsl_vector_get (params, 3);
+			double kd_A = gsl_vector_get (params, 4);
+			double kr_A = gsl_vector_get (params, 5);
+			double kappa_b = gsl_vector_get (params, 6);
+			gsl_vector_set (prop, 3, mu_A*A);
+			gsl_vector_set (prop, 4, kd_A*A*Pb);
+			gsl_vector_set (prop, 5, kr_A*PbA);
+			gsl_vector_set (prop, 6, kappa_b*Pb);
+			break;
+		}
+
+		case 5:
+		{
+			double A = gsl_vector_get (X, 3);
+			double Pb = gsl_vector_get (X, 6);
+			double PbA = gsl_vector_get (X, 8);
+			double mu_A = gsl_vector_get (params, 3);
+			double kd_A = gsl_vector_get (params, 4);
+			double kr_A = gsl_vector_get (params, 5);
+			double kappa_b = gsl_vector_get (params, 6);
+			gsl_vector_set (prop, 3, mu_A*A);
+			gsl_vector_set (prop, 4, kd_A*A*Pb);
+			gsl_vector_set (prop, 5, kr_A*PbA);
+			gsl_vector_set (prop, 6, kappa_b*Pb);
+			break;
+		}
+
+		case 6:
+		{
+			double b = gsl_vector_get (X, 1);
+			double gamma_b = gsl_vector_get (params, 7);
+			double alpha_B = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 7, gamma_b*b);
+			gsl_vector_set (prop, 8, alpha_B*b);
+			break;
+		}
+
+		case 7:
+		{
+			double b = gsl_vector_get (X, 1);
+			double gamma_b = gsl_vector_get (params, 7);
+			double alpha_B = gsl_vector_get (params, 8);
+			gsl_vector_set (prop, 7, gamma_b*b);
+			gsl_vector_set (prop, 8, alpha_B*b);
+			break;
+		}
+
+		case 8:
+		{
+			double B = gsl_vector_get (X, 4);
+			double Pc = gsl_vector_get (X, 7);
+			double mu_B = gsl_vector_get (params, 9);
+			double kd_B = gsl_vector_get (params, 10);
+			gsl_vector_set (prop, 9, mu_B*B);
+			gsl_vector_set (prop, 10, kd_B*B*Pc);
+			break;
+		}
+
+		case 9:
+		{
+			double B = gsl_vector_get (X, 4);
+			double Pc = gsl_vector_get (X, 7);
+			double mu_B = gsl_vector_get (params, 9);
+			double kd_B = gsl_vector_get (params, 10);
+			gsl_vector_set (prop, 9, mu_B*B);
+			gsl_vector_set (prop, 10, kd_B*B*Pc);
+			break;
+		}
+
+		case 10:
+		{
+			double B = gsl_vector_get (X, 4);
+			double Pc = gsl_vector_get (X, 7);
+			double PcB = gsl_vector_get (X, 9);
+			double mu_B = gsl_vector_get (params, 9);
+			double kd_B = gsl_vector_get (params, 10);
+			double kr_B = gsl_vector_get (params, 11);
+			double kappa_c = gsl_vector_get (params, 12);
+			gsl_vector_set (prop, 9, mu_B*B);
+			gsl_vector_set (prop, 10, kd_B*B*Pc);
+			gsl_vector_set (prop, 11, kr_B*PcB);
+			gsl_vector_set (prop, 12, kappa_c*Pc);
+			break;
+		}
+
+		case 11:
+		{
+			double B = gsl_vector_get (X, 4);
+			double Pc = gsl_vector_get (X, 7);
+			double PcB = gsl_vector_get (X, 9);
+			double mu_B = gsl_vector_get (params, 9);
+			double kd_B = gsl_vector_get (params, 10);
+			double kr_B = gsl_vector_get (params, 11);
+			double kappa_c = gsl_vector_get (params, 12);
+			gsl_vector_set (prop, 9, mu_B*B);
+			gsl_vector_set (prop, 10, kd_B*B*Pc);
+			gsl_vector_set (prop, 11, kr_B*PcB);
+			gsl_vector_set (prop, 12, kappa_c*Pc);
+			break;
+		}
+
+		case 12:
+		{
+			double c = gsl_vector_get (X, 2);
+			double gamma_c = gsl_vector_get (params, 13);
+			double alpha_C = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, gamma_c*c);
+			gsl_vector_set (prop, 14, alpha_C*c);
+			break;
+		}
+
+		case 13:
+		{
+			double c = gsl_vector_get (X, 2);
+			double gamma_c = gsl_vector_get (params, 13);
+			double alpha_C = gsl_vector_get (params, 14);
+			gsl_vector_set (prop, 13, gamma_c*c);
+			gsl_vector_set (prop, 14, alpha_C*c);
+			break;
+		}
+
+		case 14:
+		{
+			double C = gsl_vector_get (X, 5);
+			double mu_C = gsl_vector_get (params, 15);
+			gsl_vector_set (prop, 15, mu_C*C);
+			break;
+		}
+
+		case 15:
+		{
+			double C = gsl_vector_get (X, 5);
+			double mu_C = gsl_vector_get (params, 15);
+			gsl_vector_set (prop, 15, mu_C*C);
+			break;
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for Syncirc: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int syncirc_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 10) || (params->size != 16) || (J->size1 != 16) || (J->size2 != 10))
+	{
+		printf("\n\n>> error in syncirc_propensity_jacobian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double A = gsl_vector_get (X, 3);
+	double B = gsl_vector_get (X, 4);
+	double Pb = gsl_vector_get (X, 6);
+	double Pc = gsl_vector_get (X, 7);
+
+	// Get the parameters
+	double gamma_a = gsl_vector_get (params, 1);
+	double alpha_A = gsl_vector_get (params, 2);
+	double mu_A = gsl_vector_get (params, 3);
+	double kd_A = gsl_vector_get (params, 4);
+	double kr_A = gsl_vector_get (params, 5);
+	double kappa_b = gsl_vector_get (params, 6);
+	double gamma_b = gsl_vector_get (params, 7);
+	double alpha_B = gsl_vector_get (params, 8);
+	double mu_B = gsl_vector_get (params, 9);
+	double kd_B = gsl_vector_get (params, 10);
+	double kr_B = gsl_vector_get (params, 11);
+	double kappa_c = gsl_vector_get (params, 12);
+	double gamma_c = gsl_vector_get (params, 13);
+	double alpha_C = gsl_vector_get (params, 14);
+	double mu_C = gsl_vector_get (params, 15);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 1, 0, gamma_a);
+	gsl_matrix_set (J, 2, 0, alpha_A);
+	gsl_matrix_set (J, 3, 3, mu_A);
+	gsl_matrix_set (J, 4, 3, kd_A*Pb);
+	gsl_matrix_set (J, 4, 6, kd_A*A);
+	gsl_matrix_set (J, 5, 8, kr_A);
+	gsl_matrix_set (J, 6, 6, kappa_b);
+	gsl_matrix_set (J, 7, 1, gamma_b);
+	gsl_matrix_set (J, 8, 1, alpha_B);
+	gsl_matrix_set (J, 9, 4, mu_B);
+	gsl_matrix_set (J, 10, 4, kd_B*Pc);
+	gsl_matrix_set (J, 10, 7, kd_B*B);
+	gsl_matrix_set (J, 11, 9, kr_B);
+	gsl_matrix_set (J, 12, 7, kappa_c);
+	gsl_matrix_set (J, 13, 2, gamma_c);
+	gsl_matrix_set (J, 14, 2, alpha_C);
+	gsl_matrix_set (J, 15, 5, mu_C);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for Syncirc: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int syncirc_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != 10) || (params->size != 16) || (H->size1 != 16) || (H->size2 != 100))
+	{
+		printf("\n\n>> error in syncirc_propensity_hessian: vector or matrix sizes are not correct...\n");
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double kd_A = gsl_vector_get (params, 4);
+	double kd_B = gsl_vector_get (params, 10);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 4, 36, kd_A);
+	gsl_matrix_set (H, 4, 63, kd_A);
+	gsl_matrix_set (H, 10, 47, kd_B);
+	gsl_matrix_set (H, 10, 74, kd_B);
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked propensity evaluation function for Syncirc, on contiguous arrays.
+ */
+void syncirc_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double a = X[0];
+	double b = X[1];
+	double c = X[2];
+	double A = X[3];
+	double B = X[4];
+	double C = X[5];
+	double Pb = X[6];
+	double Pc = X[7];
+	double PbA = X[8];
+	double PcB = X[9];
+	double kappa_a = params[0];
+	double gamma_a = params[1];
+	double alpha_A = params[2];
+	double mu_A = params[3];
+	double kd_A = params[4];
+	double kr_A = params[5];
+	double kappa_b = params[6];
+	double gamma_b = params[7];
+	double alpha_B = params[8];
+	double mu_B = params[9];
+	double kd_B = params[10];
+	double kr_B = params[11];
+	double kappa_c = params[12];
+	double gamma_c = params[13];
+	double alpha_C = params[14];
+	double mu_C = params[15];
+
+	// Compute the propensities
+	prop[0] = kappa_a*2;
+	prop[1] = gamma_a*a;
+	prop[2] = alpha_A*a;
+	prop[3] = mu_A*A;
+	prop[4] = kd_A*A*Pb;
+	prop[5] = kr_A*PbA;
+	prop[6] = kappa_b*Pb;
+	prop[7] = gamma_b*b;
+	prop[8] = alpha_B*b;
+	prop[9] = mu_B*B;
+	prop[10] = kd_B*B*Pc;
+	prop[11] = kr_B*PcB;
+	prop[12] = kappa_c*Pc;
+	prop[13] = gamma_c*c;
+	prop[14] = alpha_C*c;
+	prop[15] = mu_C*C;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Syncirc, on contiguous arrays.
+ */
+void syncirc_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double a = X[0];
+			double gamma_a = params[1];
+			double alpha_A = params[2];
+			prop[1] = gamma_a*a;
+			prop[2] = alpha_A*a;
+			break;
+		}
+
+		case 1:
+		{
+			double a = X[0];
+			double gamma_a = params[1];
+			double alpha_A = params[2];
+			prop[1] = gamma_a*a;
+			prop[2] = alpha_A*a;
+			break;
+		}
+
+		case 2:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			break;
+		}
+
+		case 3:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			break;
+		}
+
+		case 4:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double PbA = X[8];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			double kr_A = params[5];
+			double kappa_b = params[6];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			prop[5] = kr_A*PbA;
+			prop[6] = kappa_b*Pb;
+			break;
+		}
+
+		case 5:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double PbA = X[8];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			double kr_A = params[5];
+			double kappa_b = params[6];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			prop[5] = kr_A*PbA;
+			prop[6] = kappa_b*Pb;
+			break;
+		}
+
+		case 6:
+		{
+			double b = X[1];
+			double gamma_b = params[7];
+			double alpha_B = params[8];
+			prop[7] = gamma_b*b;
+			prop[8] = alpha_B*b;
+			break;
+		}
+
+		case 7:
+		{
+			double b = X[1];
+			double gamma_b = params[7];
+			double alpha_B = params[8];
+			prop[7] = gamma_b*b;
+			prop[8] = alpha_B*b;
+			break;
+		}
+
+		case 8:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			break;
+		}
+
+		case 9:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			break;
+		}
+
+		case 10:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double PcB = X[9];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			double kr_B = params[11];
+			double kappa_c = params[12];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			prop[11] = kr_B*PcB;
+			prop[12] = kappa_c*Pc;
+			break;
+		}
+
+		case 11:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double PcB = X[9];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			double kr_B = params[11];
+			double kappa_c = params[12];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			prop[11] = kr_B*PcB;
+			prop[12] = kappa_c*Pc;
+			break;
+		}
+
+		case 12:
+		{
+			double c = X[2];
+			double gamma_c = params[13];
+			double alpha_C = params[14];
+			prop[13] = gamma_c*c;
+			prop[14] = alpha_C*c;
+			break;
+		}
+
+		case 13:
+		{
+			double c = X[2];
+			double gamma_c = params[13];
+			double alpha_C = params[14];
+			prop[13] = gamma_c*c;
+			prop[14] = alpha_C*c;
+			break;
+		}
+
+		case 14:
+		{
+			double C = X[5];
+			double mu_C = params[15];
+			prop[15] = mu_C*C;
+			break;
+		}
+
+		case 15:
+		{
+			double C = X[5];
+			double mu_C = params[15];
+			prop[15] = mu_C*C;
+			break;
+		}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Syncirc, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void syncirc_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double kappa_a = params[0];
+	double gamma_a = params[1];
+	double alpha_A = params[2];
+	double mu_A = params[3];
+	double kd_A = params[4];
+	double kr_A = params[5];
+	double kappa_b = params[6];
+	double gamma_b = params[7];
+	double alpha_B = params[8];
+	double mu_B = params[9];
+	double kd_B = params[10];
+	double kr_B = params[11];
+	double kappa_c = params[12];
+	double gamma_c = params[13];
+	double alpha_C = params[14];
+	double mu_C = params[15];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double a = X[l];
+		double b = X[SM_LOCK_LANES+l];
+		double c = X[2*SM_LOCK_LANES+l];
+		double A = X[3*SM_LOCK_LANES+l];
+		double B = X[4*SM_LOCK_LANES+l];
+		double C = X[5*SM_LOCK_LANES+l];
+		double Pb = X[6*SM_LOCK_LANES+l];
+		double Pc = X[7*SM_LOCK_LANES+l];
+		double PbA = X[8*SM_LOCK_LANES+l];
+		double PcB = X[9*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = kappa_a*2;
+		prop[SM_LOCK_LANES+l] = gamma_a*a;
+		prop[2*SM_LOCK_LANES+l] = alpha_A*a;
+		prop[3*SM_LOCK_LANES+l] = mu_A*A;
+		prop[4*SM_LOCK_LANES+l] = kd_A*A*Pb;
+		prop[5*SM_LOCK_LANES+l] = kr_A*PbA;
+		prop[6*SM_LOCK_LANES+l] = kappa_b*Pb;
+		prop[7*SM_LOCK_LANES+l] = gamma_b*b;
+		prop[8*SM_LOCK_LANES+l] = alpha_B*b;
+		prop[9*SM_LOCK_LANES+l] = mu_B*B;
+		prop[10*SM_LOCK_LANES+l] = kd_B*B*Pc;
+		prop[11*SM_LOCK_LANES+l] = kr_B*PcB;
+		prop[12*SM_LOCK_LANES+l] = kappa_c*Pc;
+		prop[13*SM_LOCK_LANES+l] = gamma_c*c;
+		prop[14*SM_LOCK_LANES+l] = alpha_C*c;
+		prop[15*SM_LOCK_LANES+l] = mu_C*C;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for Syncirc, on an integer state array.
+ */
+void syncirc_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double a = X[0];
+	double b = X[1];
+	double c = X[2];
+	double A = X[3];
+	double B = X[4];
+	double C = X[5];
+	double Pb = X[6];
+	double Pc = X[7];
+	double PbA = X[8];
+	double PcB = X[9];
+	double kappa_a = params[0];
+	double gamma_a = params[1];
+	double alpha_A = params[2];
+	double mu_A = params[3];
+	double kd_A = params[4];
+	double kr_A = params[5];
+	double kappa_b = params[6];
+	double gamma_b = params[7];
+	double alpha_B = params[8];
+	double mu_B = params[9];
+	double kd_B = params[10];
+	double kr_B = params[11];
+	double kappa_c = params[12];
+	double gamma_c = params[13];
+	double alpha_C = params[14];
+	double mu_C = params[15];
+
+	// Compute the propensities
+	prop[0] = kappa_a*2;
+	prop[1] = gamma_a*a;
+	prop[2] = alpha_A*a;
+	prop[3] = mu_A*A;
+	prop[4] = kd_A*A*Pb;
+	prop[5] = kr_A*PbA;
+	prop[6] = kappa_b*Pb;
+	prop[7] = gamma_b*b;
+	prop[8] = alpha_B*b;
+	prop[9] = mu_B*B;
+	prop[10] = kd_B*B*Pc;
+	prop[11] = kr_B*PcB;
+	prop[12] = kappa_c*Pc;
+	prop[13] = gamma_c*c;
+	prop[14] = alpha_C*c;
+	prop[15] = mu_C*C;
+}
+
+
+/**
+ Unchecked incremental propensity update function for Syncirc, on an integer state array.
+ */
+void syncirc_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid) {
+		case 0:
+		{
+			double a = X[0];
+			double gamma_a = params[1];
+			double alpha_A = params[2];
+			prop[1] = gamma_a*a;
+			prop[2] = alpha_A*a;
+			break;
+		}
+
+		case 1:
+		{
+			double a = X[0];
+			double gamma_a = params[1];
+			double alpha_A = params[2];
+			prop[1] = gamma_a*a;
+			prop[2] = alpha_A*a;
+			break;
+		}
+
+		case 2:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			break;
+		}
+
+		case 3:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			break;
+		}
+
+		case 4:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double PbA = X[8];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			double kr_A = params[5];
+			double kappa_b = params[6];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			prop[5] = kr_A*PbA;
+			prop[6] = kappa_b*Pb;
+			break;
+		}
+
+		case 5:
+		{
+			double A = X[3];
+			double Pb = X[6];
+			double PbA = X[8];
+			double mu_A = params[3];
+			double kd_A = params[4];
+			double kr_A = params[5];
+			double kappa_b = params[6];
+			prop[3] = mu_A*A;
+			prop[4] = kd_A*A*Pb;
+			prop[5] = kr_A*PbA;
+			prop[6] = kappa_b*Pb;
+			break;
+		}
+
+		case 6:
+		{
+			double b = X[1];
+			double gamma_b = params[7];
+			double alpha_B = params[8];
+			prop[7] = gamma_b*b;
+			prop[8] = alpha_B*b;
+			break;
+		}
+
+		case 7:
+		{
+			double b = X[1];
+			double gamma_b = params[7];
+			double alpha_B = params[8];
+			prop[7] = gamma_b*b;
+			prop[8] = alpha_B*b;
+			break;
+		}
+
+		case 8:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			break;
+		}
+
+		case 9:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			break;
+		}
+
+		case 10:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double PcB = X[9];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			double kr_B = params[11];
+			double kappa_c = params[12];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			prop[11] = kr_B*PcB;
+			prop[12] = kappa_c*Pc;
+			break;
+		}
+
+		case 11:
+		{
+			double B = X[4];
+			double Pc = X[7];
+			double PcB = X[9];
+			double mu_B = params[9];
+			double kd_B = params[10];
+			double kr_B = params[11];
+			double kappa_c = params[12];
+			prop[9] = mu_B*B;
+			prop[10] = kd_B*B*Pc;
+			prop[11] = kr_B*PcB;
+			prop[12] = kappa_c*Pc;
+			break;
+		}
+
+		case 12:
+		{
+			double c = X[2];
+			double gamma_c = params[13];
+			double alpha_C = params[14];
+			prop[13] = gamma_c*c;
+			prop[14] = alpha_C*c;
+			break;
+		}
+
+		case 13:
+		{
+			double c = X[2];
+			double gamma_c = params[13];
+			double alpha_C = params[14];
+			prop[13] = gamma_c*c;
+			prop[14] = alpha_C*c;
+			break;
+		}
+
+		case 14:
+		{
+			double C = X[5];
+			double mu_C = params[15];
+			prop[15] = mu_C*C;
+			break;
+		}
+
+		case 15:
+		{
+			double C = X[5];
+			double mu_C = params[15];
+			prop[15] = mu_C*C;
+			break;
+		}
+	}
+}
+
+
 /**
  State update function for Syncirc.
  */
@@ -259,13 +1114,281 @@ int syncirc_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for Syncirc, on a contiguous array.
+ */
+void syncirc_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] += 1;
+			break;
+
+		case 1:
+			X[0] -= 1;
+			break;
+
+		case 2:
+			X[3] += 1;
+			break;
+
+		case 3:
+			X[3] -= 1;
+			break;
+
+		case 4:
+			X[3] -= 1;
+			X[6] -= 1;
+			X[8] += 1;
+			break;
+
+		case 5:
+			X[3] += 1;
+			X[6] += 1;
+			X[8] -= 1;
+			break;
+
+		case 6:
+			X[1] += 1;
+			break;
+
+		case 7:
+			X[1] -= 1;
+			break;
+
+		case 8:
+			X[4] += 1;
+			break;
+
+		case 9:
+			X[4] -= 1;
+			break;
+
+		case 10:
+			X[4] -= 1;
+			X[7] -= 1;
+			X[9] += 1;
+			break;
+
+		case 11:
+			X[4] += 1;
+			X[7] += 1;
+			X[9] -= 1;
+			break;
+
+		case 12:
+			X[2] += 1;
+			break;
+
+		case 13:
+			X[2] -= 1;
+			break;
+
+		case 14:
+			X[5] += 1;
+			break;
+
+		case 15:
+			X[5] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Unchecked state update function for Syncirc, on an integer state array.
+ */
+void syncirc_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid) {
+		case 0:
+			X[0] += 1;
+			break;
+
+		case 1:
+			X[0] -= 1;
+			break;
+
+		case 2:
+			X[3] += 1;
+			break;
+
+		case 3:
+			X[3] -= 1;
+			break;
+
+		case 4:
+			X[3] -= 1;
+			X[6] -= 1;
+			X[8] += 1;
+			break;
+
+		case 5:
+			X[3] += 1;
+			X[6] += 1;
+			X[8] -= 1;
+			break;
+
+		case 6:
+			X[1] += 1;
+			break;
+
+		case 7:
+			X[1] -= 1;
+			break;
+
+		case 8:
+			X[4] += 1;
+			break;
+
+		case 9:
+			X[4] -= 1;
+			break;
+
+		case 10:
+			X[4] -= 1;
+			X[7] -= 1;
+			X[9] += 1;
+			break;
+
+		case 11:
+			X[4] += 1;
+			X[7] += 1;
+			X[9] -= 1;
+			break;
+
+		case 12:
+			X[2] += 1;
+			break;
+
+		case 13:
+			X[2] -= 1;
+			break;
+
+		case 14:
+			X[5] += 1;
+			break;
+
+		case 15:
+			X[5] -= 1;
+			break;
+	}
+}
+
+
+/**
+ Stoichiometry of Syncirc in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t syncirc_stoich_ptr[17] = {
+	0, 1, 2, 3, 4, 7, 10, 11, 12, 13, 14, 17, 20, 21, 22, 23, 24
+};
+static const size_t syncirc_stoich_idx[24] = {
+	0,
+	0,
+	3,
+	3,
+	3, 6, 8,
+	3, 6, 8,
+	1,
+	1,
+	4,
+	4,
+	4, 7, 9,
+	4, 7, 9,
+	2,
+	2,
+	5,
+	5
+};
+static const int syncirc_stoich_val[24] = {
+	1,
+	-1,
+	1,
+	-1,
+	-1, -1, 1,
+	1, 1, -1,
+	1,
+	-1,
+	1,
+	-1,
+	-1, -1, 1,
+	1, 1, -1,
+	1,
+	-1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of Syncirc in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t syncirc_react_ptr[17] = {
+	0, 0, 1, 2, 3, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, 16, 17
+};
+static const size_t syncirc_react_idx[17] = {
+	0,
+	0,
+	3,
+	3, 6,
+	8,
+	6,
+	1,
+	1,
+	4,
+	4, 7,
+	9,
+	7,
+	2,
+	2,
+	5
+};
+static const int syncirc_react_val[17] = {
+	1,
+	1,
+	1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for Syncirc.
  */
 void syncirc_mod_setup (stochmod * model)
 {
 	model->propensity = &syncirc_propensity_eval;
+	model->propensity_update = &syncirc_propensity_update;
+	model->jacobian = &syncirc_propensity_jacobian;
+	model->hessian = &syncirc_propensity_hessian;
+	model->rate_raw = &syncirc_propensity_raw;
+	model->rate_jacobian = &syncirc_propensity_jacobian;
 	model->update = &syncirc_state_update;
+	model->propensity_raw = &syncirc_propensity_raw;
+	model->propensity_update_raw = &syncirc_propensity_update_raw;
+	model->update_raw = &syncirc_state_update_raw;
+	model->propensity_lanes = &syncirc_propensity_lanes;
+	model->propensity_int = &syncirc_propensity_int;
+	model->propensity_update_int = &syncirc_propensity_update_int;
+	model->update_int = &syncirc_state_update_int;
+	model->initial_int = NULL;
+	model->output = NULL;
+	model->output_int = NULL;
 	model->initial = NULL;
 	model->nspecies = 10;
 	model->nrxns = 16;
@@ -273,5 +1396,12 @@ void syncirc_mod_setup (stochmod * model)
 	model->nin = 0;
 	model->nout = 3;
 	model->name = "Three-gene synthetic repression cascade (SYNCIRC)";
+	model->stoich_ptr = syncirc_stoich_ptr;
+	model->stoich_idx = syncirc_stoich_idx;
+	model->stoich_val = syncirc_stoich_val;
+	model->react_ptr = syncirc_react_ptr;
+	model->react_idx = syncirc_react_idx;
+	model->react_val = syncirc_react_val;
+	model->graph = NULL;
 }
 
@@ -124,6 +124,1047 @@ int synpi1_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl
 }
 
 
+/**
+ Incremental propensity update function for SynPI1.
+ */
+int synpi1_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid)
+{
+	// Check sizes of vectors
+	if ((X->size != N) || (params->size != L+Z) || (prop->size != R))
+	{
+		fprintf (stderr, "error in synpi1_propensity_update: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - propensities: %d\n", (int) X->size, (int) params->size, (int) prop->size);
+		return GSL_EFAILED;
+	}
+
+	// Check that reaction id is correct
+	if (rxnid >= R)
+	{
+		fprintf (stderr, "error in synpi1_propensity_update: reaction id is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 1, (k2)*X2);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		gsl_vector_set (prop, 3, (k4)*X2);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X2 = gsl_vector_get (X, 1);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k2 = gsl_vector_get (params, 1);
+		double k3 = gsl_vector_get (params, 2);
+		double k4 = gsl_vector_get (params, 3);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 1, (k2)*X2);
+		gsl_vector_set (prop, 2, (k3)*X1);
+		gsl_vector_set (prop, 3, (k4)*X2);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+
+	case 2:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double u1 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 4, (k5+k6*u1)*X7);
+		gsl_vector_set (prop, 5, (k7)*X7*(X7-1));
+		break;
+	}
+
+	case 3:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double u1 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 4, (k5+k6*u1)*X7);
+		gsl_vector_set (prop, 5, (k7)*X7*(X7-1));
+		break;
+	}
+
+	case 4:
+	{
+		double X7 = gsl_vector_get (X, 6);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double u1 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 4, (k5+k6*u1)*X7);
+		gsl_vector_set (prop, 5, (k7)*X7*(X7-1));
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X7 = gsl_vector_get (X, 6);
+		double X8 = gsl_vector_get (X, 7);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double u1 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 4, (k5+k6*u1)*X7);
+		gsl_vector_set (prop, 5, (k7)*X7*(X7-1));
+		gsl_vector_set (prop, 6, (k8)*X8);
+		gsl_vector_set (prop, 7, (k9)*X4*X8);
+		gsl_vector_set (prop, 8, (k9)*X5*X8);
+		break;
+	}
+
+	case 6:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X7 = gsl_vector_get (X, 6);
+		double X8 = gsl_vector_get (X, 7);
+		double k5 = gsl_vector_get (params, 4);
+		double k6 = gsl_vector_get (params, 5);
+		double k7 = gsl_vector_get (params, 6);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double u1 = gsl_vector_get (params, 13);
+		gsl_vector_set (prop, 4, (k5+k6*u1)*X7);
+		gsl_vector_set (prop, 5, (k7)*X7*(X7-1));
+		gsl_vector_set (prop, 6, (k8)*X8);
+		gsl_vector_set (prop, 7, (k9)*X4*X8);
+		gsl_vector_set (prop, 8, (k9)*X5*X8);
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X8 = gsl_vector_get (X, 7);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k11 = gsl_vector_get (params, 10);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 6, (k8)*X8);
+		gsl_vector_set (prop, 7, (k9)*X4*X8);
+		gsl_vector_set (prop, 8, (k9)*X5*X8);
+		gsl_vector_set (prop, 10, (k11)*X4);
+		gsl_vector_set (prop, 11, (k12)*X5);
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double X8 = gsl_vector_get (X, 7);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 6, (k8)*X8);
+		gsl_vector_set (prop, 7, (k9)*X4*X8);
+		gsl_vector_set (prop, 8, (k9)*X5*X8);
+		gsl_vector_set (prop, 9, (k10)*X6);
+		gsl_vector_set (prop, 11, (k12)*X5);
+		gsl_vector_set (prop, 12, (k12)*X6);
+		break;
+	}
+
+	case 9:
+	{
+		double X4 = gsl_vector_get (X, 3);
+		double X5 = gsl_vector_get (X, 4);
+		double X6 = gsl_vector_get (X, 5);
+		double X8 = gsl_vector_get (X, 7);
+		double k8 = gsl_vector_get (params, 7);
+		double k9 = gsl_vector_get (params, 8);
+		double k10 = gsl_vector_get (params, 9);
+		double k12 = gsl_vector_get (params, 11);
+		gsl_vector_set (prop, 6, (k8)*X8);
+		gsl_vector_set (prop, 7, (k9)*X4*X8);
+		gsl_vector_set (prop, 8, (k9)*X5*X8);
+		gsl_vector_set (prop, 9, (k10)*X6);
+		gsl_vector_set (prop, 11, (k12)*X5);
+		gsl_vector_set (prop, 12, (k12)*X6);
+		break;
+	}
+
+	case 10:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+
+	case 11:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+
+	case 12:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+
+	case 13:
+	{
+		double X1 = gsl_vector_get (X, 0);
+		double X3 = gsl_vector_get (X, 2);
+		double k1 = gsl_vector_get (params, 0);
+		double k13 = gsl_vector_get (params, 12);
+		gsl_vector_set (prop, 0, (k1)*X1*X3);
+		gsl_vector_set (prop, 13, (k13)*X3);
+		break;
+	}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Jacobian function for SynPI1: J(j,i) is the derivative of the
+ propensity of reaction j with respect to species i.
+ */
+int synpi1_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in synpi1_propensity_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X1 = gsl_vector_get (X, 0);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+	double X7 = gsl_vector_get (X, 6);
+	double X8 = gsl_vector_get (X, 7);
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double u1 = gsl_vector_get (params, 13);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 0, 0, (k1)*X3);
+	gsl_matrix_set (J, 0, 2, (k1)*X1);
+	gsl_matrix_set (J, 1, 1, (k2));
+	gsl_matrix_set (J, 2, 0, (k3));
+	gsl_matrix_set (J, 3, 1, (k4));
+	gsl_matrix_set (J, 4, 6, (k5+k6*u1));
+	gsl_matrix_set (J, 5, 6, (k7)*(X7-1)+(k7)*X7);
+	gsl_matrix_set (J, 6, 7, (k8));
+	gsl_matrix_set (J, 7, 3, (k9)*X8);
+	gsl_matrix_set (J, 7, 7, (k9)*X4);
+	gsl_matrix_set (J, 8, 4, (k9)*X8);
+	gsl_matrix_set (J, 8, 7, (k9)*X5);
+	gsl_matrix_set (J, 9, 5, (k10));
+	gsl_matrix_set (J, 10, 3, (k11));
+	gsl_matrix_set (J, 11, 4, (k12));
+	gsl_matrix_set (J, 12, 5, (k12));
+	gsl_matrix_set (J, 13, 2, (k13));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Propensity Hessian function for SynPI1: H(j,i*N+k) is the second derivative
+ of the propensity of reaction j with respect to species i and k.
+ */
+int synpi1_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (H->size1 != R) || (H->size2 != N*N))
+	{
+		fprintf (stderr, "error in synpi1_propensity_hessian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - hessian: %d x %d\n", (int) X->size, (int) params->size, (int) H->size1, (int) H->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k7 = gsl_vector_get (params, 6);
+	double k9 = gsl_vector_get (params, 8);
+
+	// Reset the Hessian matrix
+	gsl_matrix_set_zero (H);
+
+	// Set the non-zero second derivatives
+	gsl_matrix_set (H, 0, 2, (k1));
+	gsl_matrix_set (H, 0, 16, (k1));
+	gsl_matrix_set (H, 5, 54, 2*(k7));
+	gsl_matrix_set (H, 7, 31, (k9));
+	gsl_matrix_set (H, 7, 59, (k9));
+	gsl_matrix_set (H, 8, 39, (k9));
+	gsl_matrix_set (H, 8, 60, (k9));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Macroscopic rate Jacobian function for SynPI1: J(j,i) is the derivative of the
+ rate of reaction j (see synpi1_rate_raw) with respect to species i.
+ */
+int synpi1_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J)
+{
+	// Check sizes of vectors and matrices
+	if ((X->size != N) || (params->size != L+Z) || (J->size1 != R) || (J->size2 != N))
+	{
+		fprintf (stderr, "error in synpi1_rate_jacobian: vector or matrix sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d - jacobian: %d x %d\n", (int) X->size, (int) params->size, (int) J->size1, (int) J->size2);
+		return GSL_EFAILED;
+	}
+
+	// Get the species
+	double X1 = gsl_vector_get (X, 0);
+	double X3 = gsl_vector_get (X, 2);
+	double X4 = gsl_vector_get (X, 3);
+	double X5 = gsl_vector_get (X, 4);
+	double X7 = gsl_vector_get (X, 6);
+	double X8 = gsl_vector_get (X, 7);
+
+	// Get the parameters
+	double k1 = gsl_vector_get (params, 0);
+	double k2 = gsl_vector_get (params, 1);
+	double k3 = gsl_vector_get (params, 2);
+	double k4 = gsl_vector_get (params, 3);
+	double k5 = gsl_vector_get (params, 4);
+	double k6 = gsl_vector_get (params, 5);
+	double k7 = gsl_vector_get (params, 6);
+	double k8 = gsl_vector_get (params, 7);
+	double k9 = gsl_vector_get (params, 8);
+	double k10 = gsl_vector_get (params, 9);
+	double k11 = gsl_vector_get (params, 10);
+	double k12 = gsl_vector_get (params, 11);
+	double k13 = gsl_vector_get (params, 12);
+	double u1 = gsl_vector_get (params, 13);
+
+	// Reset the Jacobian matrix
+	gsl_matrix_set_zero (J);
+
+	// Set the non-zero derivatives
+	gsl_matrix_set (J, 0, 0, (k1)*X3);
+	gsl_matrix_set (J, 0, 2, (k1)*X1);
+	gsl_matrix_set (J, 1, 1, (k2));
+	gsl_matrix_set (J, 2, 0, (k3));
+	gsl_matrix_set (J, 3, 1, (k4));
+	gsl_matrix_set (J, 4, 6, (k5+k6*u1));
+	gsl_matrix_set (J, 5, 6, 2*(k7)*X7);
+	gsl_matrix_set (J, 6, 7, (k8));
+	gsl_matrix_set (J, 7, 3, (k9)*X8);
+	gsl_matrix_set (J, 7, 7, (k9)*X4);
+	gsl_matrix_set (J, 8, 4, (k9)*X8);
+	gsl_matrix_set (J, 8, 7, (k9)*X5);
+	gsl_matrix_set (J, 9, 5, (k10));
+	gsl_matrix_set (J, 10, 3, (k11));
+	gsl_matrix_set (J, 11, 4, (k12));
+	gsl_matrix_set (J, 12, 5, (k12));
+	gsl_matrix_set (J, 13, 2, (k13));
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Unchecked macroscopic rate function for SynPI1, on contiguous arrays: the
+ propensities, with X*X in place of X*(X-1) in the homodimerizations.
+ */
+void synpi1_rate_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double u1 = params[13];
+
+	// Compute the propensities
+	prop[0] = (k1)*X1*X3;
+	prop[1] = (k2)*X2;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4)*X2;
+	prop[4] = (k5+k6*u1)*X7;
+	prop[5] = (k7)*X7*X7;
+	prop[6] = (k8)*X8;
+	prop[7] = (k9)*X4*X8;
+	prop[8] = (k9)*X5*X8;
+	prop[9] = (k10)*X6;
+	prop[10] = (k11)*X4;
+	prop[11] = (k12)*X5;
+	prop[12] = (k12)*X6;
+	prop[13] = (k13)*X3;
+}
+
+
+/**
+ Unchecked propensity evaluation function for SynPI1, on contiguous arrays.
+ */
+void synpi1_propensity_raw (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double u1 = params[13];
+
+	// Compute the propensities
+	prop[0] = (k1)*X1*X3;
+	prop[1] = (k2)*X2;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4)*X2;
+	prop[4] = (k5+k6*u1)*X7;
+	prop[5] = (k7)*X7*(X7-1);
+	prop[6] = (k8)*X8;
+	prop[7] = (k9)*X4*X8;
+	prop[8] = (k9)*X5*X8;
+	prop[9] = (k10)*X6;
+	prop[10] = (k11)*X4;
+	prop[11] = (k12)*X5;
+	prop[12] = (k12)*X6;
+	prop[13] = (k13)*X3;
+}
+
+
+/**
+ Unchecked incremental propensity update function for SynPI1, on contiguous arrays.
+ */
+void synpi1_propensity_update_raw (const double * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double X2 = X[1];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k4 = params[3];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X1;
+		prop[3] = (k4)*X2;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double X2 = X[1];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k4 = params[3];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X1;
+		prop[3] = (k4)*X2;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 2:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 3:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 4:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X7 = X[6];
+		double X8 = X[7];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		break;
+	}
+
+	case 6:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X7 = X[6];
+		double X8 = X[7];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[10] = (k11)*X4;
+		prop[11] = (k12)*X5;
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[9] = (k10)*X6;
+		prop[11] = (k12)*X5;
+		prop[12] = (k12)*X6;
+		break;
+	}
+
+	case 9:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[9] = (k10)*X6;
+		prop[11] = (k12)*X5;
+		prop[12] = (k12)*X6;
+		break;
+	}
+
+	case 10:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 11:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 12:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 13:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for SynPI1, on SM_LOCK_LANES states
+ stored by species: species i of state l is X[i*SM_LOCK_LANES+l], and the propensity
+ of reaction j is prop[j*SM_LOCK_LANES+l].
+ */
+void synpi1_propensity_lanes (const double * restrict X, const double * restrict params, double * restrict prop)
+{
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double u1 = params[13];
+
+	for (size_t l = 0; l < SM_LOCK_LANES; l++)
+	{
+		double X1 = X[l];
+		double X2 = X[SM_LOCK_LANES+l];
+		double X3 = X[2*SM_LOCK_LANES+l];
+		double X4 = X[3*SM_LOCK_LANES+l];
+		double X5 = X[4*SM_LOCK_LANES+l];
+		double X6 = X[5*SM_LOCK_LANES+l];
+		double X7 = X[6*SM_LOCK_LANES+l];
+		double X8 = X[7*SM_LOCK_LANES+l];
+
+		// Compute the propensities
+		prop[l] = (k1)*X1*X3;
+		prop[SM_LOCK_LANES+l] = (k2)*X2;
+		prop[2*SM_LOCK_LANES+l] = (k3)*X1;
+		prop[3*SM_LOCK_LANES+l] = (k4)*X2;
+		prop[4*SM_LOCK_LANES+l] = (k5+k6*u1)*X7;
+		prop[5*SM_LOCK_LANES+l] = (k7)*X7*(X7-1);
+		prop[6*SM_LOCK_LANES+l] = (k8)*X8;
+		prop[7*SM_LOCK_LANES+l] = (k9)*X4*X8;
+		prop[8*SM_LOCK_LANES+l] = (k9)*X5*X8;
+		prop[9*SM_LOCK_LANES+l] = (k10)*X6;
+		prop[10*SM_LOCK_LANES+l] = (k11)*X4;
+		prop[11*SM_LOCK_LANES+l] = (k12)*X5;
+		prop[12*SM_LOCK_LANES+l] = (k12)*X6;
+		prop[13*SM_LOCK_LANES+l] = (k13)*X3;
+	}
+}
+
+
+/**
+ Unchecked propensity evaluation function for SynPI1, on an integer state array.
+ */
+void synpi1_propensity_int (const int * restrict X, const double * restrict params, double * restrict prop)
+{
+	double X1 = X[0];
+	double X2 = X[1];
+	double X3 = X[2];
+	double X4 = X[3];
+	double X5 = X[4];
+	double X6 = X[5];
+	double X7 = X[6];
+	double X8 = X[7];
+	double k1 = params[0];
+	double k2 = params[1];
+	double k3 = params[2];
+	double k4 = params[3];
+	double k5 = params[4];
+	double k6 = params[5];
+	double k7 = params[6];
+	double k8 = params[7];
+	double k9 = params[8];
+	double k10 = params[9];
+	double k11 = params[10];
+	double k12 = params[11];
+	double k13 = params[12];
+	double u1 = params[13];
+
+	// Compute the propensities
+	prop[0] = (k1)*X1*X3;
+	prop[1] = (k2)*X2;
+	prop[2] = (k3)*X1;
+	prop[3] = (k4)*X2;
+	prop[4] = (k5+k6*u1)*X7;
+	prop[5] = (k7)*X7*(X7-1);
+	prop[6] = (k8)*X8;
+	prop[7] = (k9)*X4*X8;
+	prop[8] = (k9)*X5*X8;
+	prop[9] = (k10)*X6;
+	prop[10] = (k11)*X4;
+	prop[11] = (k12)*X5;
+	prop[12] = (k12)*X6;
+	prop[13] = (k13)*X3;
+}
+
+
+/**
+ Unchecked incremental propensity update function for SynPI1, on an integer state array.
+ */
+void synpi1_propensity_update_int (const int * restrict X, const double * restrict params, double * restrict prop, size_t rxnid)
+{
+	// Recompute the propensities that depend on the species changed by the reaction
+	switch (rxnid)
+	{
+	case 0:
+	{
+		double X1 = X[0];
+		double X2 = X[1];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k4 = params[3];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X1;
+		prop[3] = (k4)*X2;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 1:
+	{
+		double X1 = X[0];
+		double X2 = X[1];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k2 = params[1];
+		double k3 = params[2];
+		double k4 = params[3];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[1] = (k2)*X2;
+		prop[2] = (k3)*X1;
+		prop[3] = (k4)*X2;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 2:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 3:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 4:
+	{
+		double X7 = X[6];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		break;
+	}
+
+	case 5:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X7 = X[6];
+		double X8 = X[7];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		break;
+	}
+
+	case 6:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X7 = X[6];
+		double X8 = X[7];
+		double k5 = params[4];
+		double k6 = params[5];
+		double k7 = params[6];
+		double k8 = params[7];
+		double k9 = params[8];
+		double u1 = params[13];
+		prop[4] = (k5+k6*u1)*X7;
+		prop[5] = (k7)*X7*(X7-1);
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		break;
+	}
+
+	case 7:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k11 = params[10];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[10] = (k11)*X4;
+		prop[11] = (k12)*X5;
+		break;
+	}
+
+	case 8:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[9] = (k10)*X6;
+		prop[11] = (k12)*X5;
+		prop[12] = (k12)*X6;
+		break;
+	}
+
+	case 9:
+	{
+		double X4 = X[3];
+		double X5 = X[4];
+		double X6 = X[5];
+		double X8 = X[7];
+		double k8 = params[7];
+		double k9 = params[8];
+		double k10 = params[9];
+		double k12 = params[11];
+		prop[6] = (k8)*X8;
+		prop[7] = (k9)*X4*X8;
+		prop[8] = (k9)*X5*X8;
+		prop[9] = (k10)*X6;
+		prop[11] = (k12)*X5;
+		prop[12] = (k12)*X6;
+		break;
+	}
+
+	case 10:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 11:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 12:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+
+	case 13:
+	{
+		double X1 = X[0];
+		double X3 = X[2];
+		double k1 = params[0];
+		double k13 = params[12];
+		prop[0] = (k1)*X1*X3;
+		prop[13] = (k13)*X3;
+		break;
+	}
+	}
+}
+
+
 /**
  State update function for SynPI1.
  */
@@ -220,6 +1261,164 @@ int synpi1_state_update (gsl_vector * X, size_t rxnid)
 }
 
 
+/**
+ Unchecked state update function for SynPI1, on a contiguous array.
+ */
+void synpi1_state_update_raw (double * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] -= 1;
+		X[1] += 1;
+		X[2] -= 1;
+		break;
+
+	case 1:
+		X[0] += 1;
+		X[1] -= 1;
+		X[2] += 1;
+		break;
+
+	case 2:
+		X[6] += 1;
+		break;
+
+	case 3:
+		X[6] += 1;
+		break;
+
+	case 4:
+		X[6] -= 1;
+		break;
+
+	case 5:
+		X[6] -= 2;
+		X[7] += 1;
+		break;
+
+	case 6:
+		X[6] += 2;
+		X[7] -= 1;
+		break;
+
+	case 7:
+		X[3] -= 1;
+		X[4] += 1;
+		X[7] -= 1;
+		break;
+
+	case 8:
+		X[4] -= 1;
+		X[5] += 1;
+		X[7] -= 1;
+		break;
+
+	case 9:
+		X[4] += 1;
+		X[5] -= 1;
+		X[7] += 1;
+		break;
+
+	case 10:
+		X[2] += 1;
+		break;
+
+	case 11:
+		X[2] += 1;
+		break;
+
+	case 12:
+		X[2] += 1;
+		break;
+
+	case 13:
+		X[2] -= 1;
+		break;
+	}
+}
+
+
+/**
+ Unchecked state update function for SynPI1, on an integer state array.
+ */
+void synpi1_state_update_int (int * X, size_t rxnid)
+{
+	// Update the state vector according to which reaction fired
+	switch (rxnid)
+	{
+	case 0:
+		X[0] -= 1;
+		X[1] += 1;
+		X[2] -= 1;
+		break;
+
+	case 1:
+		X[0] += 1;
+		X[1] -= 1;
+		X[2] += 1;
+		break;
+
+	case 2:
+		X[6] += 1;
+		break;
+
+	case 3:
+		X[6] += 1;
+		break;
+
+	case 4:
+		X[6] -= 1;
+		break;
+
+	case 5:
+		X[6] -= 2;
+		X[7] += 1;
+		break;
+
+	case 6:
+		X[6] += 2;
+		X[7] -= 1;
+		break;
+
+	case 7:
+		X[3] -= 1;
+		X[4] += 1;
+		X[7] -= 1;
+		break;
+
+	case 8:
+		X[4] -= 1;
+		X[5] += 1;
+		X[7] -= 1;
+		break;
+
+	case 9:
+		X[4] += 1;
+		X[5] -= 1;
+		X[7] += 1;
+		break;
+
+	case 10:
+		X[2] += 1;
+		break;
+
+	case 11:
+		X[2] += 1;
+		break;
+
+	case 12:
+		X[2] += 1;
+		break;
+
+	case 13:
+		X[2] -= 1;
+		break;
+	}
+}
+
+
 /**
  Sample a new random initial state for SynPI1.
  */
@@ -247,6 +1446,33 @@ int synpi1_initial_conditions (gsl_vector * X0, const gsl_rng * r)
 }
 
 
+/**
+ Sample a new random initial state for SynPI1, as an integer vector.
+ */
+int synpi1_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r)
+{
+	// Check sizes of state vector
+	if (X0->size != N)
+	{
+		fprintf (stderr, "error in synpi1_initial_conditions_int: state vector size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Sample a new initial state
+	gsl_vector_int_set (X0, 0, 20 + gsl_rng_uniform_int (r, 6) + gsl_rng_uniform_int (r, 6));
+	gsl_vector_int_set (X0, 1, 0);
+	gsl_vector_int_set (X0, 2, 0);
+	gsl_vector_int_set (X0, 3, 20 + gsl_rng_uniform_int (r, 6) + gsl_rng_uniform_int (r, 6));
+	gsl_vector_int_set (X0, 4, 0);
+	gsl_vector_int_set (X0, 5, 0);
+	gsl_vector_int_set (X0, 6, 0);
+	gsl_vector_int_set (X0, 7, 0);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
 /**
  Output function for SynPI1.
  */
@@ -272,13 +1498,135 @@ int synpi1_output (gsl_matrix * out)
 }
 
 
+/**
+ Integer output function for SynPI1.
+ */
+int synpi1_output_int (gsl_matrix_int * out)
+{
+	if ((out->size1 != P) || (out->size2 != N))
+	{
+		fprintf (stderr, "error in synpi1_output_int: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+
+	// Reset the output matrix
+	gsl_matrix_int_set_zero (out);
+
+	// Set the non-zero terms
+	//gsl_matrix_int_set (out, 0, 4, 2);
+	//gsl_matrix_int_set (out, 0, 5, 4);
+	gsl_matrix_int_set (out, 0, 6, 1);
+	gsl_matrix_int_set (out, 0, 7, 2);
+
+	// Signal that computation was completed correctly
+	return GSL_SUCCESS;
+}
+
+
+/**
+ Stoichiometry of SynPI1 in compressed row storage: reaction j changes species
+ stoich_idx(k) by stoich_val(k), for k = stoich_ptr(j) ... stoich_ptr(j+1)-1.
+ */
+static const size_t synpi1_stoich_ptr[R+1] = {
+	0, 3, 6, 7, 8, 9, 11, 13, 16, 19, 22, 23, 24, 25, 26
+};
+static const size_t synpi1_stoich_idx[26] = {
+	0, 1, 2,
+	0, 1, 2,
+	6,
+	6,
+	6,
+	6, 7,
+	6, 7,
+	3, 4, 7,
+	4, 5, 7,
+	4, 5, 7,
+	2,
+	2,
+	2,
+	2
+};
+static const int synpi1_stoich_val[26] = {
+	-1, 1, -1,
+	1, -1, 1,
+	1,
+	1,
+	-1,
+	-2, 1,
+	2, -1,
+	-1, 1, -1,
+	-1, 1, -1,
+	1, -1, 1,
+	1,
+	1,
+	1,
+	-1
+};
+
+
+/**
+ Reactants of SynPI1 in compressed row storage: the propensity of reaction j
+ depends on species react_idx(k), which enters the reaction with molecularity
+ react_val(k), for k = react_ptr(j) ... react_ptr(j+1)-1.
+ */
+static const size_t synpi1_react_ptr[R+1] = {
+	0, 2, 3, 4, 5, 6, 7, 8, 10, 12, 13, 14, 15, 16, 17
+};
+static const size_t synpi1_react_idx[17] = {
+	0, 2,
+	1,
+	0,
+	1,
+	6,
+	6,
+	7,
+	3, 7,
+	4, 7,
+	5,
+	3,
+	4,
+	5,
+	2
+};
+static const int synpi1_react_val[17] = {
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	2,
+	1,
+	1, 1,
+	1, 1,
+	1,
+	1,
+	1,
+	1,
+	1
+};
+
+
 /**
  Model information function for SynPI1.
  */
 void synpi1_mod_setup (stochmod * model)
 {
 	model->propensity = &synpi1_propensity_eval;
+	model->propensity_update = &synpi1_propensity_update;
+	model->jacobian = &synpi1_propensity_jacobian;
+	model->hessian = &synpi1_propensity_hessian;
+	model->rate_raw = &synpi1_rate_raw;
+	model->rate_jacobian = &synpi1_rate_jacobian;
 	model->update = &synpi1_state_update;
+	model->propensity_raw = &synpi1_propensity_raw;
+	model->propensity_update_raw = &synpi1_propensity_update_raw;
+	model->update_raw = &synpi1_state_update_raw;
+	model->propensity_lanes = &synpi1_propensity_lanes;
+	model->propensity_int = &synpi1_propensity_int;
+	model->propensity_update_int = &synpi1_propensity_update_int;
+	model->update_int = &synpi1_state_update_int;
+	model->initial_int = &synpi1_initial_conditions_int;
+	model->output_int = &synpi1_output_int;
 	model->initial = &synpi1_initial_conditions;
 	model->output = &synpi1_output;
 	model->nspecies = N;
@@ -287,5 +1635,12 @@ void synpi1_mod_setup (stochmod * model)
 	model->nin = Z;
 	model->nout = P;
 	model->name = "Synthetic PI version 1 (SYNPI1)";
+	model->stoich_ptr = synpi1_stoich_ptr;
+	model->stoich_idx = synpi1_stoich_idx;
+	model->stoich_val = synpi1_stoich_val;
+	model->react_ptr = synpi1_react_ptr;
+	model->react_idx = synpi1_react_idx;
+	model->react_val = synpi1_react_val;
+	model->graph = NULL;
 }
 
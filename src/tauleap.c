@@ -0,0 +1,397 @@
+/*
+ *  tauleap.c
+ *  StochMod
+ *
+ *	Explicit tau-leaping simulation engine
+ *
+ *  This file is part of libStochMod.
+ *  Copyright 2011-2017 Gabriele Lillacci.
+ *
+ *  libStochMod is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libStochMod is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libStochMod.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../stochmod.h"
+#include <gsl/gsl_math.h>
+
+
+/**
+ Evaluate all the propensities in the current state of the workspace.
+ */
+static int tau_propensity (const stochmod * model, const gsl_vector * params, sm_tau_workspace * w)
+{
+	if (w->fast)
+	{
+		model->propensity_raw (w->X->data, w->par, w->prop->data);
+		return GSL_SUCCESS;
+	}
+	return model->propensity (w->X, params, w->prop);
+}
+
+
+/**
+ Fire a single reaction and refresh the propensities that depend on it.
+ */
+static int tau_fire (const stochmod * model, const gsl_vector * params, sm_tau_workspace * w, size_t rxnid)
+{
+	if (w->fast)
+	{
+		model->update_raw (w->X->data, rxnid);
+		model->propensity_update_raw (w->X->data, w->par, w->prop->data, rxnid);
+		return GSL_SUCCESS;
+	}
+	if (sm_stoich_update (model, w->X, rxnid) != GSL_SUCCESS)
+		return GSL_EFAILED;
+	if (model->propensity_update != NULL)
+		return model->propensity_update (w->X, params, w->prop, rxnid);
+	return model->propensity (w->X, params, w->prop);
+}
+
+
+/**
+ Factor g(i) of Cao, Gillespie and Petzold: bounds the relative change of the
+ propensities caused by a relative change of species i.
+ */
+static double tau_g (const sm_tau_workspace * w, size_t i, double x)
+{
+	int hor = w->hor[i];
+	int mol = w->mol[i];
+
+	if ((mol < 2) || (x < mol))
+		return (double) hor;
+	if (hor == 2)
+		return 2.0 + 1.0/(x - 1.0);
+	if (mol == 2)
+		return 1.5 * (2.0 + 1.0/(x - 1.0));
+	return 3.0 + 1.0/(x - 1.0) + 2.0/(x - 2.0);
+}
+
+
+/**
+ Allocate a workspace for the explicit tau-leaping engine that fits the given
+ model. The model must export its stoichiometry and reactant tables, which
+ are used here to find the highest order reaction of each species.
+ */
+sm_tau_workspace * sm_tau_workspace_alloc (const stochmod * model)
+{
+	if ((model->stoich_ptr == NULL) || (model->react_ptr == NULL))
+	{
+		fprintf (stderr, "error in sm_tau_workspace_alloc: model does not export its stoichiometry\n");
+		return NULL;
+	}
+
+	sm_tau_workspace * w = malloc (sizeof (sm_tau_workspace));
+	if (w == NULL)
+	{
+		fprintf (stderr, "error in sm_tau_workspace_alloc: failed to allocate workspace\n");
+		return NULL;
+	}
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	w->nspecies = N;
+	w->nrxns = R;
+	w->npar = model->nparams + model->nin;
+	w->X = gsl_vector_alloc (N);
+	w->prop = gsl_vector_alloc (R);
+	w->par = malloc ((w->npar + 1) * sizeof (double));
+	w->Xnew = malloc ((N + 1) * sizeof (double));
+	w->mu = malloc ((N + 1) * sizeof (double));
+	w->sigma2 = malloc ((N + 1) * sizeof (double));
+	w->hor = calloc (N + 1, sizeof (int));
+	w->mol = calloc (N + 1, sizeof (int));
+	w->reactant = malloc (N + 1);
+	w->critical = malloc (R + 1);
+
+	if ((w->X == NULL) || (w->prop == NULL) || (w->par == NULL) || (w->Xnew == NULL) || (w->mu == NULL)
+			|| (w->sigma2 == NULL) || (w->hor == NULL) || (w->mol == NULL) || (w->reactant == NULL)
+			|| (w->critical == NULL))
+	{
+		fprintf (stderr, "error in sm_tau_workspace_alloc: failed to allocate workspace members\n");
+		sm_tau_workspace_free (w);
+		return NULL;
+	}
+
+	// Highest order reaction of each species, and molecularity of the species in it
+	for (size_t j = 0; j < R; j++)
+	{
+		int order = 0;
+		for (size_t q = model->react_ptr[j]; q < model->react_ptr[j+1]; q++)
+			order += model->react_val[q];
+		for (size_t q = model->react_ptr[j]; q < model->react_ptr[j+1]; q++)
+		{
+			size_t i = model->react_idx[q];
+			if (order > w->hor[i])
+			{
+				w->hor[i] = order;
+				w->mol[i] = 0;
+			}
+			if ((order == w->hor[i]) && (model->react_val[q] > w->mol[i]))
+				w->mol[i] = model->react_val[q];
+		}
+	}
+
+	// Default tuning from Cao, Gillespie and Petzold (2006)
+	w->epsilon = 0.03;
+	w->ncritical = 10;
+	w->ssa_factor = 10.0;
+	w->nssa = 100;
+	w->fast = 0;
+
+	return w;
+}
+
+
+/**
+ Free a workspace allocated with sm_tau_workspace_alloc.
+ */
+void sm_tau_workspace_free (sm_tau_workspace * w)
+{
+	if (w == NULL)
+		return;
+
+	if (w->X != NULL)
+		gsl_vector_free (w->X);
+	if (w->prop != NULL)
+		gsl_vector_free (w->prop);
+	free (w->par);
+	free (w->Xnew);
+	free (w->mu);
+	free (w->sigma2);
+	free (w->hor);
+	free (w->mol);
+	free (w->reactant);
+	free (w->critical);
+	free (w);
+}
+
+
+/**
+ Simulate one trajectory of the model with explicit tau-leaping, using the
+ step size selection of Cao, Gillespie and Petzold (J. Chem. Phys. 124, 2006).
+
+ Arguments and output are the same as in sm_ssa_direct_run. A reaction is
+ critical when it can fire fewer than w->ncritical more times before one of
+ its reactants runs out. Non-critical reactions are leaped with Poisson
+ numbers of firings over a step that keeps the relative change of every
+ propensity below w->epsilon, while at most one critical reaction fires per
+ step, as in the exact SSA. When the leap would be shorter than
+ w->ssa_factor / a0, w->nssa exact SSA steps are taken instead. Leaps that
+ would make a population negative are retried with half the step.
+ */
+int sm_tau_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_tau_workspace * w, const gsl_rng * r)
+{
+	// Check sizes of vectors and matrices
+	if ((w->nspecies != model->nspecies) || (w->nrxns != model->nrxns) || (w->npar != params->size))
+	{
+		fprintf (stderr, "error in sm_tau_run: workspace does not fit the model\n");
+		return GSL_EFAILED;
+	}
+	if ((X0->size != model->nspecies) || (params->size != model->nparams + model->nin))
+	{
+		fprintf (stderr, "error in sm_tau_run: vector sizes are not correct\n");
+		fprintf (stderr, "\tstate: %d - params: %d\n", (int) X0->size, (int) params->size);
+		return GSL_EFAILED;
+	}
+	if ((states->size1 != tgrid->size) || (states->size2 != model->nspecies))
+	{
+		fprintf (stderr, "error in sm_tau_run: output matrix size is not correct\n");
+		return GSL_EFAILED;
+	}
+	if (tgrid->size == 0)
+		return GSL_SUCCESS;
+	sm_rngbuf_set (&w->rb, r);
+
+	size_t N = model->nspecies;
+	size_t R = model->nrxns;
+	double * x = w->X->data;
+	double * a = w->prop->data;
+	double * xnew = w->Xnew;
+	size_t ntimes = tgrid->size;
+	size_t k = 0;
+	double t = gsl_vector_get (tgrid, 0);
+
+	w->fast = (model->propensity_raw != NULL) && (model->propensity_update_raw != NULL)
+			&& (model->update_raw != NULL);
+	gsl_vector_memcpy (w->X, X0);
+	for (size_t i = 0; i < w->npar; i++)
+		w->par[i] = gsl_vector_get (params, i);
+
+	while (k < ntimes)
+	{
+		// Record the time points that have been reached
+		while ((k < ntimes) && (gsl_vector_get (tgrid, k) <= t))
+		{
+			gsl_matrix_set_row (states, k, w->X);
+			k++;
+		}
+		if (k == ntimes)
+			break;
+
+		if (tau_propensity (model, params, w) != GSL_SUCCESS)
+			return GSL_EFAILED;
+		double a0 = 0.0;
+		for (size_t j = 0; j < R; j++)
+			a0 += a[j];
+		if (a0 <= 0.0)
+		{
+			t = INFINITY;
+			continue;
+		}
+
+		// Critical reactions are those that are close to exhausting a reactant
+		double a0c = 0.0;
+		for (size_t j = 0; j < R; j++)
+		{
+			w->critical[j] = 0;
+			if (a[j] <= 0.0)
+				continue;
+			for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			{
+				int v = model->stoich_val[q];
+				if ((v < 0) && (floor (x[model->stoich_idx[q]] / -v) < w->ncritical))
+					w->critical[j] = 1;
+			}
+			if (w->critical[j])
+				a0c += a[j];
+		}
+
+		// Mean and variance of the change of each species due to non-critical reactions
+		for (size_t i = 0; i < N; i++)
+		{
+			w->mu[i] = 0.0;
+			w->sigma2[i] = 0.0;
+			w->reactant[i] = 0;
+		}
+		for (size_t j = 0; j < R; j++)
+		{
+			if (w->critical[j])
+				continue;
+			for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+			{
+				double v = model->stoich_val[q];
+				w->mu[model->stoich_idx[q]] += v * a[j];
+				w->sigma2[model->stoich_idx[q]] += v * v * a[j];
+			}
+			for (size_t q = model->react_ptr[j]; q < model->react_ptr[j+1]; q++)
+				w->reactant[model->react_idx[q]] = 1;
+		}
+
+		// Largest step that keeps the relative change of every propensity below epsilon
+		double tau1 = INFINITY;
+		for (size_t i = 0; i < N; i++)
+		{
+			if (!w->reactant[i])
+				continue;
+			double bound = w->epsilon * x[i] / tau_g (w, i, x[i]);
+			if (bound < 1.0)
+				bound = 1.0;
+			if (w->mu[i] != 0.0)
+				tau1 = GSL_MIN (tau1, bound / fabs (w->mu[i]));
+			if (w->sigma2[i] > 0.0)
+				tau1 = GSL_MIN (tau1, bound * bound / w->sigma2[i]);
+		}
+
+		// Leaping would not pay off: take a batch of exact SSA steps
+		if (tau1 < w->ssa_factor / a0)
+		{
+			for (unsigned long n = 0; n < w->nssa; n++)
+			{
+				a0 = 0.0;
+				for (size_t j = 0; j < R; j++)
+					a0 += a[j];
+				double tnext = (a0 > 0.0) ? t + sm_rngbuf_exponential (&w->rb) / a0 : INFINITY;
+				while ((k < ntimes) && (gsl_vector_get (tgrid, k) < tnext))
+				{
+					gsl_matrix_set_row (states, k, w->X);
+					k++;
+				}
+				if (k == ntimes)
+					break;
+
+				double target = a0 * sm_rngbuf_uniform (&w->rb);
+				double cumsum = 0.0;
+				size_t rxnid = R;
+				for (size_t j = 0; j < R; j++)
+				{
+					if (a[j] <= 0.0)
+						continue;
+					rxnid = j;
+					cumsum += a[j];
+					if (target < cumsum)
+						break;
+				}
+				t = tnext;
+				if (tau_fire (model, params, w, rxnid) != GSL_SUCCESS)
+					return GSL_EFAILED;
+			}
+			continue;
+		}
+
+		// Leap, halving the step until no population becomes negative
+		double horizon = gsl_vector_get (tgrid, k) - t;
+		for (;;)
+		{
+			double tau2 = (a0c > 0.0) ? sm_rngbuf_exponential (&w->rb) / a0c : INFINITY;
+			double tau = GSL_MIN (GSL_MIN (tau1, tau2), horizon);
+
+			for (size_t i = 0; i < N; i++)
+				xnew[i] = x[i];
+			for (size_t j = 0; j < R; j++)
+			{
+				if (w->critical[j] || (a[j] <= 0.0))
+					continue;
+				unsigned int nfire = sm_rngbuf_poisson (&w->rb, a[j] * tau);
+				for (size_t q = model->stoich_ptr[j]; q < model->stoich_ptr[j+1]; q++)
+					xnew[model->stoich_idx[q]] += (double) nfire * model->stoich_val[q];
+			}
+
+			// One critical reaction fires if its time comes first
+			if ((tau2 <= tau1) && (tau2 <= horizon))
+			{
+				double target = a0c * sm_rngbuf_uniform (&w->rb);
+				double cumsum = 0.0;
+				size_t rxnid = R;
+				for (size_t j = 0; j < R; j++)
+				{
+					if (!w->critical[j])
+						continue;
+					rxnid = j;
+					cumsum += a[j];
+					if (target < cumsum)
+						break;
+				}
+				for (size_t q = model->stoich_ptr[rxnid]; q < model->stoich_ptr[rxnid+1]; q++)
+					xnew[model->stoich_idx[q]] += model->stoich_val[q];
+			}
+
+			int negative = 0;
+			for (size_t i = 0; i < N; i++)
+				negative |= (xnew[i] < 0.0);
+			if (negative)
+			{
+				tau1 /= 2.0;
+				continue;
+			}
+
+			for (size_t i = 0; i < N; i++)
+				x[i] = xnew[i];
+			t = (tau == horizon) ? gsl_vector_get (tgrid, k) : t + tau;
+			break;
+		}
+	}
+
+	// Signal that computation was completed successfully
+	return GSL_SUCCESS;
+}
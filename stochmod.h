@@ -30,7 +30,9 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
+#include <stdint.h>
 
 
 /*
@@ -39,6 +41,8 @@
 
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_rng.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_odeiv2.h>
 
 
 
@@ -46,7 +50,32 @@
  New data types
  */
 
-// Model struct
+// Reaction dependency graph: after reaction j fires, the propensities of
+// reactions idx[ptr[j]] ... idx[ptr[j+1]-1] must be recomputed
+typedef struct {
+	size_t nrxns;
+	size_t * ptr;
+	size_t * idx;
+} sm_depgraph;
+
+// Model struct. The members up to name are those of the original model struct, in
+// their original order; all the others were added later and are optional, so code
+// that fills a model by hand must clear it with stochmod_init first: the engines
+// fall back to the checked callbacks when the faster ones are NULL, and refuse the
+// model when a callback they need is NULL. Every *_mod_setup assigns all the
+// members: output is NULL for the models that have no output matrix, and the
+// engines only call it when it is not.
+// The stoichiometry is stored in compressed row storage: reaction j changes species
+// stoich_idx[k] by stoich_val[k], for stoich_ptr[j] <= k < stoich_ptr[j+1].
+// The reactants are stored in the same way, with their molecularity in react_val.
+// The _raw callbacks work on contiguous arrays and do no checks: the engines validate
+// the sizes once, before entering the simulation loop. The _int callbacks do the same
+// on integer populations, and the integer initial states and outputs use gsl_*_int.
+// propensity_lanes evaluates the propensities of SM_LOCK_LANES states at once, stored
+// by species, for the lockstep engine (see lockstep.c).
+// rate_raw and rate_jacobian are the macroscopic (mass action) reaction rates and
+// their Jacobian, for the deterministic engines: they differ from the propensities
+// in the homodimerizations, whose propensity k*X*(X-1) has rate k*X^2.
 typedef struct {
 	int (* propensity) (const gsl_vector *, const gsl_vector *, gsl_vector *);
 	int (* update) (gsl_vector *, size_t);
@@ -58,8 +87,458 @@ typedef struct {
 	size_t nin;
 	size_t nout;
 	char * name;
+	int (* propensity_update) (const gsl_vector *, const gsl_vector *, gsl_vector *, size_t);
+	int (* jacobian) (const gsl_vector *, const gsl_vector *, gsl_matrix *);
+	int (* hessian) (const gsl_vector *, const gsl_vector *, gsl_matrix *);
+	void (* propensity_raw) (const double *, const double *, double *);
+	void (* propensity_update_raw) (const double *, const double *, double *, size_t);
+	void (* update_raw) (double *, size_t);
+	void (* propensity_lanes) (const double *, const double *, double *);
+	void (* propensity_int) (const int *, const double *, double *);
+	void (* propensity_update_int) (const int *, const double *, double *, size_t);
+	void (* update_int) (int *, size_t);
+	int (* initial_int) (gsl_vector_int *, const gsl_rng *);
+	int (* output_int) (gsl_matrix_int *);
+	const size_t * stoich_ptr;
+	const size_t * stoich_idx;
+	const int * stoich_val;
+	const size_t * react_ptr;
+	const size_t * react_idx;
+	const int * react_val;
+	sm_depgraph * graph;
+	void (* rate_raw) (const double *, const double *, double *);
+	int (* rate_jacobian) (const gsl_vector *, const gsl_vector *, gsl_matrix *);
 } stochmod;
 
+// Buffers of random variates, refilled in blocks of SM_RNGBUF_SIZE from the
+// generator r; nu, ne and ng are the variates left in each buffer, see rngbuf.c.
+#define SM_RNGBUF_SIZE 256
+typedef struct {
+	const gsl_rng * r;
+	double u[SM_RNGBUF_SIZE];
+	double e[SM_RNGBUF_SIZE];
+	double g[SM_RNGBUF_SIZE];
+	size_t nu;
+	size_t ne;
+	size_t ng;
+} sm_rngbuf;
+
+// Workspace for the SSA engines
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	gsl_vector_int * Xint;
+	double * par;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_ssa_workspace;
+
+// Workspace for the Next Reaction Method engine
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	gsl_vector * oldprop;
+	double * par;
+	double * tau;
+	size_t * heap;
+	size_t * pos;
+	const sm_depgraph * graph;
+	sm_depgraph * owngraph;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_nrm_workspace;
+
+// Workspace for the sorting direct method engine. order holds the reactions in
+// the order they are searched, nfired counts how many times each one fired.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	double * par;
+	size_t * order;
+	unsigned long * nfired;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_sdm_workspace;
+
+// Workspace for the composition-rejection engine. The propensities are split in
+// SM_CR_NGROUPS power-of-two groups, see crssa.c for the layout.
+#define SM_CR_NGROUPS 32
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	gsl_vector * oldprop;
+	double * par;
+	double gsum[SM_CR_NGROUPS];
+	double gmax[SM_CR_NGROUPS];
+	size_t gsize[SM_CR_NGROUPS];
+	size_t * members;
+	size_t * group;
+	size_t * slot;
+	int emin;
+	unsigned long nsteps;
+	const sm_depgraph * graph;
+	sm_depgraph * owngraph;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_cr_workspace;
+
+// Workspace for the explicit tau-leaping engine. epsilon, ncritical, ssa_factor
+// and nssa are the tuning parameters of the step selection, see tauleap.c.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	double * par;
+	double * Xnew;
+	double * mu;
+	double * sigma2;
+	int * hor;
+	int * mol;
+	char * reactant;
+	char * critical;
+	double epsilon;
+	unsigned long ncritical;
+	double ssa_factor;
+	unsigned long nssa;
+	int fast;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_tau_workspace;
+
+// Workspace for the implicit tau-leaping engine. tau is the step size, tol and
+// maxiter control the Newton iterations, see imptau.c.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * Y;
+	gsl_vector * c;
+	gsl_vector * F;
+	gsl_vector * dY;
+	gsl_vector * prop;
+	gsl_vector * propY;
+	gsl_vector * P;
+	gsl_matrix * S;
+	gsl_matrix * Ja;
+	gsl_matrix * Jf;
+	gsl_permutation * perm;
+	double tau;
+	double tol;
+	unsigned int maxiter;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_imptau_workspace;
+
+// Integration schemes for the chemical Langevin equation
+typedef enum {
+	SM_CLE_EULER = 0,
+	SM_CLE_HEUN = 1
+} sm_cle_method;
+
+// Workspace for the CLE integrators. dt is the step size and method the scheme,
+// see cle.c.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * Xpred;
+	gsl_vector * prop;
+	gsl_vector * proppred;
+	double * par;
+	double * dW;
+	double * v;
+	double dt;
+	sm_cle_method method;
+	int fast;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_cle_workspace;
+
+// Workspace for the slow-scale SSA. The reversible pairs of the model are
+// pair_fwd(p), pair_rev(p); ratio is the separation of time scales above which a
+// pair is treated as fast. maxrange is the size of the window on which the
+// stationary distribution of a fast pair is computed, fixed at allocation.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * prop;
+	double * par;
+	double * Xt;
+	double * at;
+	double * ahat;
+	double * weight;
+	size_t * pair_fwd;
+	size_t * pair_rev;
+	char * pair_reads;
+	char * isfast;
+	char * touched;
+	size_t npairs;
+	size_t maxrange;
+	double ratio;
+	int fast;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_ss_workspace;
+
+// Workspace for the hybrid SSA/ODE engine. dt is the step of the ODE integrator,
+// threshold the population above which a species is continuous and nfire the
+// number of firings per step above which a reaction is continuous, see hybrid.c.
+typedef struct {
+	gsl_vector * X;
+	gsl_vector * Xt;
+	gsl_vector * prop;
+	double * par;
+	double * Xs;
+	double * k;
+	char * contsp;
+	char * cont;
+	double dt;
+	double threshold;
+	double nfire;
+	int fast;
+	sm_rngbuf rb;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_hyb_workspace;
+
+// Workspace for the reaction rate equations. type, epsabs and epsrel are the
+// stepper and tolerances of the gsl_odeiv2 driver, see sm_ode_workspace_set.
+typedef struct {
+	gsl_odeiv2_system sys;
+	gsl_odeiv2_driver * driver;
+	const gsl_odeiv2_step_type * type;
+	gsl_vector * prop;
+	gsl_matrix * Ja;
+	double * y;
+	double * dy;
+	double * par;
+	const stochmod * model;
+	const gsl_vector * params;
+	double hstart;
+	double epsabs;
+	double epsrel;
+	int fast;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_ode_workspace;
+
+// Workspace for the linear noise approximation. H is the output matrix of the
+// model (NULL if it has none); the driver settings are as in sm_ode_workspace.
+typedef struct {
+	gsl_odeiv2_system sys;
+	gsl_odeiv2_driver * driver;
+	const gsl_odeiv2_step_type * type;
+	gsl_vector * prop;
+	gsl_matrix * Ja;
+	gsl_matrix * H;
+	gsl_matrix * HC;
+	double * A;
+	double * AC;
+	double * y;
+	double * dy;
+	double * par;
+	const stochmod * model;
+	const gsl_vector * params;
+	double hstart;
+	double epsabs;
+	double epsrel;
+	int fast;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+	size_t nout;
+} sm_lna_workspace;
+
+// Closures of the highest central moments for the moment equations
+typedef enum {
+	SM_MC_NORMAL = 0,
+	SM_MC_LOGNORMAL = 1
+} sm_mc_closure;
+
+// Workspace for the moment closure approximation. order (2 or 3) is the highest
+// order of the central moments integrated, closure selects how the moments of the
+// next order are closed; the driver settings are as in sm_ode_workspace.
+typedef struct {
+	gsl_odeiv2_system sys;
+	gsl_odeiv2_driver * driver;
+	const gsl_odeiv2_step_type * type;
+	gsl_vector * prop;
+	gsl_matrix * Ja;
+	gsl_matrix * Hs;
+	gsl_matrix * H;
+	gsl_matrix * HC;
+	double * Ea;
+	double * Ca;
+	double * SC;
+	double * K;
+	double * Da;
+	double * y;
+	double * yt;
+	double * f0;
+	double * f1;
+	double * par;
+	const stochmod * model;
+	const gsl_vector * params;
+	double hstart;
+	double epsabs;
+	double epsrel;
+	sm_mc_closure closure;
+	int order;
+	int fast;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+	size_t nout;
+} sm_mc_workspace;
+
+// Workspace for the finite state projection solver of the CME. pool holds the threads
+// that apply the generator in the box layout while sm_fsp_run runs, see fsp.c.
+typedef struct
+{
+	int * states;
+	size_t * hash;
+	size_t hashsize;
+	size_t nstates;
+	size_t capacity;
+	size_t maxstates;
+	size_t nthreads;
+	size_t * gptr;
+	size_t * gidx;
+	double * gval;
+	size_t * grxn;
+	double * diag;
+	double * obase;
+	size_t nnzcap;
+	double anorm;
+	double * p;
+	double * P;
+	double * error;
+	size_t ntimes;
+	double * V;
+	double * av;
+	size_t vcap;
+	double * H;
+	double * Hs;
+	double * F;
+	double * eX;
+	double * eT;
+	double * eD;
+	gsl_permutation * eperm;
+	int * bound;
+	int * xt;
+	double * leak;
+	double * par;
+	double * ref;
+	double * probe;
+	double * apar;
+	double * coef;
+	int * rxpar;
+	int * xcls;
+	int * x0;
+	const stochmod * model;
+	int affine;
+	double * aT;
+	long * boff;
+	size_t * bstride;
+	int * bcoord;
+	int * bold;
+	struct sm_fsp_pool * pool;
+	int box;
+	int boxed;
+	gsl_vector * prop;
+	gsl_vector * Xd;
+	double tol;
+	double ktol;
+	double expand;
+	int nbound;
+	size_t m;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_fsp_workspace;
+
+// Workspace for the lockstep SSA, which advances SM_LOCK_LANES trajectories at
+// once. The states and propensities of the lanes are stored by species and by
+// reaction (x[i*SM_LOCK_LANES+l]), and each lane has its own generator and
+// buffers, see lockstep.c.
+#define SM_LOCK_LANES 16
+typedef struct {
+	double * x;
+	double * a;
+	double * xl;
+	double * al;
+	double * par;
+	double a0[SM_LOCK_LANES];
+	double t[SM_LOCK_LANES];
+	double tnext[SM_LOCK_LANES];
+	double tk[SM_LOCK_LANES];
+	double target[SM_LOCK_LANES];
+	double cum[SM_LOCK_LANES];
+	size_t sel[SM_LOCK_LANES];
+	size_t k[SM_LOCK_LANES];
+	size_t id[SM_LOCK_LANES];
+	char busy[SM_LOCK_LANES];
+	char fire[SM_LOCK_LANES];
+	gsl_rng * rngs[SM_LOCK_LANES];
+	sm_rngbuf rb[SM_LOCK_LANES];
+	gsl_matrix * states[SM_LOCK_LANES];
+	gsl_vector * x0;
+	void (* done) (size_t, const gsl_matrix *, void *);
+	void * data;
+	size_t ntimes;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_lock_workspace;
+
+// Simulation methods of the ensemble runner
+typedef enum {
+	SM_ENS_SSA = 0,
+	SM_ENS_NRM = 1,
+	SM_ENS_SDM = 2,
+	SM_ENS_CR = 3,
+	SM_ENS_TAU = 4,
+	SM_ENS_IMPTAU = 5,
+	SM_ENS_CLE = 6,
+	SM_ENS_SS = 7,
+	SM_ENS_HYB = 8,
+	SM_ENS_LOCK = 9,
+} sm_ens_method;
+
+// Workspace for the multithreaded ensemble runner
+typedef struct
+{
+	sm_ens_method method;
+	size_t nthreads;
+	void ** ws;
+	gsl_rng ** rngs;
+	gsl_matrix ** states;
+	gsl_vector ** x0s;
+	double * mean;
+	double * m2;
+	size_t nmom;
+	size_t ntimes;
+	size_t batch;
+	size_t steals;
+	void (* observer) (size_t, size_t, const gsl_matrix *, void *);
+	void * data;
+	size_t nspecies;
+	size_t nrxns;
+	size_t npar;
+} sm_ens_workspace;
+
 // Enumeration for the models contained in the library
 typedef enum {
 	MODEL_SYNCIRC = 0,
@@ -86,7 +565,17 @@ typedef enum {
  Exported functions prototype declarations == SYNCIRC.C
  */
 int syncirc_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int syncirc_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int syncirc_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int syncirc_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void syncirc_propensity_raw (const double * X, const double * params, double * prop);
+void syncirc_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void syncirc_propensity_lanes (const double * X, const double * params, double * prop);
+void syncirc_propensity_int (const int * X, const double * params, double * prop);
+void syncirc_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int syncirc_state_update (gsl_vector * X, size_t rxnid);
+void syncirc_state_update_raw (double * X, size_t rxnid);
+void syncirc_state_update_int (int * X, size_t rxnid);
 void syncirc_mod_setup (stochmod * model);
 
 
@@ -94,7 +583,17 @@ void syncirc_mod_setup (stochmod * model);
  Exported functions prototype declarations == STOCHREP.C
  */
 int stochrep_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int stochrep_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int stochrep_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int stochrep_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void stochrep_propensity_raw (const double * X, const double * params, double * prop);
+void stochrep_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void stochrep_propensity_lanes (const double * X, const double * params, double * prop);
+void stochrep_propensity_int (const int * X, const double * params, double * prop);
+void stochrep_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int stochrep_state_update (gsl_vector * X, size_t rxnid);
+void stochrep_state_update_raw (double * X, size_t rxnid);
+void stochrep_state_update_int (int * X, size_t rxnid);
 void stochrep_mod_setup (stochmod * model);
 
 
@@ -102,8 +601,19 @@ void stochrep_mod_setup (stochmod * model);
  Exported functions prototype declarations == AUTOREG.C
  */
 int autoreg_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int autoreg_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int autoreg_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int autoreg_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void autoreg_propensity_raw (const double * X, const double * params, double * prop);
+void autoreg_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void autoreg_propensity_lanes (const double * X, const double * params, double * prop);
+void autoreg_propensity_int (const int * X, const double * params, double * prop);
+void autoreg_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int autoreg_state_update (gsl_vector * X, size_t rxnid);
+void autoreg_state_update_raw (double * X, size_t rxnid);
+void autoreg_state_update_int (int * X, size_t rxnid);
 int autoreg_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int autoreg_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 void autoreg_mod_setup (stochmod * model);
 
 
@@ -111,9 +621,21 @@ void autoreg_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP.C
  */
 int lacgfp_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void lacgfp_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp_state_update_raw (double * X, size_t rxnid);
+void lacgfp_state_update_int (int * X, size_t rxnid);
 int lacgfp_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp_output (gsl_matrix * out);
+int lacgfp_output_int (gsl_matrix_int * out);
 void lacgfp_mod_setup (stochmod * model);
 
 
@@ -121,9 +643,21 @@ void lacgfp_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP2.C
  */
 int lacgfp2_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp2_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp2_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp2_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void lacgfp2_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp2_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp2_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp2_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp2_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp2_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp2_state_update_raw (double * X, size_t rxnid);
+void lacgfp2_state_update_int (int * X, size_t rxnid);
 int lacgfp2_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp2_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp2_output (gsl_matrix * out);
+int lacgfp2_output_int (gsl_matrix_int * out);
 void lacgfp2_mod_setup (stochmod * model);
 
 
@@ -131,9 +665,21 @@ void lacgfp2_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP3.C
  */
 int lacgfp3_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp3_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp3_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp3_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void lacgfp3_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp3_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp3_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp3_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp3_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp3_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp3_state_update_raw (double * X, size_t rxnid);
+void lacgfp3_state_update_int (int * X, size_t rxnid);
 int lacgfp3_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp3_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp3_output (gsl_matrix * out);
+int lacgfp3_output_int (gsl_matrix_int * out);
 void lacgfp3_mod_setup (stochmod * model);
 
 
@@ -141,9 +687,21 @@ void lacgfp3_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP4.C
  */
 int lacgfp4_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp4_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp4_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp4_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void lacgfp4_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp4_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp4_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp4_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp4_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp4_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp4_state_update_raw (double * X, size_t rxnid);
+void lacgfp4_state_update_int (int * X, size_t rxnid);
 int lacgfp4_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp4_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp4_output (gsl_matrix * out);
+int lacgfp4_output_int (gsl_matrix_int * out);
 void lacgfp4_mod_setup (stochmod * model);
 
 
@@ -151,9 +709,23 @@ void lacgfp4_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP5.C
  */
 int lacgfp5_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp5_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp5_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp5_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int lacgfp5_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void lacgfp5_rate_raw (const double * X, const double * params, double * prop);
+void lacgfp5_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp5_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp5_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp5_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp5_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp5_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp5_state_update_raw (double * X, size_t rxnid);
+void lacgfp5_state_update_int (int * X, size_t rxnid);
 int lacgfp5_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp5_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp5_output (gsl_matrix * out);
+int lacgfp5_output_int (gsl_matrix_int * out);
 void lacgfp5_mod_setup (stochmod * model);
 
 
@@ -161,9 +733,21 @@ void lacgfp5_mod_setup (stochmod * model);
  Exported functions prototype declarations == BIRTHDEATH.C
  */
 int birthdeath_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int birthdeath_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int birthdeath_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int birthdeath_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void birthdeath_propensity_raw (const double * X, const double * params, double * prop);
+void birthdeath_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void birthdeath_propensity_lanes (const double * X, const double * params, double * prop);
+void birthdeath_propensity_int (const int * X, const double * params, double * prop);
+void birthdeath_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int birthdeath_state_update (gsl_vector * X, size_t rxnid);
+void birthdeath_state_update_raw (double * X, size_t rxnid);
+void birthdeath_state_update_int (int * X, size_t rxnid);
 int birthdeath_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int birthdeath_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int birthdeath_output (gsl_matrix * out);
+int birthdeath_output_int (gsl_matrix_int * out);
 void birthdeath_mod_setup (stochmod * model);
 
 \
@@ -171,9 +755,23 @@ void birthdeath_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP6.C
  */
 int lacgfp6_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp6_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp6_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp6_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int lacgfp6_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void lacgfp6_rate_raw (const double * X, const double * params, double * prop);
+void lacgfp6_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp6_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp6_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp6_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp6_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp6_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp6_state_update_raw (double * X, size_t rxnid);
+void lacgfp6_state_update_int (int * X, size_t rxnid);
 int lacgfp6_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp6_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp6_output (gsl_matrix * out);
+int lacgfp6_output_int (gsl_matrix_int * out);
 void lacgfp6_mod_setup (stochmod * model);
 
 
@@ -181,9 +779,23 @@ void lacgfp6_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP7.C
  */
 int lacgfp7_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp7_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp7_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp7_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int lacgfp7_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void lacgfp7_rate_raw (const double * X, const double * params, double * prop);
+void lacgfp7_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp7_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp7_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp7_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp7_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp7_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp7_state_update_raw (double * X, size_t rxnid);
+void lacgfp7_state_update_int (int * X, size_t rxnid);
 int lacgfp7_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp7_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp7_output (gsl_matrix * out);
+int lacgfp7_output_int (gsl_matrix_int * out);
 void lacgfp7_mod_setup (stochmod * model);
 
 
@@ -191,9 +803,23 @@ void lacgfp7_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP8.C
  */
 int lacgfp8_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp8_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp8_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp8_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int lacgfp8_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void lacgfp8_rate_raw (const double * X, const double * params, double * prop);
+void lacgfp8_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp8_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp8_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp8_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp8_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp8_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp8_state_update_raw (double * X, size_t rxnid);
+void lacgfp8_state_update_int (int * X, size_t rxnid);
 int lacgfp8_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp8_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp8_output (gsl_matrix * out);
+int lacgfp8_output_int (gsl_matrix_int * out);
 void lacgfp8_mod_setup (stochmod * model);
 
 
@@ -201,9 +827,21 @@ void lacgfp8_mod_setup (stochmod * model);
  Exported functions prototype declarations == IFF.C
  */
 int iff_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int iff_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int iff_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int iff_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void iff_propensity_raw (const double * X, const double * params, double * prop);
+void iff_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void iff_propensity_lanes (const double * X, const double * params, double * prop);
+void iff_propensity_int (const int * X, const double * params, double * prop);
+void iff_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int iff_state_update (gsl_vector * X, size_t rxnid);
+void iff_state_update_raw (double * X, size_t rxnid);
+void iff_state_update_int (int * X, size_t rxnid);
 int iff_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int iff_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int iff_output (gsl_matrix * out);
+int iff_output_int (gsl_matrix_int * out);
 void iff_mod_setup (stochmod * model);
 
 
@@ -211,9 +849,21 @@ void iff_mod_setup (stochmod * model);
  Exported functions prototype declarations == FBK.C
  */
 int fbk_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int fbk_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int fbk_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int fbk_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void fbk_propensity_raw (const double * X, const double * params, double * prop);
+void fbk_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void fbk_propensity_lanes (const double * X, const double * params, double * prop);
+void fbk_propensity_int (const int * X, const double * params, double * prop);
+void fbk_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int fbk_state_update (gsl_vector * X, size_t rxnid);
+void fbk_state_update_raw (double * X, size_t rxnid);
+void fbk_state_update_int (int * X, size_t rxnid);
 int fbk_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int fbk_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int fbk_output (gsl_matrix * out);
+int fbk_output_int (gsl_matrix_int * out);
 void fbk_mod_setup (stochmod * model);
 
 
@@ -221,9 +871,23 @@ void fbk_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP9.C
  */
 int lacgfp9_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp9_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp9_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp9_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int lacgfp9_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void lacgfp9_rate_raw (const double * X, const double * params, double * prop);
+void lacgfp9_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp9_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp9_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp9_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp9_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp9_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp9_state_update_raw (double * X, size_t rxnid);
+void lacgfp9_state_update_int (int * X, size_t rxnid);
 int lacgfp9_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp9_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp9_output (gsl_matrix * out);
+int lacgfp9_output_int (gsl_matrix_int * out);
 void lacgfp9_mod_setup (stochmod * model);
 
 
@@ -231,19 +895,265 @@ void lacgfp9_mod_setup (stochmod * model);
  Exported functions prototype declarations == LACGFP10.C
  */
 int lacgfp10_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int lacgfp10_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int lacgfp10_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int lacgfp10_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+void lacgfp10_propensity_raw (const double * X, const double * params, double * prop);
+void lacgfp10_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void lacgfp10_propensity_lanes (const double * X, const double * params, double * prop);
+void lacgfp10_propensity_int (const int * X, const double * params, double * prop);
+void lacgfp10_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int lacgfp10_state_update (gsl_vector * X, size_t rxnid);
+void lacgfp10_state_update_raw (double * X, size_t rxnid);
+void lacgfp10_state_update_int (int * X, size_t rxnid);
 int lacgfp10_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int lacgfp10_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int lacgfp10_output (gsl_matrix * out);
+int lacgfp10_output_int (gsl_matrix_int * out);
 void lacgfp10_mod_setup (stochmod * model);
 
 /*
  Exported functions prototype declarations == SYNPI1.C
  */
 int synpi1_propensity_eval (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop);
+int synpi1_propensity_update (const gsl_vector * X, const gsl_vector * params, gsl_vector * prop, size_t rxnid);
+int synpi1_propensity_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+int synpi1_propensity_hessian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * H);
+int synpi1_rate_jacobian (const gsl_vector * X, const gsl_vector * params, gsl_matrix * J);
+void synpi1_rate_raw (const double * X, const double * params, double * prop);
+void synpi1_propensity_raw (const double * X, const double * params, double * prop);
+void synpi1_propensity_update_raw (const double * X, const double * params, double * prop, size_t rxnid);
+void synpi1_propensity_lanes (const double * X, const double * params, double * prop);
+void synpi1_propensity_int (const int * X, const double * params, double * prop);
+void synpi1_propensity_update_int (const int * X, const double * params, double * prop, size_t rxnid);
 int synpi1_state_update (gsl_vector * X, size_t rxnid);
+void synpi1_state_update_raw (double * X, size_t rxnid);
+void synpi1_state_update_int (int * X, size_t rxnid);
 int synpi1_initial_conditions (gsl_vector * X0, const gsl_rng * r);
+int synpi1_initial_conditions_int (gsl_vector_int * X0, const gsl_rng * r);
 int synpi1_output (gsl_matrix * out);
+int synpi1_output_int (gsl_matrix_int * out);
 void synpi1_mod_setup (stochmod * model);
 
 
+/*
+ Exported functions prototype declarations == REGISTRY.C
+ */
+void stochmod_init (stochmod * model);
+int stochmod_setup (stochmod * model, STOCHASTIC_MODEL id);
+void stochmod_free (stochmod * model);
+
+
+/*
+ Exported functions prototype declarations == SSA.C
+ */
+sm_ssa_workspace * sm_ssa_workspace_alloc (const stochmod * model);
+void sm_ssa_workspace_free (sm_ssa_workspace * w);
+int sm_ssa_direct_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ssa_workspace * w, const gsl_rng * r);
+int sm_ssa_direct_run_int (const stochmod * model, const gsl_vector * params, const gsl_vector_int * X0,
+		const gsl_vector * tgrid, gsl_matrix_int * states, sm_ssa_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == STOICH.C
+ */
+int sm_stoich_update (const stochmod * model, gsl_vector * X, size_t rxnid);
+int sm_stoich_update_int (const stochmod * model, gsl_vector_int * X, size_t rxnid);
+int sm_stoich_matrix (const stochmod * model, gsl_matrix * S);
+
+
+/*
+ Exported functions prototype declarations == DEPGRAPH.C
+ */
+sm_depgraph * sm_depgraph_alloc (const stochmod * model);
+void sm_depgraph_free (sm_depgraph * g);
+int sm_depgraph_attach (stochmod * model);
+
+
+/*
+ Exported functions prototype declarations == NRM.C
+ */
+sm_nrm_workspace * sm_nrm_workspace_alloc (const stochmod * model);
+void sm_nrm_workspace_free (sm_nrm_workspace * w);
+int sm_nrm_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_nrm_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == SDM.C
+ */
+sm_sdm_workspace * sm_sdm_workspace_alloc (const stochmod * model);
+void sm_sdm_workspace_free (sm_sdm_workspace * w);
+int sm_sdm_get_order (const sm_sdm_workspace * w, gsl_permutation * p);
+int sm_sdm_set_order (sm_sdm_workspace * w, const gsl_permutation * p);
+int sm_sdm_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_sdm_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == CRSSA.C
+ */
+sm_cr_workspace * sm_cr_workspace_alloc (const stochmod * model);
+void sm_cr_workspace_free (sm_cr_workspace * w);
+int sm_cr_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_cr_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == TAULEAP.C
+ */
+sm_tau_workspace * sm_tau_workspace_alloc (const stochmod * model);
+void sm_tau_workspace_free (sm_tau_workspace * w);
+int sm_tau_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_tau_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == IMPTAU.C
+ */
+sm_imptau_workspace * sm_imptau_workspace_alloc (const stochmod * model);
+void sm_imptau_workspace_free (sm_imptau_workspace * w);
+int sm_imptau_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_imptau_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == CLE.C
+ */
+sm_cle_workspace * sm_cle_workspace_alloc (const stochmod * model);
+void sm_cle_workspace_free (sm_cle_workspace * w);
+int sm_cle_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_cle_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == SSSSA.C
+ */
+sm_ss_workspace * sm_ss_workspace_alloc (const stochmod * model);
+void sm_ss_workspace_free (sm_ss_workspace * w);
+int sm_ss_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ss_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == HYBRID.C
+ */
+sm_hyb_workspace * sm_hyb_workspace_alloc (const stochmod * model);
+void sm_hyb_workspace_free (sm_hyb_workspace * w);
+int sm_hyb_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_hyb_workspace * w, const gsl_rng * r);
+
+
+/*
+ Exported functions prototype declarations == ODE.C
+ */
+sm_ode_workspace * sm_ode_workspace_alloc (const stochmod * model);
+void sm_ode_workspace_free (sm_ode_workspace * w);
+int sm_ode_workspace_set (sm_ode_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel);
+int sm_ode_eval (const stochmod * model, const gsl_vector * params, const gsl_vector * X, gsl_vector * f,
+		gsl_matrix * J, sm_ode_workspace * w);
+int sm_ode_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, gsl_matrix * states, sm_ode_workspace * w);
+
+
+/*
+ Exported functions prototype declarations == LNA.C
+ */
+sm_lna_workspace * sm_lna_workspace_alloc (const stochmod * model);
+void sm_lna_workspace_free (sm_lna_workspace * w);
+int sm_lna_workspace_set (sm_lna_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel);
+int sm_lna_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0, const gsl_matrix * C0,
+		const gsl_vector * tgrid, gsl_matrix * means, gsl_matrix * covs, sm_lna_workspace * w);
+int sm_lna_output (const gsl_matrix * means, const gsl_matrix * covs, gsl_matrix * ymeans, gsl_matrix * ycovs,
+		sm_lna_workspace * w);
+
+
+/*
+ Exported functions prototype declarations == MOMENTS.C
+ */
+sm_mc_workspace * sm_mc_workspace_alloc (const stochmod * model);
+void sm_mc_workspace_free (sm_mc_workspace * w);
+int sm_mc_workspace_set (sm_mc_workspace * w, const gsl_odeiv2_step_type * T, double epsabs, double epsrel);
+int sm_mc_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0, const gsl_matrix * C0,
+		const gsl_vector * tgrid, gsl_matrix * means, gsl_matrix * covs, sm_mc_workspace * w);
+int sm_mc_output (const gsl_matrix * means, const gsl_matrix * covs, gsl_matrix * ymeans, gsl_matrix * ycovs,
+		sm_mc_workspace * w);
+
+
+/*
+ Exported functions prototype declarations == FSP.C
+ */
+sm_fsp_workspace * sm_fsp_workspace_alloc (const stochmod * model);
+void sm_fsp_workspace_free (sm_fsp_workspace * w);
+int sm_fsp_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, sm_fsp_workspace * w);
+double sm_fsp_prob (sm_fsp_workspace * w, size_t k, const gsl_vector_int * x);
+int sm_fsp_marginal (const sm_fsp_workspace * w, size_t k, size_t species, gsl_vector * m);
+
+
+/*
+ Exported functions prototype declarations == ENSEMBLE.C
+ */
+sm_ens_workspace * sm_ens_workspace_alloc (const stochmod * model, sm_ens_method method, size_t nthreads);
+void sm_ens_workspace_free (sm_ens_workspace * w);
+int sm_ens_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, size_t ntraj, unsigned long seed, gsl_matrix * means, gsl_matrix * vars,
+		sm_ens_workspace * w);
+
+
+/*
+ Exported functions prototype declarations == PHILOX.C
+ */
+extern const gsl_rng_type * sm_rng_philox;
+int sm_rng_key (const gsl_rng * r, unsigned long seed, unsigned long long id);
+int sm_rng_seek (const gsl_rng * r, unsigned long long step);
+unsigned long long sm_rng_step (const gsl_rng * r);
+void sm_rng_fill (const gsl_rng * r, uint32_t * words, size_t n);
+
+
+/*
+ Exported functions prototype declarations == RNGBUF.C
+ */
+void sm_rngbuf_set (sm_rngbuf * b, const gsl_rng * r);
+void sm_rngbuf_refill_uniform (sm_rngbuf * b);
+void sm_rngbuf_refill_exponential (sm_rngbuf * b);
+void sm_rngbuf_refill_gaussian (sm_rngbuf * b);
+void sm_rngbuf_gaussians (sm_rngbuf * b, double * x, size_t n);
+unsigned int sm_rngbuf_poisson (sm_rngbuf * b, double mu);
+unsigned int sm_rngbuf_binomial (sm_rngbuf * b, double p, unsigned int n);
+
+// The engines take one variate at a time, inline so that a draw costs a load
+// and a decrement: uniform in (0,1), exponential of unit mean, standard gaussian
+static inline double sm_rngbuf_uniform (sm_rngbuf * b)
+{
+	if (b->nu == 0)
+		sm_rngbuf_refill_uniform (b);
+	return b->u[--b->nu];
+}
+
+static inline double sm_rngbuf_exponential (sm_rngbuf * b)
+{
+	if (b->ne == 0)
+		sm_rngbuf_refill_exponential (b);
+	return b->e[--b->ne];
+}
+
+static inline double sm_rngbuf_gaussian (sm_rngbuf * b)
+{
+	if (b->ng == 0)
+		sm_rngbuf_refill_gaussian (b);
+	return b->g[--b->ng];
+}
+
+
+/*
+ Exported functions prototype declarations == LOCKSTEP.C
+ */
+sm_lock_workspace * sm_lock_workspace_alloc (const stochmod * model);
+void sm_lock_workspace_free (sm_lock_workspace * w);
+int sm_lock_run (const stochmod * model, const gsl_vector * params, const gsl_vector * X0,
+		const gsl_vector * tgrid, unsigned long seed, size_t first, size_t ntraj, sm_lock_workspace * w);
+
+
 #endif